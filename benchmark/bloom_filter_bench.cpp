@@ -0,0 +1,90 @@
+// 分块Bloom过滤器挡在MyUnorderedMap<int, int>前面的基准（以不命中为主的查找）
+// 1. 经BloomFront逐个插入n个键：容器rehash时过滤器随之重建，统计重建次数与总耗时
+// 2. 实测假阳性率：用n个一定不存在的键查询过滤器
+// 3. 查找：不命中比例99% / 90% / 50%，直接map.find vs front.find（目标假阳性率1%与0.1%）
+// 编译运行：g++ -O2 -std=c++17 benchmark/bloom_filter_bench.cpp -o bloom_filter_bench && ./bloom_filter_bench [键个数]
+// （加-mavx2可让过滤器的8路掩码判断向量化）
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+#include "../container/std_unordered_map_withoutstl.cpp"
+#include "../container/blocked_bloom_filter.h"
+
+double elapsed_ms(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+uint64_t xorshift(uint64_t& state) {
+    state ^= state << 13;
+    state ^= state >> 7;
+    state ^= state << 17;
+    return state;
+}
+
+using Map = MyUnorderedMap<int, int>;
+using Front = BloomFront<Map, int, MyHash<int>>;
+
+const double kMissRatios[] = {0.99, 0.9, 0.5};
+const double kTargetRates[] = {0.01, 0.001};
+
+int main(int argc, char** argv) {
+    int n = argc > 1 ? std::atoi(argv[1]) : 1000000;
+    uint64_t rng = 88172645463325252ULL;
+    std::vector<int> keys(n), misses(n);
+    for (int i = 0; i < n; ++i) {
+        keys[i] = static_cast<int>(xorshift(rng) >> 34) * 2; // 偶数键
+        misses[i] = static_cast<int>(xorshift(rng) >> 34) * 2 + 1; // 奇数一定不存在
+    }
+    long long checksum = 0;
+    std::printf("%d random int keys\n", n);
+
+    for (double rate : kTargetRates) {
+        Map map;
+        Front front(map, rate, 0.75f); // MyUnorderedMap默认最大负载因子0.75
+        auto start = std::chrono::steady_clock::now();
+        for (int i = 0; i < n; ++i) {
+            front.insert(keys[i], i);
+        }
+        front.find(keys[0]); // 让最后一次rehash后的重建发生在计时内
+        double build_ms = elapsed_ms(start);
+
+        size_t false_positives = 0;
+        MyHash<int> hasher;
+        for (int q : misses) {
+            false_positives += front.filter().may_contain(hasher(q));
+        }
+        std::printf("\n[target fpr %.3f%%] build through front %.1f ms (%zu rebuilds), k = %zu, filter %.2f MB "
+                    "(%.1f bits/key), measured fpr %.3f%%\n",
+                    rate * 100, build_ms, front.rebuild_count(), front.filter().k(),
+                    front.filter().memory_bytes() / 1048576.0, front.filter().memory_bytes() * 8.0 / map.size(),
+                    100.0 * false_positives / n);
+        std::printf("  %-10s %14s %14s %8s\n", "miss ratio", "map.find ns", "front.find ns", "speedup");
+
+        for (double ratio : kMissRatios) {
+            std::vector<int> queries(n);
+            for (int i = 0; i < n; ++i) {
+                bool miss = static_cast<double>(xorshift(rng) % 10000) < ratio * 10000;
+                queries[i] = miss ? misses[xorshift(rng) % n] : keys[xorshift(rng) % n];
+            }
+            start = std::chrono::steady_clock::now();
+            for (int q : queries) {
+                if (int* v = map.find(q)) {
+                    checksum += *v;
+                }
+            }
+            double plain_ns = elapsed_ms(start) * 1e6 / n;
+            start = std::chrono::steady_clock::now();
+            for (int q : queries) {
+                if (int* v = front.find(q)) {
+                    checksum += *v;
+                }
+            }
+            double front_ns = elapsed_ms(start) * 1e6 / n;
+            std::printf("  %9.0f%% %14.1f %14.1f %7.2fx\n", ratio * 100, plain_ns, front_ns, plain_ns / front_ns);
+        }
+    }
+
+    std::printf("\n(checksum %lld)\n", checksum);
+    return 0;
+}
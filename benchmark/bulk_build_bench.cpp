@@ -0,0 +1,84 @@
+// MyUnorderedMap<int, int>批量建表基准
+// 1. 逐个insert（不预留）：统计rehash次数与总耗时
+// 2. reserve(n)后逐个insert
+// 3. bulk_build(first, last, threads)：threads = 1, 2, 4, ... 直到最大线程数
+// 输入是随机键（约1%重复），每种方式建完后抽查结果与逐个insert一致
+// 编译运行：g++ -O2 -std=c++17 -pthread benchmark/bulk_build_bench.cpp -o bulk_build_bench && ./bulk_build_bench [键值对个数] [最大线程数]
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <thread>
+#include <utility>
+#include <vector>
+#include "../container/std_unordered_map_withoutstl.cpp"
+
+double elapsed_ms(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+uint64_t xorshift(uint64_t& state) {
+    state ^= state << 13;
+    state ^= state >> 7;
+    state ^= state << 17;
+    return state;
+}
+
+// 抽查：每隔stride个输入比较一次值（重复键以靠后的为准，这里比较与参照表相同即可）
+long long sample_checksum(MyUnorderedMap<int, int>& map, const std::vector<std::pair<int, int>>& input) {
+    long long sum = 0;
+    for (size_t i = 0; i < input.size(); i += 97) {
+        if (int* v = map.find(input[i].first)) {
+            sum += *v;
+        }
+    }
+    return sum + static_cast<long long>(map.size());
+}
+
+int main(int argc, char** argv) {
+    int n = argc > 1 ? std::atoi(argv[1]) : 10000000;
+    unsigned hw = std::thread::hardware_concurrency();
+    unsigned max_threads = argc > 2 ? static_cast<unsigned>(std::atoi(argv[2])) : (hw > 1 ? hw : 8);
+    uint64_t rng = 88172645463325252ULL;
+    std::vector<std::pair<int, int>> input(n);
+    for (int i = 0; i < n; ++i) {
+        input[i] = {static_cast<int>(xorshift(rng) % (static_cast<uint64_t>(n) * 50)), i};
+    }
+    std::printf("%d pairs, hardware threads %u\n", n, hw);
+    std::printf("  %-24s %10s %10s %10s\n", "", "build ms", "rehashes", "check");
+
+    long long expected;
+    {
+        MyUnorderedMap<int, int> map;
+        auto start = std::chrono::steady_clock::now();
+        for (const auto& kv : input) {
+            map.insert(kv.first, kv.second);
+        }
+        double ms = elapsed_ms(start);
+        expected = sample_checksum(map, input);
+        std::printf("  %-24s %10.1f %10llu %10s\n", "insert one by one", ms,
+                    static_cast<unsigned long long>(map.stats().rehash_count), "ref");
+    }
+    {
+        MyUnorderedMap<int, int> map;
+        auto start = std::chrono::steady_clock::now();
+        map.reserve(input.size());
+        for (const auto& kv : input) {
+            map.insert(kv.first, kv.second);
+        }
+        double ms = elapsed_ms(start);
+        std::printf("  %-24s %10.1f %10llu %10s\n", "reserve + insert", ms,
+                    static_cast<unsigned long long>(map.stats().rehash_count),
+                    sample_checksum(map, input) == expected ? "ok" : "MISMATCH");
+    }
+    for (unsigned threads = 1; threads <= max_threads; threads *= 2) {
+        MyUnorderedMap<int, int> map;
+        auto start = std::chrono::steady_clock::now();
+        map.bulk_build(input.begin(), input.end(), threads);
+        double ms = elapsed_ms(start);
+        char name[32];
+        std::snprintf(name, sizeof(name), "bulk_build %u thread%s", threads, threads > 1 ? "s" : "");
+        std::printf("  %-24s %10.1f %10llu %10s\n", name, ms, static_cast<unsigned long long>(map.stats().rehash_count),
+                    sample_checksum(map, input) == expected ? "ok" : "MISMATCH");
+    }
+    return 0;
+}
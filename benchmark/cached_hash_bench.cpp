@@ -0,0 +1,93 @@
+// 节点缓存完整哈希值（CacheHash）基准：长字符串键（64字节、共享56字节前缀）
+// 1. 建表耗时：从默认桶数开始插入，期间的每次rehash都要为全部已有节点重新求哈希
+// 2. 未命中查找：查询的键都不存在，链上每个节点都要做一次键比较（或只比哈希值）
+// 分别测MyUnorderedMap<std::string>、MyUnorderedMap<char*>（键在StringArena中）和MyUnorderedMultimap<std::string>
+// 编译运行：g++ -O2 -std=c++17 benchmark/cached_hash_bench.cpp -o cached_hash_bench && ./cached_hash_bench [键个数]
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <vector>
+#include "../container/std_unordered_map_withoutstl.cpp"
+#include "../container/std_unordered_multimap_withoutstl.cpp"
+
+template <>
+struct MyHash<std::string> {
+    size_t operator()(const std::string& key) const {
+        return hash_bytes(key.data(), key.size());
+    }
+};
+
+template <>
+struct KeyEqual<std::string> {
+    bool operator()(const std::string& a, const std::string& b) const {
+        return a == b;
+    }
+};
+
+const int kKeyLen = 64;
+
+double elapsed_ms(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+// 56字节公共前缀 + 8位编号，长度相同，键比较要比到最后几个字节才能分出不同
+std::string make_key(int i, char tag) {
+    char tail[16];
+    std::snprintf(tail, sizeof(tail), "%c%07d", tag, i);
+    return std::string(kKeyLen - 8, 'p') + tail;
+}
+
+template <typename Map, typename Insert, typename Find>
+void run(const char* name, const std::vector<std::string>& keys, const std::vector<std::string>& misses,
+         Insert insert, Find find) {
+    Map map;
+    auto start = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < keys.size(); ++i) {
+        insert(map, keys[i], static_cast<int>(i));
+    }
+    double build_ms = elapsed_ms(start);
+
+    size_t found = 0;
+    start = std::chrono::steady_clock::now();
+    for (int round = 0; round < 3; ++round) {
+        for (const std::string& key : misses) {
+            found += find(map, key);
+        }
+    }
+    double miss_ns = elapsed_ms(start) * 1e6 / (3.0 * misses.size());
+    std::printf("  %-34s build %8.1f ms   miss lookup %6.1f ns   (found %zu)\n", name, build_ms, miss_ns, found);
+}
+
+int main(int argc, char** argv) {
+    int n = argc > 1 ? std::atoi(argv[1]) : 500000;
+    std::vector<std::string> keys, misses;
+    for (int i = 0; i < n; ++i) {
+        keys.push_back(make_key(i, 'k'));
+        misses.push_back(make_key(i, 'm'));
+    }
+    std::printf("n = %d, key length = %d\n", n, kKeyLen);
+
+    auto map_insert = [](auto& map, const std::string& key, int v) { map.insert(key, v); };
+    auto map_find = [](auto& map, const std::string& key) { return map.find(key) != nullptr; };
+    run<MyUnorderedMap<std::string, int>>("map<string>", keys, misses, map_insert, map_find);
+    run<MyUnorderedMap<std::string, int, MyHash<std::string>, KeyEqual<std::string>, PrimeBucketPolicy,
+                       SlabNodeAllocator, true>>("map<string>, CacheHash", keys, misses, map_insert, map_find);
+
+    auto arena_insert = [](auto& map, const std::string& key, int v) { map.insert(std::string_view(key), v); };
+    auto arena_find = [](auto& map, const std::string& key) { return map.find(key.data(), key.size()) != nullptr; };
+    run<MyUnorderedMap<char*, int>>("map<char*>", keys, misses, arena_insert, arena_find);
+    run<MyUnorderedMap<char*, int, MyHash<char*>, KeyEqual<char*>, PrimeBucketPolicy, SlabNodeAllocator, true>>(
+        "map<char*>, CacheHash", keys, misses, arena_insert, arena_find);
+
+    auto mm_insert = [](auto& map, const std::string& key, int v) { map.insert(key, v); };
+    auto mm_find = [](auto& map, const std::string& key) {
+        auto range = map.equal_range(key);
+        return range.first != range.second;
+    };
+    run<MyUnorderedMultimap<std::string, int>>("multimap<string>", keys, misses, mm_insert, mm_find);
+    run<MyUnorderedMultimap<std::string, int, DefaultMultimapHash<std::string>, std::equal_to<std::string>,
+                            PrimeBucketPolicy, SlabNodeAllocator, true>>("multimap<string>, CacheHash", keys, misses,
+                                                                         mm_insert, mm_find);
+    return 0;
+}
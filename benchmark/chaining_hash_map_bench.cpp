@@ -0,0 +1,205 @@
+// MyChainingHashMap基准：桶内联小向量 vs 原来的std::vector<std::list<KVNode>>
+// 原布局按原实现保留在本文件中（ListChainingHashMap）：每个元素一个链表节点，resize时新建一整张表逐个put（复制键值）再复制回来
+// 键值类型：int -> int（随机键、1024步长的键）、std::string -> std::string（键16~40字节，值32字节，都超出SSO）
+// 每种键比较三行：原布局（std::hash）、内联桶 + std::hash、内联桶 + 默认哈希（按键类型选择，整数先混合）。
+// std::hash对整数是恒等映射，桶数是2的幂、按%取桶，步长1024的键只落在 桶数/1024 个桶里
+// 1. put n个键（含全部扩容）：总耗时；最慢的一次put（即最后一次resize）的耗时
+// 2. get：n次命中、n次不命中
+// 3. remove全部键（含缩容）
+// 编译运行：g++ -O2 -std=c++17 benchmark/chaining_hash_map_bench.cpp -o chaining_hash_map_bench && ./chaining_hash_map_bench [键个数]
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <functional>
+#include <list>
+#include <string>
+#include <vector>
+#include "../data_structure/hashmap/hashmap.cpp"
+
+// ---- 原布局 ----
+template <typename K, typename V>
+class ListChainingHashMap {
+    struct KVNode {
+        K key;
+        V value;
+        KVNode(K key, V value) : key(key), value(value) {}
+    };
+
+    std::vector<std::list<KVNode>> table;
+    int size_;
+    static constexpr int INIT_CAP = 4;
+    static constexpr double LOAD_FACTOR = 0.75;
+
+    int hash(K key) const {
+        return (std::hash<K>{}(key) & 0x7fffffff) % table.size();
+    }
+
+    void resize(int new_cap) {
+        int newCap = std::max(new_cap, 1);
+        ListChainingHashMap<K, V> newMap(newCap);
+        for (auto& list : table) {
+            for (auto& node : list) {
+                newMap.put(node.key, node.value);
+            }
+        }
+        this->table = newMap.table;
+        this->size_ = newMap.size_;
+    }
+
+public:
+    ListChainingHashMap() : ListChainingHashMap(INIT_CAP) {}
+
+    explicit ListChainingHashMap(int initCapacity) {
+        size_ = 0;
+        table.resize(std::max(initCapacity, 1));
+    }
+
+    void put(K key, V val) {
+        auto& list = table[hash(key)];
+        for (auto& node : list) {
+            if (node.key == key) {
+                node.value = val;
+                return;
+            }
+        }
+        list.emplace_back(key, val);
+        size_++;
+        if (size_ >= LOAD_FACTOR * table.size()) {
+            resize(2 * table.size());
+        }
+    }
+
+    void remove(K key) {
+        auto& list = table[hash(key)];
+        for (auto it = list.begin(); it != list.end(); ++it) {
+            if (it->key == key) {
+                list.erase(it);
+                size_--;
+                if (size_ <= LOAD_FACTOR * table.size() / 4 && table.size() / 2 >= INIT_CAP) {
+                    resize(table.size() / 2);
+                }
+                return;
+            }
+        }
+    }
+
+    const V* get(K key) const {
+        for (const auto& node : table[hash(key)]) {
+            if (node.key == key) {
+                return &node.value;
+            }
+        }
+        return nullptr;
+    }
+
+    int size() const {
+        return size_;
+    }
+};
+
+double elapsed_ms(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+uint64_t xorshift(uint64_t& state) {
+    state ^= state << 13;
+    state ^= state >> 7;
+    state ^= state << 17;
+    return state;
+}
+
+long long value_of(int v) {
+    return v;
+}
+
+long long value_of(const std::string& v) {
+    return static_cast<long long>(v.size()) + v[0];
+}
+
+template <typename Map, typename K, typename V>
+void run(const char* name, const std::vector<K>& keys, const std::vector<V>& values, const std::vector<K>& misses,
+         long long& checksum) {
+    size_t n = keys.size();
+    Map map;
+    double slowest_put = 0;
+    auto start = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < n; ++i) {
+        auto put_start = std::chrono::steady_clock::now();
+        map.put(keys[i], values[i]);
+        double ms = elapsed_ms(put_start);
+        slowest_put = ms > slowest_put ? ms : slowest_put;
+    }
+    double put_ms = elapsed_ms(start);
+
+    start = std::chrono::steady_clock::now();
+    for (const K& k : keys) {
+        if (const V* v = map.get(k)) {
+            checksum += value_of(*v);
+        }
+    }
+    double hit_ns = elapsed_ms(start) * 1e6 / n;
+    start = std::chrono::steady_clock::now();
+    for (const K& k : misses) {
+        checksum += map.get(k) != nullptr;
+    }
+    double miss_ns = elapsed_ms(start) * 1e6 / n;
+
+    start = std::chrono::steady_clock::now();
+    for (const K& k : keys) {
+        map.remove(k);
+    }
+    double remove_ns = elapsed_ms(start) * 1e6 / n;
+    checksum += map.size();
+    std::printf("  %-22s %10.1f %12.2f %10.1f %10.1f %10.1f\n", name, put_ms * 1e6 / n, slowest_put, hit_ns,
+                miss_ns, remove_ns);
+}
+
+template <typename K, typename V>
+void compare(const char* title, const std::vector<K>& keys, const std::vector<V>& values, const std::vector<K>& misses,
+             long long& checksum) {
+    std::printf("\n[%s]\n  %-22s %10s %12s %10s %10s %10s\n", title, "layout", "put ns", "resize ms", "hit ns",
+                "miss ns", "remove ns");
+    run<ListChainingHashMap<K, V>>("std::list", keys, values, misses, checksum);
+    run<MyChainingHashMap<K, V, std::hash<K>>>("inline, std::hash", keys, values, misses, checksum);
+    run<MyChainingHashMap<K, V>>("inline, default hash", keys, values, misses, checksum);
+}
+
+int main(int argc, char** argv) {
+    int n = argc > 1 ? std::atoi(argv[1]) : 1000000;
+    uint64_t rng = 88172645463325252ULL;
+    long long checksum = 0;
+    std::printf("%d keys\n", n);
+    {
+        std::vector<int> keys(n), values(n), misses(n);
+        for (int i = 0; i < n; ++i) {
+            keys[i] = static_cast<int>(xorshift(rng) >> 34) * 2; // 偶数键（可能有少量重复）
+            values[i] = i;
+            misses[i] = static_cast<int>(xorshift(rng) >> 34) * 2 + 1;
+        }
+        compare("int -> int", keys, values, misses, checksum);
+    }
+    {
+        // 步长1024的ID（如按页、按分片分配的编号）；键数取n/8，否则std::hash的几行要跑很久
+        int m = n / 8;
+        std::vector<int> keys(m), values(m), misses(m);
+        for (int i = 0; i < m; ++i) {
+            keys[i] = i * 1024;
+            values[i] = i;
+            misses[i] = i * 1024 + 512;
+        }
+        compare("int -> int, keys i * 1024", keys, values, misses, checksum);
+    }
+    {
+        int m = n / 2;
+        std::vector<std::string> keys(m), values(m), misses(m);
+        for (int i = 0; i < m; ++i) {
+            keys[i] = "key:" + std::to_string(xorshift(rng));
+            keys[i].resize(16 + i % 25, '#');
+            values[i] = std::string(32, static_cast<char>('a' + i % 26));
+            misses[i] = "miss:" + std::to_string(xorshift(rng));
+        }
+        compare("string -> string", keys, values, misses, checksum);
+    }
+    std::printf("\n(checksum %lld)\n", checksum);
+    return 0;
+}
@@ -0,0 +1,113 @@
+// 分段锁并发哈希表基准：读多（95%查找）与写多（50%写入/删除）两种负载下，
+// 比较"单把大锁+MyUnorderedMap"与MyConcurrentHashMap随线程数增加的吞吐
+// 编译运行：g++ -O2 -std=c++17 -pthread benchmark/concurrent_hash_map_bench.cpp -o concurrent_hash_map_bench && ./concurrent_hash_map_bench [最大线程数]
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "../data_structure/concurrent_hash_map.cpp"
+
+const int kKeySpace = 1 << 20;
+const int kOpsPerThread = 1000000;
+
+// 对照组：一把互斥锁保护整个MyUnorderedMap
+struct GlobalLockMap {
+    std::mutex mutex;
+    MyUnorderedMap<int, int> map;
+
+    void insert_or_assign(int key, int value) {
+        std::lock_guard<std::mutex> lock(mutex);
+        map.insert(key, value);
+    }
+    bool find(int key, int& out) {
+        std::lock_guard<std::mutex> lock(mutex);
+        int* v = map.find(key);
+        if (v) {
+            out = *v;
+        }
+        return v != nullptr;
+    }
+    void erase(int key) {
+        std::lock_guard<std::mutex> lock(mutex);
+        map.erase(key);
+    }
+};
+
+struct ShardedMap {
+    MyConcurrentHashMap<int, int, 64> map;
+
+    void insert_or_assign(int key, int value) {
+        map.insert_or_assign(key, value);
+    }
+    bool find(int key, int& out) {
+        return map.find_and_apply(key, [&](int& v) { out = v; });
+    }
+    void erase(int key) {
+        map.erase(key);
+    }
+};
+
+// read_percent：查找占比，其余操作一半写入一半删除
+template <typename MapT>
+double run(MapT& map, int threads, int read_percent) {
+    std::vector<std::thread> workers;
+    auto start = std::chrono::steady_clock::now();
+    for (int t = 0; t < threads; ++t) {
+        workers.emplace_back([&map, t, read_percent]() {
+            unsigned long long seed = 0x9E3779B97F4A7C15ULL * (t + 1);
+            long long found = 0;
+            for (int i = 0; i < kOpsPerThread; ++i) {
+                seed ^= seed << 13;
+                seed ^= seed >> 7;
+                seed ^= seed << 17;
+                int key = static_cast<int>(seed % kKeySpace);
+                int dice = static_cast<int>((seed >> 32) % 100);
+                if (dice < read_percent) {
+                    int out;
+                    found += map.find(key, out);
+                } else if (dice & 1) {
+                    map.insert_or_assign(key, i);
+                } else {
+                    map.erase(key);
+                }
+            }
+            if (found < 0) {
+                std::printf("unreachable\n");
+            }
+        });
+    }
+    for (auto& w : workers) {
+        w.join();
+    }
+    auto end = std::chrono::steady_clock::now();
+    double sec = std::chrono::duration<double>(end - start).count();
+    return threads * static_cast<double>(kOpsPerThread) / sec / 1e6; // Mops/s
+}
+
+template <typename MapT>
+void prefill(MapT& map) {
+    for (int i = 0; i < kKeySpace; i += 2) {
+        map.insert_or_assign(i, i);
+    }
+}
+
+int main(int argc, char** argv) {
+    int max_threads = argc > 1 ? std::atoi(argv[1]) : 32;
+    const int workloads[] = {95, 50};
+    for (int read_percent : workloads) {
+        std::printf("workload: %d%% find, keys=%d, ops/thread=%d\n", read_percent, kKeySpace, kOpsPerThread);
+        std::printf("%8s %16s %16s\n", "threads", "global-lock", "sharded(64)");
+        for (int threads = 1; threads <= max_threads; threads *= 2) {
+            GlobalLockMap global;
+            ShardedMap sharded;
+            prefill(global);
+            prefill(sharded);
+            double a = run(global, threads, read_percent);
+            double b = run(sharded, threads, read_percent);
+            std::printf("%8d %11.2f Mop/s %11.2f Mop/s\n", threads, a, b);
+        }
+    }
+    return 0;
+}
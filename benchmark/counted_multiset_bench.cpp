@@ -0,0 +1,132 @@
+// 计数模式基准：MyUnorderedMultiSet<int>（每个重复一个节点） vs MyCountedMultiSet<int>（每个不同值一个节点 + 重数）
+// 输入服从Zipf分布（s = 0.8 / 1.1 / 1.5），s越大重复越集中
+// 1. 内存：节点 + 桶数组的大致字节数
+// 2. 插入吞吐
+// 3. count：对最热的1000个值各查一次（逐个节点存储时count要走完该值的所有重复）
+// 4. 遍历全部元素（含重复）
+// 5. erase_one逐个删空 / erase整值删空
+// 编译运行：g++ -O2 -std=c++17 benchmark/counted_multiset_bench.cpp -o counted_multiset_bench && ./counted_multiset_bench [元素个数] [不同值个数]
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+#include "../container/std_unordered_multiset_withoutstl_completeversion.cpp"
+
+double elapsed_ms(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+uint64_t xorshift(uint64_t& state) {
+    state ^= state << 13;
+    state ^= state >> 7;
+    state ^= state << 17;
+    return state;
+}
+
+// 按Zipf分布抽样：预先算好累计分布，每次二分查找
+std::vector<int> zipf_sample(int n, int distinct, double s, uint64_t& rng) {
+    std::vector<double> cdf(distinct);
+    double total = 0;
+    for (int i = 0; i < distinct; ++i) {
+        total += 1.0 / std::pow(i + 1.0, s);
+        cdf[i] = total;
+    }
+    std::vector<int> out(n);
+    for (int i = 0; i < n; ++i) {
+        double u = (xorshift(rng) >> 11) * (1.0 / 9007199254740992.0) * total;
+        int lo = 0, hi = distinct - 1;
+        while (lo < hi) {
+            int mid = (lo + hi) / 2;
+            if (cdf[mid] < u) {
+                lo = mid + 1;
+            } else {
+                hi = mid;
+            }
+        }
+        out[i] = lo * 7919 + 13; // 打散成非连续的值
+    }
+    return out;
+}
+
+const int kCountQueries = 1000;
+
+int main(int argc, char** argv) {
+    int n = argc > 1 ? std::atoi(argv[1]) : 4000000;
+    int distinct = argc > 2 ? std::atoi(argv[2]) : 100000;
+    uint64_t rng = 88172645463325252ULL;
+    const double skews[] = {0.8, 1.1, 1.5};
+    long long checksum = 0;
+
+    std::printf("node bytes: per-duplicate %zu, counted %zu\n", sizeof(HashNode<int>), sizeof(CountedHashNode<int>));
+    for (double s : skews) {
+        std::vector<int> input = zipf_sample(n, distinct, s, rng);
+        std::printf("\nzipf s=%.1f, %d elements over %d candidate values\n", s, n, distinct);
+
+        // 逐个节点存储
+        {
+            MyUnorderedMultiSet<int> set;
+            auto start = std::chrono::steady_clock::now();
+            for (int v : input) {
+                set.insert(v);
+            }
+            double insert_ms = elapsed_ms(start);
+            size_t bytes = set.size() * sizeof(HashNode<int>) + set.bucket_count() * sizeof(void*);
+
+            start = std::chrono::steady_clock::now();
+            for (int i = 0; i < kCountQueries; ++i) {
+                checksum += set.count(i * 7919 + 13);
+            }
+            double count_us = elapsed_ms(start) * 1e3 / kCountQueries;
+
+            start = std::chrono::steady_clock::now();
+            for (auto it = set.begin(); it != set.end(); ++it) {
+                checksum += *it;
+            }
+            double iter_ms = elapsed_ms(start);
+
+            start = std::chrono::steady_clock::now();
+            for (int v : input) {
+                checksum += set.erase(v);
+            }
+            double erase_ms = elapsed_ms(start);
+            std::printf("  %-16s memory %8.1f MB  insert %7.1f ms  count %9.3f us/op  iterate %6.1f ms  erase(val) %6.1f ms\n",
+                        "per-duplicate", bytes / 1048576.0, insert_ms, count_us, iter_ms, erase_ms);
+        }
+
+        // 计数模式
+        {
+            MyCountedMultiSet<int> set;
+            auto start = std::chrono::steady_clock::now();
+            for (int v : input) {
+                set.insert(v);
+            }
+            double insert_ms = elapsed_ms(start);
+            size_t distinct_values = set.distinct_count();
+            size_t bytes = distinct_values * sizeof(CountedHashNode<int>) + set.bucket_count() * sizeof(void*);
+
+            start = std::chrono::steady_clock::now();
+            for (int i = 0; i < kCountQueries; ++i) {
+                checksum += set.count(i * 7919 + 13);
+            }
+            double count_us = elapsed_ms(start) * 1e3 / kCountQueries;
+
+            start = std::chrono::steady_clock::now();
+            for (auto it = set.begin(); it != set.end(); ++it) {
+                checksum += *it;
+            }
+            double iter_ms = elapsed_ms(start);
+
+            start = std::chrono::steady_clock::now();
+            for (int v : input) {
+                checksum += set.erase_one(v);
+            }
+            double erase_one_ms = elapsed_ms(start);
+            std::printf("  %-16s memory %8.1f MB  insert %7.1f ms  count %9.3f us/op  iterate %6.1f ms  erase_one %6.1f ms"
+                        "  (%zu distinct)\n",
+                        "counted", bytes / 1048576.0, insert_ms, count_us, iter_ms, erase_one_ms, distinct_values);
+        }
+    }
+    std::printf("\n(checksum %lld)\n", checksum);
+    return 0;
+}
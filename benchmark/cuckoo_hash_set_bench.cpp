@@ -0,0 +1,127 @@
+// MyCuckooSet（分桶布谷鸟，两个哈希函数、每桶4槽） vs MyUnordered（每个键一个链表节点，max_load_factor = 1.0），键为int
+// 1. 建表：逐个插入随机键；MyCuckooSet另测reserve(n)后插入（按95%占用率预留，插入过程中不再扩容）
+// 2. 内存：每个键的字节数（MyCuckooSet按桶数组实际分配；MyUnordered按节点 + 桶链表头估算，不含malloc头部）
+// 3. 随机查找：命中与不命中各一遍
+// 4. 占用率：元素数 / 槽数（MyUnordered为元素数 / 桶数），以及暂存区中的键数
+// 编译运行：g++ -O2 -std=c++17 benchmark/cuckoo_hash_set_bench.cpp -o cuckoo_hash_set_bench && ./cuckoo_hash_set_bench [键个数]
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+#include "../data_structure/cuckoo_hash_set.cpp"
+
+double elapsed_ms(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+uint64_t xorshift(uint64_t& state) {
+    state ^= state << 13;
+    state ^= state >> 7;
+    state ^= state << 17;
+    return state;
+}
+
+struct Result {
+    double build_ms, hit_ns, miss_ns, bytes_per_key, occupancy;
+    size_t stash;
+};
+
+void print_row(const char* name, const Result& r) {
+    std::printf("  %-24s %9.1f %12.2f %10.1f %10.1f %10.3f %6zu\n", name, r.build_ms, r.bytes_per_key, r.hit_ns,
+                r.miss_ns, r.occupancy, r.stash);
+}
+
+template <typename Set>
+void measure_lookups(const Set& set, const std::vector<int>& queries, const std::vector<int>& misses, Result& r,
+                     long long& checksum) {
+    auto start = std::chrono::steady_clock::now();
+    for (int q : queries) {
+        checksum += set.find(q);
+    }
+    r.hit_ns = elapsed_ms(start) * 1e6 / queries.size();
+    start = std::chrono::steady_clock::now();
+    for (int q : misses) {
+        checksum += set.find(q);
+    }
+    r.miss_ns = elapsed_ms(start) * 1e6 / misses.size();
+}
+
+int main(int argc, char** argv) {
+    int n = argc > 1 ? std::atoi(argv[1]) : 1000000;
+    uint64_t rng = 88172645463325252ULL;
+    std::vector<int> keys(n), misses(n), queries(n);
+    for (int i = 0; i < n; ++i) {
+        keys[i] = static_cast<int>(xorshift(rng) >> 34) * 2; // 偶数键
+        misses[i] = keys[i] + 1; // 奇数一定不存在
+    }
+    for (int i = 0; i < n; ++i) {
+        queries[i] = keys[xorshift(rng) % n];
+    }
+    long long checksum = 0;
+    std::printf("%d random int keys\n", n);
+    std::printf("  %-24s %9s %12s %10s %10s %10s %6s\n", "", "build ms", "bytes/key", "hit ns", "miss ns", "occupancy",
+                "stash");
+
+    {
+        MyUnordered<int> set;
+        Result r = {};
+        auto start = std::chrono::steady_clock::now();
+        for (int i = 0; i < n; ++i) {
+            set.insert(keys[i]);
+        }
+        r.build_ms = elapsed_ms(start);
+        size_t bytes = set.size() * sizeof(Node<int>) + set.bucket_count() * sizeof(LinkedList<int>);
+        r.bytes_per_key = static_cast<double>(bytes) / set.size();
+        r.occupancy = set.load_factor();
+        measure_lookups(set, queries, misses, r, checksum);
+        print_row("MyUnordered", r);
+    }
+
+    for (int reserve = 0; reserve < 2; ++reserve) {
+        MyCuckooSet<int> set;
+        Result r = {};
+        auto start = std::chrono::steady_clock::now();
+        if (reserve) {
+            set.reserve(n);
+        }
+        for (int i = 0; i < n; ++i) {
+            set.insert(keys[i]);
+        }
+        r.build_ms = elapsed_ms(start);
+        r.bytes_per_key = static_cast<double>(set.memory_bytes()) / set.size();
+        r.occupancy = set.load_factor();
+        r.stash = set.stash_size();
+        measure_lookups(set, queries, misses, r, checksum);
+        print_row(reserve ? "MyCuckooSet (reserve n)" : "MyCuckooSet", r);
+    }
+
+    // 按桶数组恰好填到95%的键数插入，看最高占用率下的查找
+    {
+        MyCuckooSet<int> set(n);
+        size_t fill = set.bucket_count() * MyCuckooSet<int>::kSlots * 95 / 100;
+        std::vector<int> fill_keys;
+        fill_keys.reserve(fill);
+        for (size_t i = 0; i < fill; ++i) {
+            fill_keys.push_back(static_cast<int>(xorshift(rng) >> 34) * 2);
+        }
+        Result r = {};
+        auto start = std::chrono::steady_clock::now();
+        for (int k : fill_keys) {
+            set.insert(k);
+        }
+        r.build_ms = elapsed_ms(start);
+        r.bytes_per_key = static_cast<double>(set.memory_bytes()) / set.size();
+        r.occupancy = set.load_factor();
+        r.stash = set.stash_size();
+        std::vector<int> fill_queries(n), fill_misses(n);
+        for (int i = 0; i < n; ++i) {
+            fill_queries[i] = fill_keys[xorshift(rng) % fill_keys.size()];
+            fill_misses[i] = fill_queries[i] + 1;
+        }
+        measure_lookups(set, fill_queries, fill_misses, r, checksum);
+        print_row("MyCuckooSet (95% fill)", r);
+    }
+
+    std::printf("\n(checksum %lld)\n", checksum);
+    return 0;
+}
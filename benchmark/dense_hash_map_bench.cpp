@@ -0,0 +1,129 @@
+// MyDenseMap（连续键值对数组 + 32位索引表） vs MyUnorderedMap（链式节点），键值均为int
+// 1. 建表：逐个插入随机键
+// 2. 遍历：完整遍历10遍，累加值（MyUnorderedMap用for_each）
+// 3. 随机查找：命中与不命中各一遍
+// 4. 删除一半键后再遍历
+// 5. 内存：MyDenseMap按容量统计实际分配；MyUnorderedMap按节点 + 桶数组估算
+// 编译运行：g++ -O2 -std=c++17 benchmark/dense_hash_map_bench.cpp -o dense_hash_map_bench && ./dense_hash_map_bench [键个数]
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+#include "../data_structure/dense_hash_map.cpp"
+
+double elapsed_ms(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+uint64_t xorshift(uint64_t& state) {
+    state ^= state << 13;
+    state ^= state >> 7;
+    state ^= state << 17;
+    return state;
+}
+
+const int kIterRounds = 10;
+
+int main(int argc, char** argv) {
+    int n = argc > 1 ? std::atoi(argv[1]) : 1000000;
+    uint64_t rng = 88172645463325252ULL;
+    std::vector<int> keys(n), misses(n), queries(n);
+    for (int i = 0; i < n; ++i) {
+        keys[i] = static_cast<int>(xorshift(rng) >> 34) * 2; // 偶数键
+        misses[i] = keys[i] + 1; // 奇数一定不存在
+    }
+    for (int i = 0; i < n; ++i) {
+        queries[i] = keys[xorshift(rng) % n];
+    }
+    long long checksum = 0;
+    std::printf("%d random int keys\n", n);
+    std::printf("  %-16s %9s %12s %10s %10s %14s %10s\n", "", "build ms", "iterate ms", "hit ns", "miss ns",
+                "iter-after-erase", "memory MB");
+
+    {
+        MyUnorderedMap<int, int> map;
+        auto start = std::chrono::steady_clock::now();
+        for (int i = 0; i < n; ++i) {
+            map.insert(keys[i], i);
+        }
+        double build_ms = elapsed_ms(start);
+        size_t bytes = map.size() * sizeof(HashNode<int, int>) + map.bucket_count() * sizeof(void*);
+
+        start = std::chrono::steady_clock::now();
+        for (int round = 0; round < kIterRounds; ++round) {
+            map.for_each([&checksum](const int&, const int& v) { checksum += v; });
+        }
+        double iter_ms = elapsed_ms(start) / kIterRounds;
+
+        start = std::chrono::steady_clock::now();
+        for (int q : queries) {
+            if (int* v = map.find(q)) {
+                checksum += *v;
+            }
+        }
+        double hit_ns = elapsed_ms(start) * 1e6 / n;
+        start = std::chrono::steady_clock::now();
+        for (int q : misses) {
+            checksum += map.find(q) != nullptr;
+        }
+        double miss_ns = elapsed_ms(start) * 1e6 / n;
+
+        for (int i = 0; i < n; i += 2) {
+            map.erase(keys[i]);
+        }
+        start = std::chrono::steady_clock::now();
+        for (int round = 0; round < kIterRounds; ++round) {
+            map.for_each([&checksum](const int&, const int& v) { checksum += v; });
+        }
+        double iter2_ms = elapsed_ms(start) / kIterRounds;
+        std::printf("  %-16s %9.1f %12.2f %10.1f %10.1f %14.2f %10.1f\n", "MyUnorderedMap", build_ms, iter_ms, hit_ns,
+                    miss_ns, iter2_ms, bytes / 1048576.0);
+    }
+
+    {
+        MyDenseMap<int, int> map;
+        auto start = std::chrono::steady_clock::now();
+        for (int i = 0; i < n; ++i) {
+            map.insert(keys[i], i);
+        }
+        double build_ms = elapsed_ms(start);
+        size_t bytes = map.memory_bytes();
+
+        start = std::chrono::steady_clock::now();
+        for (int round = 0; round < kIterRounds; ++round) {
+            for (const auto& kv : map) {
+                checksum += kv.second;
+            }
+        }
+        double iter_ms = elapsed_ms(start) / kIterRounds;
+
+        start = std::chrono::steady_clock::now();
+        for (int q : queries) {
+            if (int* v = map.find(q)) {
+                checksum += *v;
+            }
+        }
+        double hit_ns = elapsed_ms(start) * 1e6 / n;
+        start = std::chrono::steady_clock::now();
+        for (int q : misses) {
+            checksum += map.find(q) != nullptr;
+        }
+        double miss_ns = elapsed_ms(start) * 1e6 / n;
+
+        for (int i = 0; i < n; i += 2) {
+            map.erase(keys[i]);
+        }
+        start = std::chrono::steady_clock::now();
+        for (int round = 0; round < kIterRounds; ++round) {
+            for (const auto& kv : map) {
+                checksum += kv.second;
+            }
+        }
+        double iter2_ms = elapsed_ms(start) / kIterRounds;
+        std::printf("  %-16s %9.1f %12.2f %10.1f %10.1f %14.2f %10.1f\n", "MyDenseMap", build_ms, iter_ms, hit_ns,
+                    miss_ns, iter2_ms, bytes / 1048576.0);
+    }
+
+    std::printf("\n(checksum %lld)\n", checksum);
+    return 0;
+}
@@ -0,0 +1,124 @@
+// MyUnorderedMultiSet原地构造基准
+// 1. 构造计数：元素类型统计构造/拷贝/移动次数
+//    - insert(T(args))：临时对象构造一次 + 移入节点一次
+//    - emplace(args)：只在节点里构造一次（旧实现先构造临时对象求哈希，再在节点里构造第二次）
+// 2. 吞吐：元素含一个超出SSO的std::string
+//    - insert(T(args)) / emplace(args) / reserve(n)后emplace
+//    - 大量重复值：emplace vs emplace_hint（提示指向同值元素，新节点直接链在它后面）
+// 编译运行：g++ -O2 -std=c++17 benchmark/emplace_multiset_bench.cpp -o emplace_multiset_bench && ./emplace_multiset_bench [元素个数]
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <vector>
+#include "../container/std_unordered_multiset_withoutstl_completeversion.cpp"
+
+double elapsed_ms(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+struct Counters {
+    long long ctor = 0, copy = 0, move = 0;
+};
+Counters g_count;
+
+// 带计数的元素：名字 + 编号
+struct Record {
+    std::string name;
+    int id;
+
+    Record(const char* n, int i) : name(n), id(i) {
+        ++g_count.ctor;
+    }
+    Record(const Record& other) : name(other.name), id(other.id) {
+        ++g_count.copy;
+    }
+    Record(Record&& other) noexcept : name(std::move(other.name)), id(other.id) {
+        ++g_count.move;
+    }
+
+    bool operator==(const Record& other) const {
+        return id == other.id && name == other.name;
+    }
+};
+
+struct RecordHash {
+    size_t operator()(const Record& r) const {
+        return hash_bytes(r.name.data(), r.name.size(), static_cast<uint64_t>(r.id));
+    }
+};
+
+using RecordSet = MyUnorderedMultiSet<Record, RecordHash>;
+
+const char* kName = "a record name longer than the small string buffer";
+
+void print_counts(const char* name, int n, double ms) {
+    std::printf("  %-28s %7.1f ms   per element: ctor %.2f  copy %.2f  move %.2f\n", name, ms,
+                static_cast<double>(g_count.ctor) / n, static_cast<double>(g_count.copy) / n,
+                static_cast<double>(g_count.move) / n);
+    g_count = Counters();
+}
+
+int main(int argc, char** argv) {
+    int n = argc > 1 ? std::atoi(argv[1]) : 1000000;
+    std::printf("%d elements\n", n);
+
+    std::printf("\n[distinct ids]\n");
+    {
+        RecordSet set;
+        auto start = std::chrono::steady_clock::now();
+        for (int i = 0; i < n; ++i) {
+            set.insert(Record(kName, i));
+        }
+        print_counts("insert(Record(args))", n, elapsed_ms(start));
+    }
+    {
+        RecordSet set;
+        auto start = std::chrono::steady_clock::now();
+        for (int i = 0; i < n; ++i) {
+            set.emplace(kName, i);
+        }
+        print_counts("emplace(args)", n, elapsed_ms(start));
+    }
+    {
+        RecordSet set;
+        auto start = std::chrono::steady_clock::now();
+        set.reserve(n);
+        for (int i = 0; i < n; ++i) {
+            set.emplace(kName, i);
+        }
+        print_counts("reserve(n) + emplace(args)", n, elapsed_ms(start));
+    }
+
+    // 每个id重复64次，同一个id连续插入
+    const int kRepeat = 64;
+    std::printf("\n[each id repeated %d times]\n", kRepeat);
+    size_t check = 0;
+    {
+        RecordSet set;
+        set.reserve(n);
+        auto start = std::chrono::steady_clock::now();
+        for (int i = 0; i < n; ++i) {
+            set.emplace(kName, i / kRepeat);
+        }
+        print_counts("emplace(args)", n, elapsed_ms(start));
+        check += set.size();
+    }
+    {
+        RecordSet set;
+        set.reserve(n);
+        auto start = std::chrono::steady_clock::now();
+        RecordSet::iterator hint = set.end();
+        for (int i = 0; i < n; ++i) {
+            if (i % kRepeat == 0) {
+                hint = set.emplace(kName, i / kRepeat);
+            } else {
+                hint = set.emplace_hint(hint, kName, i / kRepeat);
+            }
+        }
+        print_counts("emplace_hint(same id, args)", n, elapsed_ms(start));
+        check += set.size();
+    }
+    std::printf("\n(check %zu)\n", check);
+    return 0;
+}
@@ -0,0 +1,72 @@
+// 批量查找基准：表远大于末级缓存时，逐个find与find_batch/contains_batch（分组预取）的对比
+// 探测键一半命中一半不命中，顺序随机；按1k~64k的批大小调用
+// 编译运行：g++ -O2 -std=c++17 benchmark/find_batch_bench.cpp -o find_batch_bench && ./find_batch_bench [表中键个数]
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+#include "../container/std_unordered_map_withoutstl.cpp"
+
+double elapsed_ms(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+int main(int argc, char** argv) {
+    int n = argc > 1 ? std::atoi(argv[1]) : 16000000;
+    const size_t kProbes = 4u << 20;
+
+    MyUnorderedMap<int, int> map;
+    for (int i = 0; i < n; ++i) {
+        map.insert(i * 2, i); // 只插入偶数，奇数探测必然不命中
+    }
+    std::printf("table: %d keys, %zu buckets (~%zu MB nodes + buckets)\n", n, map.bucket_count(),
+                (static_cast<size_t>(n) * sizeof(HashNode<int, int>) + map.bucket_count() * sizeof(void*)) >> 20);
+
+    std::vector<int> probes(kProbes);
+    unsigned long long seed = 0x9E3779B97F4A7C15ULL;
+    for (size_t i = 0; i < kProbes; ++i) {
+        seed ^= seed << 13;
+        seed ^= seed >> 7;
+        seed ^= seed << 17;
+        probes[i] = static_cast<int>(seed % (2ull * n));
+    }
+
+    std::vector<int*> out(kProbes);
+    std::vector<char> hit_flags(kProbes);
+    bool* flags = reinterpret_cast<bool*>(hit_flags.data());
+
+    std::printf("%10s %14s %14s %16s\n", "batch", "find loop", "find_batch", "contains_batch");
+    const size_t batches[] = {1024, 4096, 16384, 65536};
+    for (size_t batch : batches) {
+        long long sum_loop = 0, sum_batch = 0;
+        size_t hits = 0;
+
+        auto start = std::chrono::steady_clock::now();
+        for (size_t base = 0; base < kProbes; base += batch) {
+            for (size_t i = base; i < base + batch; ++i) {
+                int* v = map.find(probes[i]);
+                sum_loop += v ? *v : 0;
+            }
+        }
+        double loop_ns = elapsed_ms(start) * 1e6 / kProbes;
+
+        start = std::chrono::steady_clock::now();
+        for (size_t base = 0; base < kProbes; base += batch) {
+            map.find_batch(&probes[base], batch, &out[base]);
+            for (size_t i = base; i < base + batch; ++i) {
+                sum_batch += out[i] ? *out[i] : 0;
+            }
+        }
+        double batch_ns = elapsed_ms(start) * 1e6 / kProbes;
+
+        start = std::chrono::steady_clock::now();
+        for (size_t base = 0; base < kProbes; base += batch) {
+            hits += map.contains_batch(&probes[base], batch, flags + base);
+        }
+        double contains_ns = elapsed_ms(start) * 1e6 / kProbes;
+
+        std::printf("%10zu %11.1f ns %11.1f ns %13.1f ns   (sums %s, hits %zu)\n", batch, loop_ns, batch_ns,
+                    contains_ns, sum_loop == sum_batch ? "match" : "DIFFER", hits);
+    }
+    return 0;
+}
@@ -0,0 +1,164 @@
+// 按键分组布局基准：MyUnorderedMultimap（每个值一个节点） vs MyGroupedMultimap（每个键一个节点 + 连续值数组）
+// 键的值个数服从Zipf分布（s = 0 / 0.8 / 1.2，s越大越偏斜，少数热点键占据大部分值），插入顺序随机打乱
+// 1. 建表：逐个insert
+// 2. 热点键遍历：反复对值最多的前16个键做equal_range并累加全部值
+// 3. 全部键count
+// 4. 逐键删除全部元素
+// 编译运行：g++ -O2 -std=c++17 benchmark/grouped_multimap_bench.cpp -o grouped_multimap_bench && ./grouped_multimap_bench [值总数] [键个数]
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+#include "../container/std_unordered_multimap_withoutstl.cpp"
+
+double elapsed_ms(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+uint64_t xorshift(uint64_t& state) {
+    state ^= state << 13;
+    state ^= state >> 7;
+    state ^= state << 17;
+    return state;
+}
+
+// 第i个键分到的值个数正比于1/(i+1)^s，总数为n；返回打乱后的插入序列
+std::vector<int> zipf_keys(int n, int keys, double s, uint64_t& rng) {
+    std::vector<double> weight(keys);
+    double total = 0;
+    for (int i = 0; i < keys; ++i) {
+        weight[i] = 1.0 / std::pow(i + 1.0, s);
+        total += weight[i];
+    }
+    std::vector<int> seq;
+    seq.reserve(n);
+    for (int i = 0; i < keys && static_cast<int>(seq.size()) < n; ++i) {
+        int cnt = std::max(1, static_cast<int>(weight[i] / total * n));
+        for (int j = 0; j < cnt && static_cast<int>(seq.size()) < n; ++j) {
+            seq.push_back(i);
+        }
+    }
+    while (static_cast<int>(seq.size()) < n) {
+        seq.push_back(static_cast<int>(xorshift(rng) % keys));
+    }
+    for (size_t i = seq.size() - 1; i > 0; --i) {
+        std::swap(seq[i], seq[xorshift(rng) % (i + 1)]);
+    }
+    return seq;
+}
+
+struct Result {
+    double build_ms, hot_ms, count_ms, erase_ms;
+    long long checksum;
+};
+
+const int kHotKeys = 16;
+const int kHotRounds = 20;
+
+// 前kHotKeys个键（值最多的那些）的值总数
+long long hot_total(const std::vector<int>& per_key) {
+    long long total = 0;
+    for (int k = 0; k < kHotKeys && k < static_cast<int>(per_key.size()); ++k) {
+        total += per_key[k];
+    }
+    return total;
+}
+
+Result run_node_per_value(const std::vector<int>& seq, int keys) {
+    Result r{};
+    MyUnorderedMultimap<int, int> map;
+    auto start = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < seq.size(); ++i) {
+        map.insert(seq[i], static_cast<int>(i));
+    }
+    r.build_ms = elapsed_ms(start);
+
+    start = std::chrono::steady_clock::now();
+    for (int round = 0; round < kHotRounds; ++round) {
+        for (int k = 0; k < kHotKeys; ++k) {
+            auto range = map.equal_range(k);
+            for (auto it = range.first; it != range.second; ++it) {
+                r.checksum += it->second;
+            }
+        }
+    }
+    r.hot_ms = elapsed_ms(start);
+
+    start = std::chrono::steady_clock::now();
+    for (int k = 0; k < keys; ++k) {
+        r.checksum += map.count(k);
+    }
+    r.count_ms = elapsed_ms(start);
+
+    start = std::chrono::steady_clock::now();
+    for (int k = 0; k < keys; ++k) {
+        auto range = map.equal_range(k);
+        for (auto it = range.first; it != range.second;) {
+            it = map.erase(it);
+        }
+    }
+    r.erase_ms = elapsed_ms(start);
+    r.checksum += map.size();
+    return r;
+}
+
+Result run_grouped(const std::vector<int>& seq, int keys) {
+    Result r{};
+    MyGroupedMultimap<int, int> map;
+    auto start = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < seq.size(); ++i) {
+        map.insert(seq[i], static_cast<int>(i));
+    }
+    r.build_ms = elapsed_ms(start);
+
+    start = std::chrono::steady_clock::now();
+    for (int round = 0; round < kHotRounds; ++round) {
+        for (int k = 0; k < kHotKeys; ++k) {
+            for (int v : map.equal_range(k)) {
+                r.checksum += v;
+            }
+        }
+    }
+    r.hot_ms = elapsed_ms(start);
+
+    start = std::chrono::steady_clock::now();
+    for (int k = 0; k < keys; ++k) {
+        r.checksum += map.count(k);
+    }
+    r.count_ms = elapsed_ms(start);
+
+    start = std::chrono::steady_clock::now();
+    for (int k = 0; k < keys; ++k) {
+        map.erase(k);
+    }
+    r.erase_ms = elapsed_ms(start);
+    r.checksum += map.size();
+    return r;
+}
+
+void print(const char* name, const Result& r) {
+    std::printf("  %-20s build %8.1f ms  hot equal_range %8.2f ms  count %7.2f ms  erase %8.1f ms  (checksum %lld)\n",
+                name, r.build_ms, r.hot_ms, r.count_ms, r.erase_ms, r.checksum);
+}
+
+int main(int argc, char** argv) {
+    int n = argc > 1 ? std::atoi(argv[1]) : 2000000;
+    int keys = argc > 2 ? std::atoi(argv[2]) : 50000;
+    uint64_t rng = 88172645463325252ULL;
+    const double skews[] = {0.0, 0.8, 1.2};
+    for (double s : skews) {
+        std::vector<int> seq = zipf_keys(n, keys, s, rng);
+        std::vector<int> per_key(keys, 0);
+        for (int k : seq) {
+            ++per_key[k];
+        }
+        std::printf("zipf s=%.1f: %d values, %d keys, hottest key %d values, top %d keys hold %.1f%%\n", s, n, keys,
+                    *std::max_element(per_key.begin(), per_key.end()), kHotKeys,
+                    100.0 * hot_total(per_key) / n);
+        print("node per value", run_node_per_value(seq, keys));
+        print("grouped by key", run_grouped(seq, keys));
+    }
+    return 0;
+}
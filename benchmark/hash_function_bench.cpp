@@ -0,0 +1,201 @@
+// 哈希函数基准：旧哈希（整数恒等、字符串h*31+c、djb2）与hash_function.h中的新哈希对比
+// 1. 分布：典型键集合分别放入2的幂桶（直接取低位，不额外混合）和质数桶，统计空桶比例、最长链、平均查找长度
+// 2. 吞吐：不同长度字节串的哈希速度（GB/s）
+// 3. 端到端：MyUnorderedMap<int>/<char*>分别使用旧/新哈希的插入+查找耗时
+// 编译运行：g++ -O2 -std=c++17 benchmark/hash_function_bench.cpp -o hash_function_bench && ./hash_function_bench [键个数]
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+#include "../container/std_unordered_map_withoutstl.cpp"
+
+// ---- 旧哈希 ----
+struct IdentityIntHash {
+    size_t operator()(const int& key) const {
+        return static_cast<size_t>(key);
+    }
+};
+
+struct Mul31StringHash {
+    size_t operator()(const char* key) const {
+        return (*this)(key, my_strlen(key));
+    }
+    size_t operator()(const char* key, size_t len) const {
+        size_t h = 0;
+        for (size_t i = 0; i < len; ++i) {
+            h = h * 31 + static_cast<unsigned char>(key[i]);
+        }
+        return h;
+    }
+};
+
+size_t djb2(const char* str, size_t len) {
+    size_t h = 5381;
+    for (size_t i = 0; i < len; ++i) {
+        h = ((h << 5) + h) + static_cast<unsigned char>(str[i]);
+    }
+    return h;
+}
+
+double elapsed_ms(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+// 按给定哈希值统计桶分布
+// use_mask为true时桶数取2的幂并直接取低位（模拟未混合的掩码索引），否则桶数取质数并取模
+void report_distribution(const char* name, const std::vector<size_t>& hashes, bool use_mask) {
+    size_t n = hashes.size();
+    size_t buckets;
+    if (use_mask) {
+        buckets = 1;
+        while (buckets < n) {
+            buckets <<= 1;
+        }
+    } else {
+        PrimeBucketPolicy policy;
+        buckets = policy.reset(n);
+    }
+    std::vector<unsigned> chain(buckets, 0);
+    for (size_t h : hashes) {
+        ++chain[use_mask ? (h & (buckets - 1)) : (h % buckets)];
+    }
+    size_t empty = 0, longest = 0;
+    double probe_sum = 0; // 每个元素查找成功时需要比较的次数之和：长度为c的链贡献1+2+...+c
+    for (unsigned c : chain) {
+        empty += c == 0;
+        longest = c > longest ? c : longest;
+        probe_sum += c * (c + 1.0) / 2;
+    }
+    std::printf("  %-28s %-6s buckets %8zu  empty %5.1f%%  longest %6zu  avg probe %6.2f\n", name,
+                use_mask ? "mask" : "prime", buckets, 100.0 * empty / buckets, longest, probe_sum / n);
+}
+
+int main(int argc, char** argv) {
+    int n = argc > 1 ? std::atoi(argv[1]) : 1000000;
+
+    // ---- 1. 分布 ----
+    std::printf("distribution, n = %d\n", n);
+    {
+        std::vector<size_t> old_seq, new_seq, old_stride, new_stride;
+        MyHash<int> mix;
+        for (int i = 0; i < n; ++i) {
+            old_seq.push_back(IdentityIntHash()(i));
+            new_seq.push_back(mix(i));
+            old_stride.push_back(IdentityIntHash()(i * 1024)); // 按页/按块编号这类等步长ID
+            new_stride.push_back(mix(i * 1024));
+        }
+        for (int use_mask = 1; use_mask >= 0; --use_mask) {
+            report_distribution("int seq, identity", old_seq, use_mask);
+            report_distribution("int seq, fmix64", new_seq, use_mask);
+            report_distribution("int stride 1024, identity", old_stride, use_mask);
+            report_distribution("int stride 1024, fmix64", new_stride, use_mask);
+        }
+
+        std::vector<size_t> h31, hdjb, hwy;
+        char key[64];
+        for (int i = 0; i < n; ++i) {
+            int len = std::snprintf(key, sizeof(key), "order/2024/%08d", i); // 公共前缀+递增编号
+            h31.push_back(Mul31StringHash()(key, len));
+            hdjb.push_back(djb2(key, len));
+            hwy.push_back(hash_bytes(key, len));
+        }
+        for (int use_mask = 1; use_mask >= 0; --use_mask) {
+            report_distribution("prefixed str, h*31+c", h31, use_mask);
+            report_distribution("prefixed str, djb2", hdjb, use_mask);
+            report_distribution("prefixed str, wyhash", hwy, use_mask);
+        }
+    }
+
+    // ---- 2. 吞吐 ----
+    std::printf("\nthroughput (GB/s)\n%8s %12s %12s %12s\n", "bytes", "h*31+c", "djb2", "wyhash");
+    {
+        const size_t kTotal = 256u << 20; // 每种长度总共哈希256MB
+        std::vector<unsigned char> buf(4096 + 64);
+        for (size_t i = 0; i < buf.size(); ++i) {
+            buf[i] = static_cast<unsigned char>(i * 131 + 7);
+        }
+        const size_t lens[] = {8, 16, 32, 64, 256, 1024, 4096};
+        for (size_t len : lens) {
+            size_t iters = kTotal / len;
+            double gbps[3];
+            for (int algo = 0; algo < 3; ++algo) {
+                size_t sink = 0;
+                auto start = std::chrono::steady_clock::now();
+                for (size_t it = 0; it < iters; ++it) {
+                    // 起始偏移随迭代变化，避免编译器把整个循环外提
+                    const char* p = reinterpret_cast<const char*>(buf.data()) + (it & 63);
+                    if (algo == 0) {
+                        sink += Mul31StringHash()(p, len);
+                    } else if (algo == 1) {
+                        sink += djb2(p, len);
+                    } else {
+                        sink += hash_bytes(p, len);
+                    }
+                }
+                double ms = elapsed_ms(start);
+                gbps[algo] = iters * static_cast<double>(len) / ms / 1e6;
+                if (sink == 42) {
+                    std::printf("unreachable\n");
+                }
+            }
+            std::printf("%8zu %12.2f %12.2f %12.2f\n", len, gbps[0], gbps[1], gbps[2]);
+        }
+    }
+
+    // ---- 3. 端到端（质数桶）：插入和查找都按打乱后的顺序，避免顺序键让恒等哈希白得缓存局部性 ----
+    std::printf("\nMyUnorderedMap insert + find (shuffled order), n = %d\n", n);
+    std::vector<int> order(n);
+    for (int i = 0; i < n; ++i) {
+        order[i] = i;
+    }
+    unsigned long long seed = 0x9E3779B97F4A7C15ULL;
+    for (int i = n - 1; i > 0; --i) {
+        seed ^= seed << 13;
+        seed ^= seed >> 7;
+        seed ^= seed << 17;
+        int j = static_cast<int>(seed % (i + 1));
+        int tmp = order[i];
+        order[i] = order[j];
+        order[j] = tmp;
+    }
+    {
+        auto run_int = [&](auto& map, const char* name) {
+            auto start = std::chrono::steady_clock::now();
+            for (int i : order) {
+                map.insert(i * 1024, i);
+            }
+            long long sum = 0;
+            for (int i = n - 1; i >= 0; --i) {
+                sum += *map.find(order[i] * 1024);
+            }
+            std::printf("  %-36s %8.1f ms  (sum %lld)\n", name, elapsed_ms(start), sum);
+        };
+        MyUnorderedMap<int, int, IdentityIntHash> old_map;
+        run_int(old_map, "int stride 1024, identity");
+        MyUnorderedMap<int, int> new_map;
+        run_int(new_map, "int stride 1024, fmix64");
+    }
+    {
+        std::vector<char> keys(static_cast<size_t>(n) * 32);
+        for (int i = 0; i < n; ++i) {
+            std::snprintf(&keys[static_cast<size_t>(i) * 32], 32, "order/2024/%08d", i);
+        }
+        auto run_str = [&](auto& map, const char* name) {
+            auto start = std::chrono::steady_clock::now();
+            for (int i : order) {
+                map.insert(&keys[static_cast<size_t>(i) * 32], i);
+            }
+            long long sum = 0;
+            for (int i = n - 1; i >= 0; --i) {
+                sum += *map.find(&keys[static_cast<size_t>(order[i]) * 32]);
+            }
+            std::printf("  %-36s %8.1f ms  (sum %lld)\n", name, elapsed_ms(start), sum);
+        };
+        MyUnorderedMap<char*, int, Mul31StringHash> old_map;
+        run_str(old_map, "prefixed str, h*31+c");
+        MyUnorderedMap<char*, int> new_map;
+        run_str(new_map, "prefixed str, wyhash");
+    }
+    return 0;
+}
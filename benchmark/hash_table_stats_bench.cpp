@@ -0,0 +1,142 @@
+// 健康度统计基准：MyUnorderedMap<int, int>
+// 1. 采样开销：每次find都要做一次采样计数器递减，单独测它每次调用的耗时，与一次命中查找的耗时对比
+// 2. 好/坏两种键分布下的stats()：默认哈希 vs 只保留低10位的哈希（所有键挤进1024个哈希值），
+//    坏分布下链长直方图集中在最后一格，平均探测长度飙升，一眼可以看出退化
+// 3. rehash时间线：一次性rehash与渐进式rehash（耗时为各步之和）各自的记录
+// 编译运行：g++ -O2 -std=c++17 benchmark/hash_table_stats_bench.cpp -o hash_table_stats_bench && ./hash_table_stats_bench [键个数]
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+#include "../container/std_unordered_map_withoutstl.cpp"
+
+// 坏哈希：只保留低10位
+struct LowBitsHash {
+    size_t operator()(int key) const {
+        return static_cast<size_t>(key) & 1023;
+    }
+};
+
+double elapsed_ms(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+uint64_t xorshift(uint64_t& state) {
+    state ^= state << 13;
+    state ^= state >> 7;
+    state ^= state << 17;
+    return state;
+}
+
+void print_stats(const char* name, const HashTableStats& s) {
+    std::printf("  %s\n", name);
+    std::printf("    size %zu  buckets %zu  load %.3f  empty %zu  max_chain %zu\n", s.size, s.bucket_count,
+                s.load_factor, s.empty_buckets, s.max_chain);
+    std::printf("    chain histogram (0..6, >=7):");
+    for (size_t i = 0; i < HashTableStats::kChainHistogram; ++i) {
+        std::printf(" %zu", s.chain_histogram[i]);
+    }
+    std::printf("\n    sampled finds %llu  avg probe %.2f  max probe %zu\n",
+                static_cast<unsigned long long>(s.sampled_finds), s.avg_probe, s.max_probe);
+    std::printf("    rehash count %llu  total %.3f ms  max %.3f ms\n", static_cast<unsigned long long>(s.rehash_count),
+                s.rehash_total_ns / 1e6, s.rehash_max_ns / 1e6);
+    for (size_t i = 0; i < s.rehash_history_count; ++i) {
+        const RehashEvent& e = s.rehash_history[i];
+        std::printf("      size %9llu  buckets %9llu -> %9llu  %8.3f ms\n", static_cast<unsigned long long>(e.size),
+                    static_cast<unsigned long long>(e.old_buckets), static_cast<unsigned long long>(e.new_buckets),
+                    e.duration_ns / 1e6);
+    }
+}
+
+template <typename Map>
+double lookup_ns(Map& map, const std::vector<int>& queries, long long& sum) {
+    auto start = std::chrono::steady_clock::now();
+    for (int q : queries) {
+        if (int* v = map.find(q)) {
+            sum += *v;
+        }
+    }
+    return elapsed_ms(start) * 1e6 / queries.size();
+}
+
+int main(int argc, char** argv) {
+    int n = argc > 1 ? std::atoi(argv[1]) : 200000;
+    uint64_t rng = 88172645463325252ULL;
+    std::vector<int> keys(n);
+    for (int i = 0; i < n; ++i) {
+        keys[i] = static_cast<int>(xorshift(rng) >> 33);
+    }
+    std::vector<int> queries(4 * static_cast<size_t>(n));
+    for (int& q : queries) {
+        q = keys[xorshift(rng) % n];
+    }
+    long long sum = 0;
+
+    std::printf("keys %d, queries %zu, sample interval %u\n", n, queries.size(), HashTableMonitor::kProbeSampleInterval);
+
+    // 1. 采样开销
+    {
+        MyUnorderedMap<int, int> map;
+        for (int i = 0; i < n; ++i) {
+            map.insert(keys[i], i);
+        }
+        double find_ns = lookup_ns(map, queries, sum);
+
+        HashTableMonitor monitor;
+        size_t sampled = 0;
+        auto start = std::chrono::steady_clock::now();
+        for (size_t i = 0; i < queries.size(); ++i) {
+            if (monitor.sample_find()) {
+                monitor.record_probe(static_cast<size_t>(queries[i]) & 3);
+                ++sampled;
+            }
+        }
+        double sample_ns = elapsed_ms(start) * 1e6 / queries.size();
+        std::printf("\n[sampling overhead]\n  find (hit)            %6.2f ns/op\n", find_ns);
+        std::printf("  sample_find+record    %6.2f ns/op  (%.1f%% of find, %zu sampled)\n", sample_ns,
+                    100.0 * sample_ns / find_ns, sampled);
+    }
+
+    // 2. 好/坏键分布
+    std::printf("\n[key distribution]\n");
+    {
+        MyUnorderedMap<int, int> good;
+        for (int i = 0; i < n; ++i) {
+            good.insert(keys[i], i);
+        }
+        double ns = lookup_ns(good, queries, sum);
+        std::printf("  default hash lookup   %8.2f ns/op\n", ns);
+        print_stats("default hash", good.stats());
+        std::printf("    json: %s\n", good.stats().to_json().c_str());
+    }
+    {
+        MyUnorderedMap<int, int, LowBitsHash> bad;
+        for (int i = 0; i < n; ++i) {
+            bad.insert(keys[i], i);
+        }
+        std::vector<int> few(queries.begin(), queries.begin() + queries.size() / 50); // 坏分布下查找很慢，只测一部分
+        double ns = lookup_ns(bad, few, sum);
+        std::printf("  low-10-bit hash lookup %7.2f ns/op\n", ns);
+        print_stats("low-10-bit hash", bad.stats());
+    }
+
+    // 3. rehash时间线
+    std::printf("\n[rehash timeline]\n");
+    for (int incremental = 0; incremental < 2; ++incremental) {
+        MyUnorderedMap<int, int> map;
+        map.incremental_rehash(incremental != 0);
+        auto start = std::chrono::steady_clock::now();
+        for (int i = 0; i < n; ++i) {
+            map.insert(keys[i], i);
+        }
+        for (int q : queries) {
+            sum += map.find(q) != nullptr; // 渐进式rehash在find中完成剩余迁移
+        }
+        double ms = elapsed_ms(start);
+        std::printf("  %s (insert+find %.1f ms)\n", incremental ? "incremental" : "one-shot", ms);
+        print_stats(incremental ? "incremental rehash" : "one-shot rehash", map.stats());
+    }
+
+    std::printf("\n(checksum %lld)\n", sum);
+    return 0;
+}
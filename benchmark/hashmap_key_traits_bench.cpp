@@ -0,0 +1,184 @@
+// MyHashMap键哈希/比较基准：按类型特征选择的默认哈希与相等比较 vs 原来的 逐字节h*31+c + memcmp
+// 键类型：int、uint64_t、32字节POD、64字节POD、std::string（8~32字节内容）、带填充字节的结构体
+// 每种键各测插入n个键、命中查找n次、不命中查找n次（ns/次），以及查找命中的个数：
+// - std::string按对象字节哈希/比较的是指针，内容相同的另一个对象查不到
+// - 带填充字节的结构体插入时填充是垃圾值、查询时是0，按字节比较同样查不到；新版本需要显式传入哈希函数
+// 注意：连续的int键在h*31+c下几乎是恒等哈希，顺序插入时依次落在相邻的桶里，缓存局部性反而比混合后的哈希好；
+// 大步长的uint64_t ID则会在少数余数上扎堆
+// 编译运行：g++ -O2 -std=c++17 benchmark/hashmap_key_traits_bench.cpp -o hashmap_key_traits_bench && ./hashmap_key_traits_bench [键个数]
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstddef>
+#include <cstring>
+#include <string>
+#include <vector>
+#include "../data_structure/hashmap/hashmapwithoutstl.cpp"
+
+// ---- 原来的实现：对象字节逐个h*31+c，memcmp比较 ----
+template <typename K>
+struct ByteLoopHash {
+    size_t operator()(const K& key) const {
+        size_t hashValue = 0;
+        const char* data = reinterpret_cast<const char*>(&key);
+        for (size_t i = 0; i < sizeof(K); ++i) {
+            hashValue = hashValue * 31 + data[i];
+        }
+        return hashValue;
+    }
+};
+
+template <typename K>
+struct MemcmpEqual {
+    bool operator()(const K& a, const K& b) const {
+        return memcmp(&a, &b, sizeof(K)) == 0;
+    }
+};
+
+struct Key32 {
+    uint64_t w[4];
+    bool operator==(const Key32& o) const {
+        return w[0] == o.w[0] && w[1] == o.w[1] && w[2] == o.w[2] && w[3] == o.w[3];
+    }
+};
+
+struct Key64 {
+    uint64_t w[8];
+};
+
+// char后面有3个填充字节，sizeof为8
+struct Padded {
+    char tag;
+    int id;
+    bool operator==(const Padded& o) const {
+        return tag == o.tag && id == o.id;
+    }
+};
+
+struct PaddedHash {
+    size_t operator()(const Padded& key) const {
+        return hash_finalize_mix((static_cast<size_t>(static_cast<unsigned char>(key.tag)) << 32) |
+                                 static_cast<unsigned int>(key.id));
+    }
+};
+
+double elapsed_ms(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+// 第i个键，不同的i得到不同的键；miss为true时生成一定不在表中的键
+template <typename K>
+K make_key(uint64_t i, bool miss);
+
+template <>
+int make_key<int>(uint64_t i, bool miss) {
+    return static_cast<int>(i * 2 + miss);
+}
+
+template <>
+uint64_t make_key<uint64_t>(uint64_t i, bool miss) {
+    return (i * 2 + miss) << 20; // 低位全0的大步长ID
+}
+
+template <>
+Key32 make_key<Key32>(uint64_t i, bool miss) {
+    return Key32{{i, miss, 0x1234, i * 7}};
+}
+
+template <>
+Key64 make_key<Key64>(uint64_t i, bool miss) {
+    Key64 k;
+    for (int j = 0; j < 8; ++j) {
+        k.w[j] = j == 7 ? i * 2 + miss : 0x1000 + j;
+    }
+    return k;
+}
+
+template <>
+std::string make_key<std::string>(uint64_t i, bool miss) {
+    std::string s = (miss ? "miss:" : "user:") + std::to_string(i);
+    s.resize(8 + i % 25, '#');
+    return s;
+}
+
+template <>
+Padded make_key<Padded>(uint64_t i, bool miss) {
+    Padded p;
+    memset(&p, 0, sizeof(p)); // 查询用的键填充为0
+    p.tag = static_cast<char>('a' + i % 26);
+    p.id = static_cast<int>(i * 2 + miss);
+    return p;
+}
+
+// 插入用的键：Padded的填充字节改成垃圾值（模拟栈上未初始化的结构体），其他类型与查询用的键相同
+template <typename K>
+void push_insert_key(std::vector<K>& keys, uint64_t i) {
+    keys.push_back(make_key<K>(i, false));
+    if constexpr (std::is_same<K, Padded>::value) {
+        unsigned char* raw = reinterpret_cast<unsigned char*>(&keys.back());
+        memset(raw + offsetof(Padded, tag) + 1, 0xA5, offsetof(Padded, id) - offsetof(Padded, tag) - 1);
+    }
+}
+
+template <typename K, typename Hash, typename Equal>
+void run(const char* type, const char* variant, const std::vector<K>& inserts, const std::vector<K>& hits,
+         const std::vector<K>& misses, long long& checksum) {
+    size_t n = inserts.size();
+    MyHashMap<K, int, Hash, Equal> map;
+    auto start = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < n; ++i) {
+        map.put(inserts[i], static_cast<int>(i));
+    }
+    double put_ns = elapsed_ms(start) * 1e6 / n;
+
+    start = std::chrono::steady_clock::now();
+    size_t found = 0;
+    int value = 0;
+    for (const K& k : hits) {
+        if (map.get(k, value)) {
+            ++found;
+            checksum += value;
+        }
+    }
+    double hit_ns = elapsed_ms(start) * 1e6 / n;
+
+    start = std::chrono::steady_clock::now();
+    for (const K& k : misses) {
+        found += map.containsKey(k) ? 1000000000 : 0; // 不命中查找不应找到任何键
+    }
+    double miss_ns = elapsed_ms(start) * 1e6 / n;
+    HashTableStats stats = map.stats();
+    std::printf("  %-10s %-20s %9.1f %9.1f %9.1f %10zu %9zu\n", type, variant, put_ns, hit_ns, miss_ns, found,
+                stats.max_chain);
+}
+
+template <typename K, typename NewHash = MyHashMapHash<K>>
+void compare(const char* type, size_t n, long long& checksum) {
+    std::vector<K> inserts, hits, misses;
+    inserts.reserve(n);
+    hits.reserve(n);
+    misses.reserve(n);
+    for (size_t i = 0; i < n; ++i) {
+        push_insert_key(inserts, i);
+        hits.push_back(make_key<K>(i, false)); // 内容相同、另行构造的对象
+        misses.push_back(make_key<K>(i, true));
+    }
+    run<K, ByteLoopHash<K>, MemcmpEqual<K>>(type, "byte loop + memcmp", inserts, hits, misses, checksum);
+    run<K, NewHash, MyHashMapEqual<K>>(type, "trait dispatch", inserts, hits, misses, checksum);
+}
+
+int main(int argc, char** argv) {
+    size_t n = argc > 1 ? static_cast<size_t>(std::atol(argv[1])) : 1000000;
+    long long checksum = 0;
+    std::printf("%zu keys per type\n", n);
+    std::printf("  %-10s %-20s %9s %9s %9s %10s %9s\n", "key", "hash / equal", "put ns", "hit ns", "miss ns", "found",
+                "max chain");
+    compare<int>("int", n, checksum);
+    compare<uint64_t>("uint64_t", n, checksum);
+    compare<Key32>("Key32", n, checksum);
+    compare<Key64>("Key64", n, checksum);
+    compare<std::string>("string", n, checksum);
+    compare<Padded, PaddedHash>("Padded", n, checksum); // 带填充，默认哈希不可用，传入按字段的哈希
+    std::printf("\n(checksum %lld)\n", checksum);
+    return 0;
+}
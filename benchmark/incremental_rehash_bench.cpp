@@ -0,0 +1,54 @@
+// 渐进式rehash基准：逐次记录MyUnorderedMap::insert的耗时，对比一次性rehash与渐进式rehash的p99/p999/最大延迟
+// 编译运行：g++ -O2 -std=c++17 benchmark/incremental_rehash_bench.cpp -o incremental_rehash_bench && ./incremental_rehash_bench [插入个数]
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include "../container/std_unordered_map_withoutstl.cpp"
+
+// 插入延迟分位数统计（单位ns）
+struct LatencyReport {
+    double p50;
+    double p99;
+    double p999;
+    double max;
+    double total_ms;
+};
+
+LatencyReport run_inserts(bool incremental, int n) {
+    MyUnorderedMap<int, int> map;
+    map.incremental_rehash(incremental);
+
+    long long* samples = static_cast<long long*>(std::malloc(n * sizeof(long long)));
+    auto begin = std::chrono::steady_clock::now();
+    for (int i = 0; i < n; ++i) {
+        auto t0 = std::chrono::steady_clock::now();
+        map.insert(i, i);
+        auto t1 = std::chrono::steady_clock::now();
+        samples[i] = std::chrono::duration_cast<std::chrono::nanoseconds>(t1 - t0).count();
+    }
+    auto finish = std::chrono::steady_clock::now();
+
+    std::sort(samples, samples + n);
+    LatencyReport report;
+    report.p50 = static_cast<double>(samples[n / 2]);
+    report.p99 = static_cast<double>(samples[static_cast<long long>(n * 0.99)]);
+    report.p999 = static_cast<double>(samples[static_cast<long long>(n * 0.999)]);
+    report.max = static_cast<double>(samples[n - 1]);
+    report.total_ms = std::chrono::duration<double, std::milli>(finish - begin).count();
+    std::free(samples);
+    return report;
+}
+
+void print_report(const char* name, const LatencyReport& r) {
+    std::printf("%-12s p50=%6.0fns  p99=%6.0fns  p999=%8.0fns  max=%12.0fns  total=%8.1fms\n",
+                name, r.p50, r.p99, r.p999, r.max, r.total_ms);
+}
+
+int main(int argc, char** argv) {
+    int n = argc > 1 ? std::atoi(argv[1]) : 10000000;
+    std::printf("MyUnorderedMap<int,int> insert latency, n = %d\n", n);
+    print_report("blocking", run_inserts(false, n));
+    print_report("incremental", run_inserts(true, n));
+    return 0;
+}
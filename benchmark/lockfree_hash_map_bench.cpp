@@ -0,0 +1,128 @@
+// 无锁读哈希表基准：一个后台写者持续更新/删除，读者线程数从1增加到N，
+// 比较"std::shared_mutex读写锁+MyUnorderedMap"与MyLockFreeHashMap的读吞吐
+// 编译运行：g++ -O2 -std=c++17 -pthread benchmark/lockfree_hash_map_bench.cpp -o lockfree_hash_map_bench && ./lockfree_hash_map_bench [最大读者数]
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <mutex>
+#include <shared_mutex>
+#include <thread>
+#include <vector>
+#include "../data_structure/lockfree_hash_map.cpp"
+
+const int kKeySpace = 1 << 18;
+const int kReadsPerThread = 2000000;
+const int kPinBatch = 256;
+
+// 对照组：读写锁保护的MyUnorderedMap（默认一次性rehash模式下find不修改结构，可共享读）
+struct SharedMutexMap {
+    struct Pin {}; // 读写锁版本无需进入纪元
+    std::shared_mutex mutex;
+    MyUnorderedMap<int, int> map;
+
+    bool find(int key, int& out, const Pin&) {
+        std::shared_lock<std::shared_mutex> lock(mutex);
+        int* v = map.find(key);
+        if (v) {
+            out = *v;
+        }
+        return v != nullptr;
+    }
+    void insert_or_assign(int key, int value) {
+        std::unique_lock<std::shared_mutex> lock(mutex);
+        map.insert(key, value);
+    }
+    void erase(int key) {
+        std::unique_lock<std::shared_mutex> lock(mutex);
+        map.erase(key);
+    }
+};
+
+struct LockFreeMap {
+    using Pin = EpochGuard; // 读者每批查找进入一次纪元临界区，批内的find复用它，不再执行内存屏障
+    MyLockFreeHashMap<int, int> map{kKeySpace};
+
+    bool find(int key, int& out, const Pin& pin) {
+        return map.find(key, out, pin);
+    }
+    void insert_or_assign(int key, int value) {
+        map.insert_or_assign(key, value);
+    }
+    void erase(int key) {
+        map.erase(key);
+    }
+};
+
+// 返回读者总吞吐（Mreads/s）
+template <typename MapT>
+double run(MapT& map, int readers) {
+    std::atomic<bool> stop{false};
+    // 后台写者：每轮更新一个键、删除并重新插入另一个键，再稍作停顿，模拟低频更新
+    std::thread writer([&]() {
+        unsigned long long seed = 0x2545F4914F6CDD1DULL;
+        while (!stop.load(std::memory_order_relaxed)) {
+            seed ^= seed << 13;
+            seed ^= seed >> 7;
+            seed ^= seed << 17;
+            int key = static_cast<int>(seed % kKeySpace);
+            map.insert_or_assign(key, key + 1);
+            map.erase(key ^ 1);
+            map.insert_or_assign(key ^ 1, key);
+            std::this_thread::sleep_for(std::chrono::microseconds(10));
+        }
+    });
+
+    std::vector<std::thread> workers;
+    auto start = std::chrono::steady_clock::now();
+    for (int t = 0; t < readers; ++t) {
+        workers.emplace_back([&map, t]() {
+            unsigned long long seed = 0x9E3779B97F4A7C15ULL * (t + 1);
+            long long hits = 0;
+            for (int i = 0; i < kReadsPerThread; i += kPinBatch) {
+                typename MapT::Pin pin;
+                for (int j = 0; j < kPinBatch; ++j) {
+                    seed ^= seed << 13;
+                    seed ^= seed >> 7;
+                    seed ^= seed << 17;
+                    int out;
+                    hits += map.find(static_cast<int>(seed % kKeySpace), out, pin);
+                }
+            }
+            if (hits < 0) {
+                std::printf("unreachable\n");
+            }
+        });
+    }
+    for (auto& w : workers) {
+        w.join();
+    }
+    auto end = std::chrono::steady_clock::now();
+    stop.store(true);
+    writer.join();
+    double sec = std::chrono::duration<double>(end - start).count();
+    return readers * static_cast<double>(kReadsPerThread) / sec / 1e6;
+}
+
+template <typename MapT>
+void prefill(MapT& map) {
+    for (int i = 0; i < kKeySpace; ++i) {
+        map.insert_or_assign(i, i);
+    }
+}
+
+int main(int argc, char** argv) {
+    int max_readers = argc > 1 ? std::atoi(argv[1]) : 32;
+    std::printf("keys=%d, reads/thread=%d, 1 background writer\n", kKeySpace, kReadsPerThread);
+    std::printf("%8s %18s %18s\n", "readers", "shared_mutex", "lock-free");
+    for (int readers = 1; readers <= max_readers; readers *= 2) {
+        SharedMutexMap locked;
+        LockFreeMap lockfree;
+        prefill(locked);
+        prefill(lockfree);
+        double a = run(locked, readers);
+        double b = run(lockfree, readers);
+        std::printf("%8d %12.2f Mr/s %12.2f Mr/s\n", readers, a, b);
+    }
+    return 0;
+}
@@ -0,0 +1,79 @@
+// 节点分配策略基准：统计全局operator new调用次数与吞吐，比较逐个new/delete与slab分配
+// 负载：插入n个元素 -> 删除一半 -> 再插入一半 -> clear，重复若干轮
+// 编译运行：g++ -O2 -std=c++17 benchmark/node_allocator_bench.cpp -o node_allocator_bench && ./node_allocator_bench [元素个数]
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+#include "../container/std_unordered_map_withoutstl.cpp"
+#include "../container/std_unordered_multimap_withoutstl.cpp"
+
+// 全局operator new计数（桶数组使用malloc/calloc，不计入；这里只观察节点分配）
+static size_t g_new_calls = 0;
+
+void* operator new(size_t size) {
+    ++g_new_calls;
+    void* p = std::malloc(size);
+    if (p == nullptr) {
+        throw std::bad_alloc();
+    }
+    return p;
+}
+
+void operator delete(void* p) noexcept {
+    std::free(p);
+}
+
+void operator delete(void* p, size_t) noexcept {
+    std::free(p);
+}
+
+const int kRounds = 5;
+
+template <template <typename> class Alloc>
+void bench_map(const char* name, int n) {
+    MyUnorderedMap<int, int, MyHash<int>, KeyEqual<int>, PrimeBucketPolicy, Alloc> map;
+    size_t calls_before = g_new_calls;
+    auto start = std::chrono::steady_clock::now();
+    for (int round = 0; round < kRounds; ++round) {
+        for (int i = 0; i < n; ++i) {
+            map.insert(i, i);
+        }
+        for (int i = 0; i < n; i += 2) {
+            map.erase(i);
+        }
+        for (int i = 0; i < n; i += 2) {
+            map.insert(i, -i);
+        }
+        map.clear();
+    }
+    auto end = std::chrono::steady_clock::now();
+    double ms = std::chrono::duration<double, std::milli>(end - start).count();
+    std::printf("MyUnorderedMap      %-10s new() calls=%-10zu %8.1f ms\n", name, g_new_calls - calls_before, ms);
+}
+
+template <template <typename> class Alloc>
+void bench_multimap(const char* name, int n) {
+    MyUnorderedMultimap<int, int, std::hash<int>, std::equal_to<int>, PrimeBucketPolicy, Alloc> map;
+    size_t calls_before = g_new_calls;
+    auto start = std::chrono::steady_clock::now();
+    for (int round = 0; round < kRounds; ++round) {
+        for (int i = 0; i < n; ++i) {
+            map.insert(i % (n / 4 + 1), i); // 每个键约4个值
+        }
+        map.clear();
+    }
+    auto end = std::chrono::steady_clock::now();
+    double ms = std::chrono::duration<double, std::milli>(end - start).count();
+    std::printf("MyUnorderedMultimap %-10s new() calls=%-10zu %8.1f ms\n", name, g_new_calls - calls_before, ms);
+}
+
+int main(int argc, char** argv) {
+    int n = argc > 1 ? std::atoi(argv[1]) : 1000000;
+    std::printf("n = %d, rounds = %d\n", n, kRounds);
+    bench_map<NewDeleteNodeAllocator>("new/delete", n);
+    bench_map<SlabNodeAllocator>("slab", n);
+    bench_multimap<NewDeleteNodeAllocator>("new/delete", n);
+    bench_multimap<SlabNodeAllocator>("slab", n);
+    return 0;
+}
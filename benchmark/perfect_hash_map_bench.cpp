@@ -0,0 +1,139 @@
+// 最小完美哈希表基准：同一批键值对分别放在MyUnorderedMap和mmap加载的MyPerfectHashMap中，
+// 比较构建/加载耗时、内存占用和随机查找速度（命中与不命中各测一次）
+// 编译运行：g++ -O2 -std=c++17 benchmark/perfect_hash_map_bench.cpp -o perfect_hash_map_bench && ./perfect_hash_map_bench [键个数]
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <vector>
+#include "../data_structure/perfect_hash_map.cpp"
+
+double elapsed_ms(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+unsigned long long next_rand(unsigned long long& seed) {
+    seed ^= seed << 13;
+    seed ^= seed >> 7;
+    seed ^= seed << 17;
+    return seed;
+}
+
+// MyUnorderedMap的大致内存：节点 + 桶数组（char*键另加StringArena中的字节）
+template <typename Map, typename Node>
+size_t live_map_bytes(const Map& map, size_t key_bytes) {
+    return map.size() * sizeof(Node) + map.bucket_count() * sizeof(void*) + key_bytes;
+}
+
+template <typename Lookup>
+double time_lookups(size_t count, Lookup lookup, long long& sum) {
+    auto start = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < count; ++i) {
+        sum += lookup(i);
+    }
+    return elapsed_ms(start) * 1e6 / count;
+}
+
+int main(int argc, char** argv) {
+    int n = argc > 1 ? std::atoi(argv[1]) : 2000000;
+    const size_t kLookups = 4000000;
+    unsigned long long seed = 0x9E3779B97F4A7C15ULL;
+
+    // ---- 整数键 ----
+    {
+        std::printf("int -> uint32, n = %d\n", n);
+        MyUnorderedMap<int, unsigned> map;
+        std::vector<int> keys(n);
+        for (int i = 0; i < n; ++i) {
+            keys[i] = static_cast<int>(next_rand(seed) >> 33); // 非负
+            map.insert(keys[i], static_cast<unsigned>(i));
+        }
+        const char* path = "/tmp/perfect_hash_int.mph";
+        auto start = std::chrono::steady_clock::now();
+        bool ok = build_perfect_hash_file(map, path);
+        double build_ms = elapsed_ms(start);
+
+        MyPerfectHashMap<int, unsigned> mph;
+        start = std::chrono::steady_clock::now();
+        ok = ok && mph.open(path);
+        double load_ms = elapsed_ms(start);
+        if (!ok) {
+            std::printf("  build/open failed\n");
+            return 1;
+        }
+
+        std::vector<int> hits(kLookups), misses(kLookups);
+        for (size_t i = 0; i < kLookups; ++i) {
+            hits[i] = keys[next_rand(seed) % n];
+            misses[i] = -static_cast<int>(next_rand(seed) >> 34) - 1; // 负数必然不在表中
+        }
+        long long sum_map = 0, sum_mph = 0, miss_sink = 0;
+        double map_hit = time_lookups(kLookups, [&](size_t i) { return *map.find(hits[i]); }, sum_map);
+        double mph_hit = time_lookups(kLookups, [&](size_t i) { return *mph.find(hits[i]); }, sum_mph);
+        double map_miss = time_lookups(kLookups, [&](size_t i) { return map.find(misses[i]) != nullptr; }, miss_sink);
+        double mph_miss = time_lookups(kLookups, [&](size_t i) { return mph.find(misses[i]) != nullptr; }, miss_sink);
+
+        std::printf("  build file %.1f ms, mmap open %.3f ms\n", build_ms, load_ms);
+        std::printf("  %-22s %10s %12s %12s\n", "", "memory MB", "hit ns", "miss ns");
+        std::printf("  %-22s %10.1f %12.1f %12.1f\n", "MyUnorderedMap",
+                    live_map_bytes<decltype(map), HashNode<int, unsigned>>(map, 0) / 1048576.0, map_hit, map_miss);
+        std::printf("  %-22s %10.1f %12.1f %12.1f\n", "MyPerfectHashMap", mph.file_size() / 1048576.0, mph_hit,
+                    mph_miss);
+        std::printf("  sums %s, false positives %lld\n", sum_map == sum_mph ? "match" : "DIFFER", miss_sink);
+    }
+
+    // ---- 字符串键 ----
+    {
+        std::printf("\nstring -> uint32, n = %d\n", n);
+        MyUnorderedMap<char*, unsigned> map;
+        std::vector<std::string> keys(n);
+        size_t key_bytes = 0;
+        for (int i = 0; i < n; ++i) {
+            keys[i] = "dict/entry/" + std::to_string(next_rand(seed) % 1000000000000ULL);
+            if (map.try_emplace(std::string_view(keys[i]), static_cast<unsigned>(i)).second) {
+                key_bytes += (sizeof(StringArena::StringHeader) + keys[i].size() + 1 + 7) & ~size_t(7);
+            }
+        }
+        const char* path = "/tmp/perfect_hash_str.mph";
+        auto start = std::chrono::steady_clock::now();
+        bool ok = build_perfect_hash_file(map, path);
+        double build_ms = elapsed_ms(start);
+
+        MyPerfectHashMap<char*, unsigned> mph;
+        start = std::chrono::steady_clock::now();
+        ok = ok && mph.open(path);
+        double load_ms = elapsed_ms(start);
+        if (!ok) {
+            std::printf("  build/open failed\n");
+            return 1;
+        }
+
+        std::vector<int> hits(kLookups);
+        std::vector<std::string> misses(1 << 16);
+        for (size_t i = 0; i < kLookups; ++i) {
+            hits[i] = static_cast<int>(next_rand(seed) % n);
+        }
+        for (auto& m : misses) {
+            m = "dict/missing/" + std::to_string(next_rand(seed) % 1000000000000ULL);
+        }
+        long long sum_map = 0, sum_mph = 0, miss_sink = 0;
+        double map_hit = time_lookups(kLookups, [&](size_t i) { return *map.find(std::string_view(keys[hits[i]])); },
+                                      sum_map);
+        double mph_hit = time_lookups(kLookups, [&](size_t i) { return *mph.find(std::string_view(keys[hits[i]])); },
+                                      sum_mph);
+        double map_miss = time_lookups(
+            kLookups, [&](size_t i) { return map.find(std::string_view(misses[i & 0xFFFF])) != nullptr; }, miss_sink);
+        double mph_miss = time_lookups(
+            kLookups, [&](size_t i) { return mph.find(std::string_view(misses[i & 0xFFFF])) != nullptr; }, miss_sink);
+
+        std::printf("  build file %.1f ms, mmap open %.3f ms\n", build_ms, load_ms);
+        std::printf("  %-22s %10s %12s %12s\n", "", "memory MB", "hit ns", "miss ns");
+        std::printf("  %-22s %10.1f %12.1f %12.1f\n", "MyUnorderedMap",
+                    live_map_bytes<decltype(map), HashNode<char*, unsigned>>(map, key_bytes) / 1048576.0, map_hit,
+                    map_miss);
+        std::printf("  %-22s %10.1f %12.1f %12.1f\n", "MyPerfectHashMap", mph.file_size() / 1048576.0, mph_hit,
+                    mph_miss);
+        std::printf("  sums %s, false positives %lld\n", sum_map == sum_mph ? "match" : "DIFFER", miss_sink);
+    }
+    return 0;
+}
@@ -0,0 +1,198 @@
+// 概率草图基准：误差 vs 内存、吞吐，对照用MyUnorderedMap<int, int>精确计数
+// 数据：n个事件，键在[0, 键个数)上服从Zipf分布（s = 1.1），插入顺序随机打乱
+// 1. 精确计数：MyUnorderedMap逐个++，内存按节点 + 桶数组估算
+// 2. HyperLogLog：p = 10 / 12 / 14 / 16，不同键个数的相对误差
+// 3. Count-Min：depth = 4，width = 2^10 ~ 2^16，全部键的平均高估量与最大高估量（以 总数 的比例计）
+// 4. Space-Saving：capacity = 100 / 1000 / 10000，真实前100个键的召回率与最大计数误差
+// 5. 合并：事件按4份切开，各自建草图、序列化、反序列化后合并，检查与整体建的结果是否一致，并计时
+// 编译运行：g++ -O2 -std=c++17 benchmark/probabilistic_sketch_bench.cpp -o probabilistic_sketch_bench && ./probabilistic_sketch_bench [事件数] [键个数]
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+#include "../data_structure/probabilistic_sketch.cpp"
+
+double elapsed_ms(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+uint64_t xorshift(uint64_t& state) {
+    state ^= state << 13;
+    state ^= state >> 7;
+    state ^= state << 17;
+    return state;
+}
+
+// 第i个键出现的次数正比于1/(i+1)^s，总数为n；返回打乱后的事件序列
+std::vector<int> zipf_keys(int n, int keys, double s, uint64_t& rng) {
+    std::vector<double> weight(keys);
+    double total = 0;
+    for (int i = 0; i < keys; ++i) {
+        weight[i] = 1.0 / std::pow(i + 1.0, s);
+        total += weight[i];
+    }
+    std::vector<int> seq;
+    seq.reserve(n);
+    for (int i = 0; i < keys && static_cast<int>(seq.size()) < n; ++i) {
+        int cnt = std::max(1, static_cast<int>(weight[i] / total * n));
+        for (int j = 0; j < cnt && static_cast<int>(seq.size()) < n; ++j) {
+            seq.push_back(i);
+        }
+    }
+    while (static_cast<int>(seq.size()) < n) {
+        seq.push_back(static_cast<int>(xorshift(rng) % keys));
+    }
+    for (size_t i = seq.size() - 1; i > 0; --i) {
+        std::swap(seq[i], seq[xorshift(rng) % (i + 1)]);
+    }
+    return seq;
+}
+
+const unsigned kPrecisions[] = {10, 12, 14, 16};
+const size_t kWidths[] = {1 << 10, 1 << 12, 1 << 14, 1 << 16};
+const size_t kCapacities[] = {100, 1000, 10000};
+const int kTopK = 100;
+const int kParts = 4;
+
+int main(int argc, char** argv) {
+    int n = argc > 1 ? std::atoi(argv[1]) : 10000000;
+    int key_count = argc > 2 ? std::atoi(argv[2]) : 1000000;
+    uint64_t rng = 88172645463325252ULL;
+    std::vector<int> events = zipf_keys(n, key_count, 1.1, rng);
+    std::printf("%d events over %d keys (zipf s = 1.1)\n", n, key_count);
+
+    // 1. 精确计数
+    MyUnorderedMap<int, int> exact;
+    auto start = std::chrono::steady_clock::now();
+    for (int k : events) {
+        ++exact[k];
+    }
+    double exact_ms = elapsed_ms(start);
+    size_t exact_bytes = exact.size() * sizeof(HashNode<int, int>) + exact.bucket_count() * sizeof(void*);
+    std::vector<std::pair<int, int>> truth; // (次数, 键)，按次数降序
+    exact.for_each([&truth](const int& k, const int& c) { truth.emplace_back(c, k); });
+    std::sort(truth.begin(), truth.end(), [](const std::pair<int, int>& a, const std::pair<int, int>& b) {
+        return a.first > b.first;
+    });
+    double distinct = static_cast<double>(exact.size());
+    std::printf("\n[exact MyUnorderedMap<int, int>] %.1f ns/event, %.2f MB, %zu distinct keys\n", exact_ms * 1e6 / n,
+                exact_bytes / 1048576.0, exact.size());
+
+    // 2. HyperLogLog
+    std::printf("\n[HyperLogLog]\n  %-6s %10s %10s %12s %12s\n", "p", "bytes", "ns/event", "estimate", "rel error");
+    for (unsigned p : kPrecisions) {
+        MyHyperLogLog<int> hll(p);
+        start = std::chrono::steady_clock::now();
+        for (int k : events) {
+            hll.add(k);
+        }
+        double ms = elapsed_ms(start);
+        double est = hll.estimate();
+        std::printf("  %-6u %10zu %10.2f %12.0f %11.3f%%\n", p, hll.memory_bytes(), ms * 1e6 / n, est,
+                    100.0 * (est - distinct) / distinct);
+    }
+
+    // 3. Count-Min
+    std::printf("\n[Count-Min depth 4]\n  %-8s %10s %10s %16s %16s\n", "width", "bytes", "ns/event", "mean over/N",
+                "max over/N");
+    for (size_t width : kWidths) {
+        MyCountMinSketch<int> cms(width, 4);
+        start = std::chrono::steady_clock::now();
+        for (int k : events) {
+            cms.add(k);
+        }
+        double ms = elapsed_ms(start);
+        double sum_over = 0;
+        uint64_t max_over = 0;
+        for (const auto& tc : truth) {
+            uint64_t over = cms.estimate(tc.second) - static_cast<uint64_t>(tc.first);
+            sum_over += static_cast<double>(over);
+            max_over = over > max_over ? over : max_over;
+        }
+        std::printf("  %-8zu %10zu %10.2f %15.6f%% %15.4f%%\n", width, cms.memory_bytes(), ms * 1e6 / n,
+                    100.0 * sum_over / truth.size() / n, 100.0 * max_over / n);
+    }
+
+    // 4. Space-Saving
+    std::printf("\n[Space-Saving]\n  %-8s %10s %10s %14s %16s\n", "capacity", "bytes", "ns/event", "top-100 recall",
+                "max error/N");
+    for (size_t capacity : kCapacities) {
+        MySpaceSaving<int> ss(capacity);
+        start = std::chrono::steady_clock::now();
+        for (int k : events) {
+            ss.add(k);
+        }
+        double ms = elapsed_ms(start);
+        MyVector<SpaceSavingCounter<int>> top = ss.top(kTopK);
+        int hit = 0;
+        uint64_t max_err = 0;
+        for (size_t i = 0; i < top.size(); ++i) {
+            int* real = exact.find(top[i].key);
+            uint64_t err = top[i].count - (real ? *real : 0);
+            max_err = err > max_err ? err : max_err;
+            for (int j = 0; j < kTopK && j < static_cast<int>(truth.size()); ++j) {
+                if (truth[j].second == top[i].key) {
+                    ++hit;
+                    break;
+                }
+            }
+        }
+        std::printf("  %-8zu %10zu %10.2f %13.0f%% %15.4f%%\n", capacity, ss.memory_bytes(), ms * 1e6 / n,
+                    100.0 * hit / kTopK, 100.0 * max_err / n);
+    }
+
+    // 5. 分片 + 序列化 + 合并
+    std::printf("\n[merge %d parts through serialize/deserialize]\n", kParts);
+    {
+        MyHyperLogLog<int> whole_hll(14), merged_hll(14);
+        MyCountMinSketch<int> whole_cms(1 << 14, 4), merged_cms(1 << 14, 4);
+        MySpaceSaving<int> whole_ss(1000), merged_ss(1000);
+        for (int k : events) {
+            whole_hll.add(k);
+            whole_cms.add(k);
+            whole_ss.add(k);
+        }
+        std::vector<MyVector<unsigned char>> hll_bytes(kParts), cms_bytes(kParts), ss_bytes(kParts);
+        for (int part = 0; part < kParts; ++part) {
+            MyHyperLogLog<int> hll(14);
+            MyCountMinSketch<int> cms(1 << 14, 4);
+            MySpaceSaving<int> ss(1000);
+            for (int i = part; i < n; i += kParts) {
+                hll.add(events[i]);
+                cms.add(events[i]);
+                ss.add(events[i]);
+            }
+            hll.serialize(hll_bytes[part]);
+            cms.serialize(cms_bytes[part]);
+            ss.serialize(ss_bytes[part]);
+        }
+        start = std::chrono::steady_clock::now();
+        bool ok = true;
+        for (int part = 0; part < kParts; ++part) {
+            MyHyperLogLog<int> hll;
+            MyCountMinSketch<int> cms;
+            MySpaceSaving<int> ss;
+            ok = ok && hll.deserialize(hll_bytes[part].data(), hll_bytes[part].size()) && merged_hll.merge(hll);
+            ok = ok && cms.deserialize(cms_bytes[part].data(), cms_bytes[part].size()) && merged_cms.merge(cms);
+            ok = ok && ss.deserialize(ss_bytes[part].data(), ss_bytes[part].size()) && merged_ss.merge(ss);
+        }
+        double merge_ms = elapsed_ms(start);
+        bool cms_same = true;
+        for (const auto& tc : truth) {
+            cms_same = cms_same && merged_cms.estimate(tc.second) == whole_cms.estimate(tc.second);
+        }
+        MyVector<SpaceSavingCounter<int>> whole_top = whole_ss.top(10), merged_top = merged_ss.top(10);
+        int same_top = 0;
+        for (size_t i = 0; i < whole_top.size() && i < merged_top.size(); ++i) {
+            same_top += whole_top[i].key == merged_top[i].key;
+        }
+        std::printf("  deserialize + merge %.2f ms, ok %d\n", merge_ms, ok);
+        std::printf("  HyperLogLog identical: %d (%.0f vs %.0f)\n", merged_hll.estimate() == whole_hll.estimate(),
+                    merged_hll.estimate(), whole_hll.estimate());
+        std::printf("  Count-Min identical on all keys: %d\n", cms_same);
+        std::printf("  Space-Saving top-10 same order: %d / 10\n", same_top);
+    }
+    return 0;
+}
@@ -0,0 +1,303 @@
+// 哈希容器快照save/load基准：重启时从快照恢复 vs 逐条重新插入
+// 1. MyUnorderedMap<int, int>：逐个insert重建、reserve + insert重建、save/load（内存流与文件描述符）
+// 2. MyUnorderedMap<char*, int>（键长8~64字节）：逐个insert重建、save/load（序列化器路径）
+// 3. MyUnorderedMultimap<int, int>（每个键约8个值）：逐个insert重建、save/load
+// 4. 损坏的快照：截断、头部虚报元素个数（重新算过头部校验和）、定长记录里的重复键，
+//    分别经内存流（长度已知）和管道（长度未知）加载，load都应返回false且容器原有内容不变
+// 每种恢复方式都抽查结果与原表一致，并报告快照大小和恢复后的rehash次数
+// （MyUnorderedMultiSet与MyUnorderedMap的节点类型同名，不能放进同一个翻译单元，这里不测）
+// 编译运行：g++ -O2 -std=c++17 benchmark/snapshot_bench.cpp -o snapshot_bench && ./snapshot_bench [元素个数] [快照文件路径]
+#include <chrono>
+#include <cstdio>
+#include <cstddef>
+#include <cstdlib>
+#include <cstring>
+#include <fcntl.h>
+#include <sstream>
+#include <string>
+#include <unistd.h>
+#include <vector>
+#include "../container/std_unordered_map_withoutstl.cpp"
+#include "../container/std_unordered_multimap_withoutstl.cpp"
+
+double elapsed_ms(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+uint64_t xorshift(uint64_t& state) {
+    state ^= state << 13;
+    state ^= state >> 7;
+    state ^= state << 17;
+    return state;
+}
+
+// 抽查：每隔97个键比较一次值
+template <typename Map, typename Keys>
+long long sample_checksum(Map& map, const Keys& keys) {
+    long long sum = 0;
+    for (size_t i = 0; i < keys.size(); i += 97) {
+        if (auto* v = map.find(keys[i])) {
+            sum += *v;
+        }
+    }
+    return sum + static_cast<long long>(map.size());
+}
+
+void print_row(const char* name, double ms, size_t n, unsigned long long rehashes, const char* check) {
+    std::printf("  %-28s %10.1f %10.1f %10llu %10s\n", name, ms, ms * 1e6 / n, rehashes, check);
+}
+
+// 写到文件再读回（含fsync之前的页缓存写入，不含冷缓存读盘）
+template <typename Map>
+bool save_file(const Map& map, const char* path) {
+    int fd = open(path, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (fd < 0) {
+        return false;
+    }
+    bool ok = map.save(fd);
+    return close(fd) == 0 && ok;
+}
+
+template <typename Map>
+bool load_file(Map& map, const char* path) {
+    int fd = open(path, O_RDONLY);
+    if (fd < 0) {
+        return false;
+    }
+    bool ok = map.load(fd);
+    close(fd);
+    return ok;
+}
+
+// 把快照头部的元素个数改成count，并重新计算头部校验和（校验和不带密钥，谁都能这样改）
+std::string forge_count(std::string bytes, uint64_t count) {
+    SnapshotHeader header;
+    memcpy(&header, bytes.data(), sizeof(header));
+    header.count = count;
+    header.checksum = hash_bytes(&header, offsetof(SnapshotHeader, checksum), kSnapshotSeed);
+    memcpy(&bytes[0], &header, sizeof(header));
+    return bytes;
+}
+
+// 把第一个数据块中第dst条定长记录的前n个字节改成第src条的，并重新计算块校验和
+std::string copy_record_prefix(std::string bytes, size_t record_bytes, size_t src, size_t dst, size_t n) {
+    size_t data = sizeof(SnapshotHeader) + sizeof(uint32_t);
+    uint32_t len;
+    memcpy(&len, &bytes[sizeof(SnapshotHeader)], sizeof(len));
+    memcpy(&bytes[data + dst * record_bytes], &bytes[data + src * record_bytes], n);
+    uint64_t checksum = hash_bytes(&bytes[data], len, kSnapshotSeed);
+    memcpy(&bytes[data + len], &checksum, sizeof(checksum));
+    return bytes;
+}
+
+// 经管道加载：长度未知，走按块预留的路径（快照要小于管道缓冲区）
+template <typename Map>
+bool load_pipe(Map& map, const std::string& bytes) {
+    int fds[2];
+    if (pipe(fds) != 0) {
+        return false;
+    }
+    bool written = write(fds[1], bytes.data(), bytes.size()) == static_cast<ssize_t>(bytes.size());
+    close(fds[1]);
+    bool ok = written && map.load(fds[0]);
+    close(fds[0]);
+    return ok;
+}
+
+// 对同一份损坏的快照分别用内存流和管道加载，都失败且fingerprint不变才算通过
+template <typename Map, typename Fingerprint>
+const char* reject_check(Map& map, const std::string& bytes, Fingerprint fingerprint) {
+    long long before = fingerprint(map);
+    std::istringstream in(bytes);
+    bool rejected = !map.load(in) && fingerprint(map) == before;
+    rejected = rejected && !load_pipe(map, bytes) && fingerprint(map) == before;
+    return rejected ? "rejected" : "ACCEPTED";
+}
+
+int main(int argc, char** argv) {
+    int n = argc > 1 ? std::atoi(argv[1]) : 5000000;
+    const char* path = argc > 2 ? argv[2] : "/tmp/snapshot_bench.bin";
+    uint64_t rng = 88172645463325252ULL;
+    std::printf("%d elements, snapshot file %s\n", n, path);
+    std::printf("  %-28s %10s %10s %10s %10s\n", "", "ms", "ns/elem", "rehashes", "check");
+
+    // 1. 定长键值：load走整块读 + 一次预留桶的快速路径
+    {
+        std::vector<int> keys(n);
+        for (int i = 0; i < n; ++i) {
+            keys[i] = static_cast<int>(xorshift(rng) >> 33);
+        }
+        std::printf("\n[MyUnorderedMap<int, int>]\n");
+        MyUnorderedMap<int, int> source;
+        auto start = std::chrono::steady_clock::now();
+        for (int i = 0; i < n; ++i) {
+            source.insert(keys[i], i);
+        }
+        print_row("rebuild by insert", elapsed_ms(start), n, source.stats().rehash_count, "ref");
+        long long expected = sample_checksum(source, keys);
+        {
+            MyUnorderedMap<int, int> map;
+            start = std::chrono::steady_clock::now();
+            map.reserve(keys.size());
+            for (int i = 0; i < n; ++i) {
+                map.insert(keys[i], i);
+            }
+            print_row("rebuild by reserve + insert", elapsed_ms(start), n, map.stats().rehash_count,
+                      sample_checksum(map, keys) == expected ? "ok" : "MISMATCH");
+        }
+        std::stringstream stream;
+        start = std::chrono::steady_clock::now();
+        bool ok = source.save(stream);
+        print_row("save to stringstream", elapsed_ms(start), n, 0, ok ? "ok" : "FAILED");
+        std::string bytes = stream.str();
+        {
+            MyUnorderedMap<int, int> map;
+            std::istringstream in(bytes);
+            start = std::chrono::steady_clock::now();
+            ok = map.load(in);
+            print_row("load from istringstream", elapsed_ms(start), n, map.stats().rehash_count,
+                      ok && sample_checksum(map, keys) == expected ? "ok" : "MISMATCH");
+        }
+        start = std::chrono::steady_clock::now();
+        ok = save_file(source, path);
+        print_row("save to fd", elapsed_ms(start), n, 0, ok ? "ok" : "FAILED");
+        {
+            MyUnorderedMap<int, int> map;
+            start = std::chrono::steady_clock::now();
+            ok = load_file(map, path);
+            print_row("load from fd", elapsed_ms(start), n, map.stats().rehash_count,
+                      ok && sample_checksum(map, keys) == expected ? "ok" : "MISMATCH");
+        }
+        {
+            std::string bad = bytes;
+            bad[bad.size() / 2] ^= 1;
+            MyUnorderedMap<int, int> map;
+            map.insert(-1, -1);
+            std::istringstream in(bad);
+            std::printf("  snapshot %.1f MB (%.1f bytes/elem), flipped bit rejected: %d\n", bytes.size() / 1048576.0,
+                        static_cast<double>(bytes.size()) / n, !map.load(in) && map.size() == 1);
+        }
+    }
+
+    // 2. 字符串键：键经序列化器写成 长度 + 字节，load复制进StringArena后正常插入
+    {
+        int m = n / 5;
+        std::vector<std::string> strings(m);
+        for (int i = 0; i < m; ++i) {
+            size_t len = 8 + xorshift(rng) % 57;
+            strings[i].resize(len);
+            for (size_t j = 0; j < len; ++j) {
+                strings[i][j] = static_cast<char>('a' + xorshift(rng) % 26);
+            }
+        }
+        std::vector<char*> keys(m);
+        for (int i = 0; i < m; ++i) {
+            keys[i] = &strings[i][0];
+        }
+        std::printf("\n[MyUnorderedMap<char*, int>, %d keys of 8~64 bytes]\n", m);
+        MyUnorderedMap<char*, int> source;
+        auto start = std::chrono::steady_clock::now();
+        for (int i = 0; i < m; ++i) {
+            source.insert(keys[i], i);
+        }
+        print_row("rebuild by insert", elapsed_ms(start), m, source.stats().rehash_count, "ref");
+        long long expected = sample_checksum(source, keys);
+        std::stringstream stream;
+        start = std::chrono::steady_clock::now();
+        bool ok = source.save(stream);
+        print_row("save to stringstream", elapsed_ms(start), m, 0, ok ? "ok" : "FAILED");
+        MyUnorderedMap<char*, int> map;
+        start = std::chrono::steady_clock::now();
+        ok = map.load(stream);
+        print_row("load from stringstream", elapsed_ms(start), m, map.stats().rehash_count,
+                  ok && sample_checksum(map, keys) == expected ? "ok" : "MISMATCH");
+    }
+
+    // 3. 多重映射：相同键的记录连续保存，加载时直接头插也保持相邻
+    {
+        std::printf("\n[MyUnorderedMultimap<int, int>, ~8 values per key]\n");
+        std::vector<int> keys(n);
+        for (int i = 0; i < n; ++i) {
+            keys[i] = static_cast<int>(xorshift(rng) % static_cast<uint64_t>(n / 8 + 1));
+        }
+        auto count_checksum = [&keys](MyUnorderedMultimap<int, int>& mm) {
+            long long sum = 0;
+            for (size_t i = 0; i < keys.size(); i += 97) {
+                sum += static_cast<long long>(mm.count(keys[i]));
+            }
+            return sum + static_cast<long long>(mm.size());
+        };
+        MyUnorderedMultimap<int, int> source;
+        auto start = std::chrono::steady_clock::now();
+        for (int i = 0; i < n; ++i) {
+            source.insert(keys[i], i);
+        }
+        print_row("rebuild by insert", elapsed_ms(start), n, 0, "ref");
+        long long expected = count_checksum(source);
+        std::stringstream stream;
+        start = std::chrono::steady_clock::now();
+        bool ok = source.save(stream);
+        print_row("save to stringstream", elapsed_ms(start), n, 0, ok ? "ok" : "FAILED");
+        MyUnorderedMultimap<int, int> mm;
+        start = std::chrono::steady_clock::now();
+        ok = mm.load(stream);
+        print_row("load from stringstream", elapsed_ms(start), n, 0,
+                  ok && count_checksum(mm) == expected ? "ok" : "MISMATCH");
+    }
+
+    // 4. 损坏的快照（小表，保证快照能整个放进管道缓冲区）
+    {
+        std::printf("\n[corrupt snapshots: load must fail and keep the old contents]\n");
+        const int small = 1000;
+        MyUnorderedMap<int, int> source;
+        MyUnorderedMultimap<int, int> multi_source;
+        for (int i = 0; i < small; ++i) {
+            source.insert(i * 7, i);
+            multi_source.insert(i % 100, i);
+        }
+        std::stringstream map_stream, multi_stream;
+        source.save(map_stream);
+        multi_source.save(multi_stream);
+        std::string map_bytes = map_stream.str();
+        std::string multi_bytes = multi_stream.str();
+
+        // 原有内容：几个与快照无关的键值
+        MyUnorderedMap<int, int> map;
+        MyUnorderedMultimap<int, int> mm;
+        for (int i = 0; i < 3; ++i) {
+            map.insert(-1 - i, i);
+            mm.insert(-1, i);
+        }
+        auto map_fingerprint = [](MyUnorderedMap<int, int>& m) {
+            int* v = m.find(-2);
+            return static_cast<long long>(m.size()) * 1000 + (v ? *v : -1);
+        };
+        auto multi_fingerprint = [](MyUnorderedMultimap<int, int>& m) {
+            return static_cast<long long>(m.size()) * 1000 + static_cast<long long>(m.count(-1));
+        };
+        const size_t record = 2 * sizeof(int);
+        std::printf("  %-40s %12s %12s\n", "", "map", "multimap");
+        std::printf("  %-40s %12s %12s\n", "truncated to half",
+                    reject_check(map, map_bytes.substr(0, map_bytes.size() / 2), map_fingerprint),
+                    reject_check(mm, multi_bytes.substr(0, multi_bytes.size() / 2), multi_fingerprint));
+        std::printf("  %-40s %12s %12s\n", "header only",
+                    reject_check(map, map_bytes.substr(0, sizeof(SnapshotHeader)), map_fingerprint),
+                    reject_check(mm, multi_bytes.substr(0, sizeof(SnapshotHeader)), multi_fingerprint));
+        std::printf("  %-40s %12s %12s\n", "count forged to 2^40 (checksum redone)",
+                    reject_check(map, forge_count(map_bytes, 1ULL << 40), map_fingerprint),
+                    reject_check(mm, forge_count(multi_bytes, 1ULL << 40), multi_fingerprint));
+        std::printf("  %-40s %12s %12s\n", "count forged to n + 1",
+                    reject_check(map, forge_count(map_bytes, small + 1), map_fingerprint),
+                    reject_check(mm, forge_count(multi_bytes, small + 1), multi_fingerprint));
+        std::printf("  %-40s %12s %12s\n", "duplicate key (checksum redone)",
+                    reject_check(map, copy_record_prefix(map_bytes, record, 0, 1, sizeof(int)), map_fingerprint),
+                    "n/a");
+        std::istringstream good_map(map_bytes), good_multi(multi_bytes);
+        bool ok = map.load(good_map) && map.size() == static_cast<size_t>(small) &&
+                  mm.load(good_multi) && mm.size() == static_cast<size_t>(small) && mm.count(5) == 10;
+        std::printf("  %-40s %12s\n", "intact snapshot still loads", ok ? "ok" : "FAILED");
+    }
+
+    unlink(path);
+    return 0;
+}
@@ -0,0 +1,99 @@
+// 稀疏表遍历基准：非空桶位图
+// 先插入n个元素把桶数撑大，再删到只剩少量元素（桶数不缩），然后完整遍历一遍（begin()到end()）
+// 对比：逐个检查桶指针的原做法——用一个同样大小、指向同一批元素的桶指针数组模拟
+// 分别测MyUnorderedMultiSet<int>与MyUnorderedMultimap<int, int>
+// 编译运行：g++ -O2 -std=c++17 benchmark/sparse_iteration_bench.cpp -o sparse_iteration_bench && ./sparse_iteration_bench [元素个数]
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+#include "../container/std_unordered_multiset_withoutstl_completeversion.cpp"
+#include "../container/std_unordered_multimap_withoutstl.cpp"
+
+double elapsed_ms(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+// 原做法：从头到尾逐个检查桶指针，非空时读取元素
+double linear_scan_us(const std::vector<const int*>& buckets, long long& sum) {
+    auto start = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < buckets.size(); ++i) {
+        if (buckets[i]) {
+            sum += *buckets[i];
+        }
+    }
+    return elapsed_ms(start) * 1e3;
+}
+
+const int kKeep[] = {1000000, 10000, 100}; // 删到只剩这么多个元素
+
+int main(int argc, char** argv) {
+    int n = argc > 1 ? std::atoi(argv[1]) : 4000000;
+    long long checksum = 0;
+
+    std::printf("[MyUnorderedMultiSet<int>] %d inserted\n", n);
+    for (int keep : kKeep) {
+        if (keep > n) {
+            continue;
+        }
+        MyUnorderedMultiSet<int> set;
+        for (int i = 0; i < n; ++i) {
+            set.insert(i);
+        }
+        int stride = n / keep;
+        for (int i = 0; i < n; ++i) {
+            if (i % stride != 0) {
+                set.erase(i);
+            }
+        }
+        auto start = std::chrono::steady_clock::now();
+        size_t visited = 0;
+        for (auto it = set.begin(); it != set.end(); ++it) {
+            checksum += *it;
+            ++visited;
+        }
+        double bitmap_us = elapsed_ms(start) * 1e3;
+
+        // 模拟的桶数组指向表中的真实元素（按遍历顺序均匀摆放），两种做法读取的元素内存相同
+        std::vector<const int*> buckets(set.bucket_count(), nullptr);
+        size_t slot = 0;
+        for (auto it = set.begin(); it != set.end(); ++it, ++slot) {
+            buckets[slot * (buckets.size() / visited)] = &*it;
+        }
+        long long scanned = 0;
+        double scan_us = linear_scan_us(buckets, scanned);
+        std::printf("  %8zu elements / %9zu buckets (fill %.4f%%): bitmap iterate %10.1f us   linear bucket scan %10.1f us\n",
+                    visited, set.bucket_count(), 100.0 * visited / set.bucket_count(), bitmap_us, scan_us);
+        checksum += scanned;
+    }
+
+    std::printf("\n[MyUnorderedMultimap<int, int>] %d inserted\n", n);
+    for (int keep : kKeep) {
+        if (keep > n) {
+            continue;
+        }
+        MyUnorderedMultimap<int, int> map;
+        for (int i = 0; i < n; ++i) {
+            map.insert(i, i);
+        }
+        int stride = n / keep;
+        for (auto it = map.begin(); it != map.end();) {
+            if (it->first % stride != 0) {
+                it = map.erase(it);
+            } else {
+                ++it;
+            }
+        }
+        auto start = std::chrono::steady_clock::now();
+        size_t visited = 0;
+        for (auto it = map.begin(); it != map.end(); ++it) {
+            checksum += it->second;
+            ++visited;
+        }
+        double bitmap_us = elapsed_ms(start) * 1e3;
+        std::printf("  %8zu elements: bitmap iterate %10.1f us\n", visited, bitmap_us);
+    }
+
+    std::printf("\n(checksum %lld)\n", checksum);
+    return 0;
+}
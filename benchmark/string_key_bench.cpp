@@ -0,0 +1,109 @@
+// char*键基准：
+// 1. 插入：StringArena连续存放键 vs 旧做法（每个键my_strdup一次、析构时free）
+// 2. 查找：从带长度前缀、不以'\0'结尾的缓冲区查找，find(ptr, len)免拷贝 vs 先拷贝成临时C字符串再find
+// 编译运行：g++ -O2 -std=c++17 benchmark/string_key_bench.cpp -o string_key_bench && ./string_key_bench [键个数]
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include "../container/std_unordered_map_withoutstl.cpp"
+
+// 模拟旧版HashNode<char*, Value>：构造时my_strdup、析构时free
+struct OwnedKey {
+    char* str;
+
+    OwnedKey(const char* s) : str(my_strdup(s)) {}
+    OwnedKey(const OwnedKey& other) : str(my_strdup(other.str)) {}
+    OwnedKey& operator=(const OwnedKey&) = delete;
+    ~OwnedKey() {
+        free(str);
+    }
+};
+
+template <>
+struct MyHash<OwnedKey> {
+    size_t operator()(const OwnedKey& key) const {
+        return MyHash<char*>()(key.str);
+    }
+};
+
+template <>
+struct KeyEqual<OwnedKey> {
+    bool operator()(const OwnedKey& a, const OwnedKey& b) const {
+        return my_strcmp(a.str, b.str) == 0;
+    }
+};
+
+double elapsed_ms(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+int main(int argc, char** argv) {
+    int n = argc > 1 ? std::atoi(argv[1]) : 1000000;
+    const int kKeyLen = 32;
+
+    // 所有键放在一块带长度前缀的缓冲区里：[len][bytes]...，键之间不以'\0'分隔
+    char* wire = static_cast<char*>(malloc(static_cast<size_t>(n) * (kKeyLen + 1)));
+    for (int i = 0; i < n; ++i) {
+        char* rec = wire + static_cast<size_t>(i) * (kKeyLen + 1);
+        rec[0] = static_cast<char>(kKeyLen);
+        char tmp[64];
+        std::snprintf(tmp, sizeof(tmp), "user/session/%019d", i);
+        memcpy(rec + 1, tmp, kKeyLen);
+    }
+    auto key_at = [&](int i) { return wire + static_cast<size_t>(i) * (kKeyLen + 1) + 1; };
+
+    std::printf("n = %d, key length = %d\n", n, kKeyLen);
+
+    // ---- 旧做法：每个键单独分配 ----
+    {
+        MyUnorderedMap<OwnedKey, int> map;
+        char tmp[64];
+        auto start = std::chrono::steady_clock::now();
+        for (int i = 0; i < n; ++i) {
+            memcpy(tmp, key_at(i), kKeyLen);
+            tmp[kKeyLen] = '\0';
+            map.insert(OwnedKey(tmp), i);
+        }
+        double insert_ms = elapsed_ms(start);
+
+        long long sum = 0;
+        start = std::chrono::steady_clock::now();
+        for (int i = 0; i < n; ++i) {
+            memcpy(tmp, key_at(i), kKeyLen); // 查找前必须先造一个以'\0'结尾的临时键
+            tmp[kKeyLen] = '\0';
+            sum += *map.find(OwnedKey(tmp));
+        }
+        double find_ms = elapsed_ms(start);
+        start = std::chrono::steady_clock::now();
+        map.clear();
+        double clear_ms = elapsed_ms(start);
+        std::printf("strdup per key : insert %8.1f ms  find %8.1f ms  clear %7.1f ms  (sum %lld)\n",
+                    insert_ms, find_ms, clear_ms, sum);
+    }
+
+    // ---- StringArena + 免拷贝查找 ----
+    {
+        MyUnorderedMap<char*, int> map;
+        auto start = std::chrono::steady_clock::now();
+        for (int i = 0; i < n; ++i) {
+            map.insert(std::string_view(key_at(i), kKeyLen), i);
+        }
+        double insert_ms = elapsed_ms(start);
+
+        long long sum = 0;
+        start = std::chrono::steady_clock::now();
+        for (int i = 0; i < n; ++i) {
+            sum += *map.find(key_at(i), kKeyLen);
+        }
+        double find_ms = elapsed_ms(start);
+        start = std::chrono::steady_clock::now();
+        map.clear();
+        double clear_ms = elapsed_ms(start);
+        std::printf("string arena   : insert %8.1f ms  find %8.1f ms  clear %7.1f ms  (sum %lld)\n",
+                    insert_ms, find_ms, clear_ms, sum);
+    }
+
+    free(wire);
+    return 0;
+}
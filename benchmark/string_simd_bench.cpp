@@ -0,0 +1,151 @@
+// 字符串基本操作基准：原来的逐字节循环 vs string_simd.h vs C库（glibc的strlen/strcmp本身就是手写SIMD）
+// 键长8 ~ 4096字节，每种长度准备256个随机起始对齐的字符串，反复处理到总共约256MB
+// 1. 长度：my_strlen旧版循环 / simd_strlen / strlen（GB/s）
+// 2. 相等：DefaultEqual<const char*>旧版循环 / simd_strequal / strcmp == 0，两边内容相同（必须扫到结尾，最坏情况）
+// 3. 比较：my_strcmp旧版循环 / simd_strcmp / strcmp，只在最后一个字节不同
+// 4. 复制：my_strdup旧版（逐字节复制）/ simd_strdup / strdup
+// 编译运行：g++ -O2 -std=c++17 benchmark/string_simd_bench.cpp -o string_simd_bench && ./string_simd_bench
+// （默认SSE2一次16字节；加-mavx2一次32字节）
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+#include "../container/string_simd.h"
+
+// ---- 原来的逐字节实现（禁止编译器把循环识别成库函数调用） ----
+#if defined(__GNUC__) && !defined(__clang__)
+#define BYTE_LOOP __attribute__((noinline, optimize("no-tree-loop-distribute-patterns")))
+#else
+#define BYTE_LOOP __attribute__((noinline))
+#endif
+
+BYTE_LOOP size_t byte_strlen(const char* str) {
+    size_t len = 0;
+    while (str[len] != '\0') {
+        len++;
+    }
+    return len;
+}
+
+BYTE_LOOP bool byte_strequal(const char* a, const char* b) {
+    while (*a && *b && *a == *b) {
+        ++a;
+        ++b;
+    }
+    return *a == *b;
+}
+
+BYTE_LOOP int byte_strcmp(const char* str1, const char* str2) {
+    size_t i = 0;
+    while (str1[i] != '\0' && str2[i] != '\0') {
+        if (str1[i] != str2[i]) {
+            return (unsigned char)str1[i] - (unsigned char)str2[i];
+        }
+        i++;
+    }
+    return (unsigned char)str1[i] - (unsigned char)str2[i];
+}
+
+BYTE_LOOP char* byte_strdup(const char* str) {
+    size_t len = byte_strlen(str);
+    char* new_str = (char*)malloc(len + 1);
+    for (size_t i = 0; i <= len; ++i) {
+        new_str[i] = str[i];
+    }
+    return new_str;
+}
+
+double elapsed_ms(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+uint64_t xorshift(uint64_t& state) {
+    state ^= state << 13;
+    state ^= state >> 7;
+    state ^= state << 17;
+    return state;
+}
+
+const size_t kLengths[] = {8, 16, 32, 64, 128, 256, 512, 1024, 2048, 4096};
+const size_t kStrings = 256;
+const double kTotalBytes = 256.0 * 1024 * 1024;
+
+// 对每个字符串（或字符串对）执行op，重复rounds轮，返回GB/s
+template <typename Op>
+double throughput(size_t len, size_t rounds, Op op) {
+    auto start = std::chrono::steady_clock::now();
+    for (size_t r = 0; r < rounds; ++r) {
+        for (size_t i = 0; i < kStrings; ++i) {
+            op(i);
+        }
+    }
+    double ms = elapsed_ms(start);
+    return static_cast<double>(len) * kStrings * rounds / (ms * 1e6);
+}
+
+int main() {
+    uint64_t rng = 88172645463325252ULL;
+    long long checksum = 0;
+    std::printf("vector width %d bytes, throughput in GB/s\n", STRING_SIMD_WIDTH);
+    std::printf("  %-6s | %7s %7s %7s | %7s %7s %7s | %7s %7s %7s | %7s %7s %7s\n", "len", "loop", "simd", "libc",
+                "loop", "simd", "libc", "loop", "simd", "libc", "loop", "simd", "libc");
+    std::printf("  %-6s | %23s | %23s | %23s | %23s\n", "", "strlen", "equal", "strcmp", "strdup");
+    for (size_t len : kLengths) {
+        // 每个字符串单独分配，起始位置随机错开0~63字节，a[i]与b[i]内容相同、c[i]只有最后一个字节不同
+        std::vector<char*> blocks, a(kStrings), b(kStrings), c(kStrings);
+        for (size_t i = 0; i < kStrings; ++i) {
+            char* pa = static_cast<char*>(malloc(len + 128));
+            char* pb = static_cast<char*>(malloc(len + 128));
+            char* pc = static_cast<char*>(malloc(len + 128));
+            blocks.push_back(pa);
+            blocks.push_back(pb);
+            blocks.push_back(pc);
+            a[i] = pa + xorshift(rng) % 64;
+            b[i] = pb + xorshift(rng) % 64;
+            c[i] = pc + xorshift(rng) % 64;
+            for (size_t j = 0; j < len; ++j) {
+                a[i][j] = static_cast<char>('!' + xorshift(rng) % 90);
+            }
+            a[i][len] = '\0';
+            memcpy(b[i], a[i], len + 1);
+            memcpy(c[i], a[i], len + 1);
+            c[i][len - 1] = static_cast<char>(c[i][len - 1] + 1);
+        }
+        size_t rounds = static_cast<size_t>(kTotalBytes / (static_cast<double>(len) * kStrings));
+        size_t dup_rounds = rounds / 8 + 1; // 复制要分配内存，轮数少一些
+
+        double len_loop = throughput(len, rounds, [&](size_t i) { checksum += byte_strlen(a[i]); });
+        double len_simd = throughput(len, rounds, [&](size_t i) { checksum += simd_strlen(a[i]); });
+        double len_libc = throughput(len, rounds, [&](size_t i) { checksum += strlen(a[i]); });
+        double eq_loop = throughput(len, rounds, [&](size_t i) { checksum += byte_strequal(a[i], b[i]); });
+        double eq_simd = throughput(len, rounds, [&](size_t i) { checksum += simd_strequal(a[i], b[i]); });
+        double eq_libc = throughput(len, rounds, [&](size_t i) { checksum += strcmp(a[i], b[i]) == 0; });
+        double cmp_loop = throughput(len, rounds, [&](size_t i) { checksum += byte_strcmp(a[i], c[i]) < 0; });
+        double cmp_simd = throughput(len, rounds, [&](size_t i) { checksum += simd_strcmp(a[i], c[i]) < 0; });
+        double cmp_libc = throughput(len, rounds, [&](size_t i) { checksum += strcmp(a[i], c[i]) < 0; });
+        double dup_loop = throughput(len, dup_rounds, [&](size_t i) {
+            char* s = byte_strdup(a[i]);
+            checksum += s[0];
+            free(s);
+        });
+        double dup_simd = throughput(len, dup_rounds, [&](size_t i) {
+            char* s = simd_strdup(a[i]);
+            checksum += s[0];
+            free(s);
+        });
+        double dup_libc = throughput(len, dup_rounds, [&](size_t i) {
+            char* s = strdup(a[i]);
+            checksum += s[0];
+            free(s);
+        });
+        std::printf("  %-6zu | %7.2f %7.2f %7.2f | %7.2f %7.2f %7.2f | %7.2f %7.2f %7.2f | %7.2f %7.2f %7.2f\n", len,
+                    len_loop, len_simd, len_libc, eq_loop, eq_simd, eq_libc, cmp_loop, cmp_simd, cmp_libc, dup_loop,
+                    dup_simd, dup_libc);
+        for (char* p : blocks) {
+            free(p);
+        }
+    }
+    std::printf("\n(checksum %lld)\n", checksum);
+    return 0;
+}
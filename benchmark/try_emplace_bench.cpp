@@ -0,0 +1,118 @@
+// 计数器负载基准：counts[key]++
+// 旧operator[]：find -> (不存在时) insert再走一遍链表 -> find第三次探测
+// 新operator[]：基于try_emplace，哈希一次、走链一次、值原地构造
+// 另测insert_or_assign覆盖写，以及只能移动的值（unique_ptr）用try_emplace建表
+// 编译运行：g++ -O2 -std=c++17 benchmark/try_emplace_bench.cpp -o try_emplace_bench && ./try_emplace_bench [操作次数]
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <vector>
+#include "../container/std_unordered_map_withoutstl.cpp"
+
+double elapsed_ms(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+// 改造前operator[]的做法
+template <typename Map, typename Key>
+int& legacy_subscript(Map& map, const Key& key) {
+    int* val = map.find(key);
+    if (val) {
+        return *val;
+    }
+    map.insert(key, int());
+    return *map.find(key);
+}
+
+int main(int argc, char** argv) {
+    int ops = argc > 1 ? std::atoi(argv[1]) : 5000000;
+
+    // 键分布：一半操作落在1000个热键上，另一半均匀分布在100万个键上（大量首次出现的键）
+    std::vector<int> keys(ops);
+    unsigned long long seed = 0x9E3779B97F4A7C15ULL;
+    for (int i = 0; i < ops; ++i) {
+        seed ^= seed << 13;
+        seed ^= seed >> 7;
+        seed ^= seed << 17;
+        keys[i] = (seed & 1) ? static_cast<int>((seed >> 1) % 1000) : static_cast<int>((seed >> 1) % 1000000);
+    }
+    std::printf("ops = %d\n", ops);
+
+    {
+        MyUnorderedMap<int, int> counts;
+        auto start = std::chrono::steady_clock::now();
+        for (int key : keys) {
+            legacy_subscript(counts, key)++;
+        }
+        std::printf("  %-32s %8.1f ms  (distinct %zu, counts[7] = %d)\n", "legacy find+insert+find",
+                    elapsed_ms(start), counts.size(), *counts.find(7));
+    }
+    {
+        MyUnorderedMap<int, int> counts;
+        auto start = std::chrono::steady_clock::now();
+        for (int key : keys) {
+            counts[key]++;
+        }
+        std::printf("  %-32s %8.1f ms  (distinct %zu, counts[7] = %d)\n", "operator[] (try_emplace)",
+                    elapsed_ms(start), counts.size(), counts[7]);
+    }
+
+    // 全是首次出现的键：旧做法每个键都要探测三次
+    {
+        MyUnorderedMap<int, int> counts;
+        auto start = std::chrono::steady_clock::now();
+        for (int i = 0; i < ops; ++i) {
+            legacy_subscript(counts, i * 7)++;
+        }
+        std::printf("  %-32s %8.1f ms  (distinct %zu)\n", "all-new keys, legacy", elapsed_ms(start), counts.size());
+    }
+    {
+        MyUnorderedMap<int, int> counts;
+        auto start = std::chrono::steady_clock::now();
+        for (int i = 0; i < ops; ++i) {
+            counts[i * 7]++;
+        }
+        std::printf("  %-32s %8.1f ms  (distinct %zu)\n", "all-new keys, operator[]", elapsed_ms(start), counts.size());
+    }
+
+    // char*键：旧做法每次探测都要my_strlen + 哈希整串，三次探测代价更明显
+    std::vector<char> words(static_cast<size_t>(ops) * 16);
+    for (int i = 0; i < ops; ++i) {
+        std::snprintf(&words[static_cast<size_t>(i) * 16], 16, "word%07d", keys[i]);
+    }
+    {
+        MyUnorderedMap<char*, int> counts;
+        auto start = std::chrono::steady_clock::now();
+        for (int i = 0; i < ops; ++i) {
+            legacy_subscript(counts, &words[static_cast<size_t>(i) * 16])++;
+        }
+        std::printf("  %-32s %8.1f ms  (distinct %zu)\n", "char* legacy find+insert+find", elapsed_ms(start),
+                    counts.size());
+    }
+    {
+        MyUnorderedMap<char*, int> counts;
+        auto start = std::chrono::steady_clock::now();
+        for (int i = 0; i < ops; ++i) {
+            counts[&words[static_cast<size_t>(i) * 16]]++;
+        }
+        std::printf("  %-32s %8.1f ms  (distinct %zu)\n", "char* operator[] (try_emplace)", elapsed_ms(start),
+                    counts.size());
+    }
+
+    // 只能移动的值：旧接口insert(const Value&)无法使用，这里用try_emplace原地构造
+    {
+        MyUnorderedMap<int, std::unique_ptr<long long>> boxes;
+        auto start = std::chrono::steady_clock::now();
+        for (int key : keys) {
+            auto result = boxes.try_emplace(key, nullptr);
+            if (result.second) {
+                *result.first = std::make_unique<long long>(0);
+            }
+            ++**result.first;
+        }
+        std::printf("  %-32s %8.1f ms  (distinct %zu)\n", "unique_ptr values (try_emplace)", elapsed_ms(start),
+                    boxes.size());
+    }
+    return 0;
+}
@@ -0,0 +1,147 @@
+#ifndef BUCKET_BITMAP_H
+#define BUCKET_BITMAP_H
+
+#include <cstddef> // size_t
+#include <cstdint> // uint64_t
+#include <cstdlib> // calloc、free
+
+// ------- 非空桶位图 ------- //
+// 链式哈希容器每个桶对应一位，桶非空时置1。迭代器找下一个非空桶不再逐个检查桶指针，
+// 而是在64位字上用tzcnt（__builtin_ctzll）直接定位下一个1。
+// 两级结构：words_的第j个字非零时，summary_中第j位置1。跳过一个全空的summary字等于跳过64×64=4096个桶，
+// 1000万个桶、只剩100个元素的表完整遍历一遍只需扫约2500个summary字。
+// 维护代价：桶由空变非空、由非空变空时各改两个字，插入/删除的其他情况不碰位图。
+class BucketBitmap {
+public:
+    BucketBitmap() = default;
+
+    BucketBitmap(const BucketBitmap&) = delete;
+    BucketBitmap& operator=(const BucketBitmap&) = delete;
+
+    BucketBitmap(BucketBitmap&& other) noexcept
+        : words_(other.words_), summary_(other.summary_), bucket_count_(other.bucket_count_) {
+        other.words_ = nullptr;
+        other.summary_ = nullptr;
+        other.bucket_count_ = 0;
+    }
+
+    BucketBitmap& operator=(BucketBitmap&& other) noexcept {
+        if (this != &other) {
+            release();
+            words_ = other.words_;
+            summary_ = other.summary_;
+            bucket_count_ = other.bucket_count_;
+            other.words_ = nullptr;
+            other.summary_ = nullptr;
+            other.bucket_count_ = 0;
+        }
+        return *this;
+    }
+
+    ~BucketBitmap() {
+        release();
+    }
+
+    // 按新的桶数重新分配，所有位清零
+    void reset(size_t bucket_count) {
+        release();
+        bucket_count_ = bucket_count;
+        if (bucket_count == 0) {
+            return;
+        }
+        words_ = static_cast<uint64_t*>(calloc(word_count(), sizeof(uint64_t)));
+        summary_ = static_cast<uint64_t*>(calloc(summary_count(), sizeof(uint64_t)));
+    }
+
+    // 所有位清零，桶数不变
+    void clear_all() {
+        for (size_t j = 0; j < word_count(); ++j) {
+            words_[j] = 0;
+        }
+        for (size_t k = 0; k < summary_count(); ++k) {
+            summary_[k] = 0;
+        }
+    }
+
+    void set(size_t bucket) {
+        size_t j = bucket >> 6;
+        words_[j] |= uint64_t(1) << (bucket & 63);
+        summary_[j >> 6] |= uint64_t(1) << (j & 63);
+    }
+
+    void clear(size_t bucket) {
+        size_t j = bucket >> 6;
+        words_[j] &= ~(uint64_t(1) << (bucket & 63));
+        if (words_[j] == 0) {
+            summary_[j >> 6] &= ~(uint64_t(1) << (j & 63));
+        }
+    }
+
+    // 下标>=from的第一个非空桶，没有则返回桶数
+    size_t next(size_t from) const {
+        if (from >= bucket_count_) {
+            return bucket_count_;
+        }
+        size_t j = from >> 6;
+        uint64_t w = words_[j] & (~uint64_t(0) << (from & 63));
+        if (w) {
+            return (j << 6) + ctz(w);
+        }
+        // 当前字后面的部分为空：在summary中找下一个非零字
+        size_t next_word = j + 1;
+        size_t k = next_word >> 6;
+        if (k >= summary_count()) {
+            return bucket_count_;
+        }
+        uint64_t s = (next_word & 63) ? summary_[k] & (~uint64_t(0) << (next_word & 63)) : summary_[k];
+        while (s == 0) {
+            if (++k >= summary_count()) {
+                return bucket_count_;
+            }
+            s = summary_[k];
+        }
+        j = (k << 6) + ctz(s);
+        return (j << 6) + ctz(words_[j]);
+    }
+
+    // 第一个非空桶，没有则返回桶数
+    size_t first() const {
+        return next(0);
+    }
+
+private:
+    uint64_t* words_ = nullptr; // 每个桶一位
+    uint64_t* summary_ = nullptr; // words_的每个字一位（该字非零时置1）
+    size_t bucket_count_ = 0;
+
+    size_t word_count() const {
+        return (bucket_count_ + 63) >> 6;
+    }
+
+    size_t summary_count() const {
+        return (word_count() + 63) >> 6;
+    }
+
+    static unsigned ctz(uint64_t x) {
+#if defined(__GNUC__) || defined(__clang__)
+        return static_cast<unsigned>(__builtin_ctzll(x)); // 有BMI1时编译为tzcnt
+#else
+        unsigned n = 0;
+        while ((x & 1) == 0) {
+            x >>= 1;
+            ++n;
+        }
+        return n;
+#endif
+    }
+
+    void release() {
+        free(words_);
+        free(summary_);
+        words_ = nullptr;
+        summary_ = nullptr;
+        bucket_count_ = 0;
+    }
+};
+
+#endif // BUCKET_BITMAP_H
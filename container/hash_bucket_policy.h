@@ -0,0 +1,104 @@
+#ifndef HASH_BUCKET_POLICY_H
+#define HASH_BUCKET_POLICY_H
+
+#include <cstddef> // size_t
+#include "hash_function.h" // hash_finalize_mix
+
+// ------- 桶索引策略：把哈希值映射为桶下标 ------- //
+// 所有自制哈希容器都通过策略对象计算桶下标，避免每次查找都做一次运行期除法（hash % bucket_count）。
+// 策略接口约定：
+//   size_t reset(size_t min_buckets)  选定不小于min_buckets的桶数量并返回实际桶数
+//   size_t bucket_count() const        当前桶数量
+//   size_t index(size_t hash) const    哈希值 -> 桶下标
+
+// 策略一：桶数为2的幂，下标 = mix(hash) & (bucket_count - 1)
+// 默认哈希已经充分混合，但用户自定义的哈希可能是恒等映射，掩码取低位前仍再混合一次
+struct PowerOfTwoBucketPolicy {
+    size_t mask_ = 0;
+
+    size_t reset(size_t min_buckets) {
+        size_t n = 1;
+        while (n < min_buckets) {
+            n <<= 1;
+        }
+        mask_ = n - 1;
+        return n;
+    }
+
+    size_t bucket_count() const {
+        return mask_ + 1;
+    }
+
+    size_t index(size_t hash) const {
+        return hash_finalize_mix(hash) & mask_;
+    }
+};
+
+// 策略二：桶数取自预计算的质数表（每一项约为前一项的2倍）
+// index()按表下标switch到编译期常量取模，编译器会把每个分支的除法改写成乘法+移位
+struct PrimeBucketPolicy {
+    static constexpr size_t kPrimes[] = {
+        5ul, 11ul, 23ul, 53ul, 97ul, 193ul, 389ul, 769ul,
+        1543ul, 3079ul, 6151ul, 12289ul, 24593ul, 49157ul, 98317ul, 196613ul,
+        393241ul, 786433ul, 1572869ul, 3145739ul, 6291469ul, 12582917ul, 25165843ul, 50331653ul,
+        100663319ul, 201326611ul, 402653189ul, 805306457ul, 1610612741ul, 3221225473ul, 4294967291ul
+    };
+    static constexpr unsigned kPrimeCount = sizeof(kPrimes) / sizeof(kPrimes[0]);
+
+    unsigned prime_idx_ = 0;
+
+    size_t reset(size_t min_buckets) {
+        // 二分查找第一个 >= min_buckets 的质数，超出表范围时取最大项
+        unsigned lo = 0, hi = kPrimeCount - 1;
+        while (lo < hi) {
+            unsigned mid = (lo + hi) / 2;
+            if (kPrimes[mid] < min_buckets) {
+                lo = mid + 1;
+            } else {
+                hi = mid;
+            }
+        }
+        prime_idx_ = lo;
+        return kPrimes[prime_idx_];
+    }
+
+    size_t bucket_count() const {
+        return kPrimes[prime_idx_];
+    }
+
+    size_t index(size_t hash) const {
+        switch (prime_idx_) {
+#define PRIME_MOD_CASE(i) case i: return hash % kPrimes[i];
+            PRIME_MOD_CASE(0)  PRIME_MOD_CASE(1)  PRIME_MOD_CASE(2)  PRIME_MOD_CASE(3)
+            PRIME_MOD_CASE(4)  PRIME_MOD_CASE(5)  PRIME_MOD_CASE(6)  PRIME_MOD_CASE(7)
+            PRIME_MOD_CASE(8)  PRIME_MOD_CASE(9)  PRIME_MOD_CASE(10) PRIME_MOD_CASE(11)
+            PRIME_MOD_CASE(12) PRIME_MOD_CASE(13) PRIME_MOD_CASE(14) PRIME_MOD_CASE(15)
+            PRIME_MOD_CASE(16) PRIME_MOD_CASE(17) PRIME_MOD_CASE(18) PRIME_MOD_CASE(19)
+            PRIME_MOD_CASE(20) PRIME_MOD_CASE(21) PRIME_MOD_CASE(22) PRIME_MOD_CASE(23)
+            PRIME_MOD_CASE(24) PRIME_MOD_CASE(25) PRIME_MOD_CASE(26) PRIME_MOD_CASE(27)
+            PRIME_MOD_CASE(28) PRIME_MOD_CASE(29) PRIME_MOD_CASE(30)
+#undef PRIME_MOD_CASE
+            default: return hash % kPrimes[kPrimeCount - 1]; // reset()保证不会越界，仅为满足编译器
+        }
+    }
+};
+
+// 旧行为：运行期取模，桶数任意（保留用于对比基准）
+struct ModuloBucketPolicy {
+    size_t bucket_count_ = 1;
+
+    size_t reset(size_t min_buckets) {
+        bucket_count_ = min_buckets == 0 ? 1 : min_buckets;
+        return bucket_count_;
+    }
+
+    size_t bucket_count() const {
+        return bucket_count_;
+    }
+
+    size_t index(size_t hash) const {
+        return hash % bucket_count_;
+    }
+};
+
+#endif // HASH_BUCKET_POLICY_H
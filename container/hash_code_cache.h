@@ -0,0 +1,38 @@
+#ifndef HASH_CODE_CACHE_H
+#define HASH_CODE_CACHE_H
+
+#include <cstddef> // size_t
+
+// ------- 节点中缓存完整哈希值（可选） ------- //
+// 链式哈希容器的节点以CachedHashCode<CacheHash>为基类：
+// - CacheHash = true：节点多存一个size_t，插入时写入完整哈希值。
+//   rehash直接用它计算新桶下标，不再调用用户哈希（长字符串键省掉一遍扫描）；
+//   遍历链表时先比较哈希值，不相等的节点不再调用KeyEqual，也不必去读键本身（键在堆上时省一次缓存未命中）
+// - CacheHash = false：空基类，节点大小不变，hash_may_equal恒为true，行为与原来一致
+template <bool CacheHash>
+struct CachedHashCode {
+    static constexpr bool kCached = false;
+
+    void store_hash(size_t) {}
+
+    bool hash_may_equal(size_t) const {
+        return true;
+    }
+};
+
+template <>
+struct CachedHashCode<true> {
+    static constexpr bool kCached = true;
+
+    size_t hash_code = 0; // 完整哈希值（未经桶策略映射）
+
+    void store_hash(size_t hash) {
+        hash_code = hash;
+    }
+
+    bool hash_may_equal(size_t hash) const {
+        return hash_code == hash;
+    }
+};
+
+#endif // HASH_CODE_CACHE_H
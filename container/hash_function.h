@@ -0,0 +1,149 @@
+#ifndef HASH_FUNCTION_H
+#define HASH_FUNCTION_H
+
+#include <cstddef> // size_t
+#include <cstdint> // uint64_t
+#include <cstring> // memcpy、strlen
+
+// ------- 自制哈希容器共用的哈希函数 ------- //
+// 整数：hash_finalize_mix（murmur3的fmix64），每个输入位都会影响输出的每一位，
+//       连续ID、等步长ID也能均匀落入各个桶（恒等哈希下它们只会挤在少数桶/固定余数上）
+// 字节串：hash_bytes（wyhash算法），每步读8字节，长键按3路×16字节并行混合，
+//       短键（<=16字节）没有循环，只做两次64×64→128位乘法
+// 各容器的MyHash/DefaultHash特化都转调这里，保证同一个键在不同容器中的哈希值一致。
+// 默认使用这里的容器：MyUnorderedMap、MyUnordered（集合）、MyUnorderedMultiSet、MyUnorderedMultimap、
+//       HashTable（data_structure/hashmap_withoutstl.cpp）、
+//       MyHashMap / MyChainingHashMap（经data_structure/hashmap/hashmap_key_traits.h的MyHashMapHash）；
+//       MyLockFreeHashMap（复用MyUnorderedMap的MyHash）；*_withstl.cpp系列仍沿用std::hash，与它们包装的标准容器保持一致。
+
+// 哈希终结混合（murmur3的fmix64），让低位也依赖于全部输入位
+inline size_t hash_finalize_mix(size_t h) {
+    unsigned long long x = static_cast<unsigned long long>(h);
+    x ^= x >> 33;
+    x *= 0xff51afd7ed558ccdULL;
+    x ^= x >> 33;
+    x *= 0xc4ceb9fe1a85ec53ULL;
+    x ^= x >> 33;
+    return static_cast<size_t>(x);
+}
+
+namespace hash_detail {
+
+// wyhash使用的4个奇数常量
+constexpr uint64_t kSecret0 = 0x2d358dccaa6c78a5ULL;
+constexpr uint64_t kSecret1 = 0x8bb84b93962eacc9ULL;
+constexpr uint64_t kSecret2 = 0x4b33a62ed433d4a3ULL;
+constexpr uint64_t kSecret3 = 0x4d5a2da51de1aa47ULL;
+
+// 64×64→128位乘法，a、b分别得到乘积的低64位和高64位
+inline void mul128(uint64_t& a, uint64_t& b) {
+#if defined(__SIZEOF_INT128__)
+    unsigned __int128 r = static_cast<unsigned __int128>(a) * b;
+    a = static_cast<uint64_t>(r);
+    b = static_cast<uint64_t>(r >> 64);
+#else
+    // 没有128位整数的编译器：拆成32位分块相乘
+    uint64_t ha = a >> 32, hb = b >> 32, la = static_cast<uint32_t>(a), lb = static_cast<uint32_t>(b);
+    uint64_t rh = ha * hb, rm0 = ha * lb, rm1 = hb * la, rl = la * lb;
+    uint64_t t = rl + (rm0 << 32);
+    uint64_t carry = t < rl;
+    uint64_t lo = t + (rm1 << 32);
+    carry += lo < t;
+    uint64_t hi = rh + (rm0 >> 32) + (rm1 >> 32) + carry;
+    a = lo;
+    b = hi;
+#endif
+}
+
+// 乘积的高低两半异或，作为一步混合
+inline uint64_t mix(uint64_t a, uint64_t b) {
+    mul128(a, b);
+    return a ^ b;
+}
+
+// 非对齐读取（memcpy会被编译器优化成一条mov）
+inline uint64_t read8(const unsigned char* p) {
+    uint64_t v;
+    memcpy(&v, p, 8);
+    return v;
+}
+
+inline uint64_t read4(const unsigned char* p) {
+    uint32_t v;
+    memcpy(&v, p, 4);
+    return v;
+}
+
+// 1~3字节：取首、中、尾三个字节拼起来
+inline uint64_t read_small(const unsigned char* p, size_t k) {
+    return (static_cast<uint64_t>(p[0]) << 16) | (static_cast<uint64_t>(p[k >> 1]) << 8) | p[k - 1];
+}
+
+} // namespace hash_detail
+
+// 任意字节串的哈希（不要求以'\0'结尾）
+inline size_t hash_bytes(const void* data, size_t len, uint64_t seed = 0) {
+    using namespace hash_detail;
+    const unsigned char* p = static_cast<const unsigned char*>(data);
+    seed ^= mix(seed ^ kSecret0, kSecret1);
+    uint64_t a, b;
+    if (len <= 16) {
+        if (len >= 4) {
+            // 4~16字节：首尾各取两段4字节（可能重叠），无分支覆盖所有字节
+            size_t mid = (len >> 3) << 2;
+            a = (read4(p) << 32) | read4(p + mid);
+            b = (read4(p + len - 4) << 32) | read4(p + len - 4 - mid);
+        } else if (len > 0) {
+            a = read_small(p, len);
+            b = 0;
+        } else {
+            a = b = 0;
+        }
+    } else {
+        size_t i = len;
+        if (i > 48) {
+            // 长键：3条互不依赖的混合链并行，每轮消费48字节，乘法延迟可以相互重叠
+            uint64_t see1 = seed, see2 = seed;
+            do {
+                seed = mix(read8(p) ^ kSecret1, read8(p + 8) ^ seed);
+                see1 = mix(read8(p + 16) ^ kSecret2, read8(p + 24) ^ see1);
+                see2 = mix(read8(p + 32) ^ kSecret3, read8(p + 40) ^ see2);
+                p += 48;
+                i -= 48;
+            } while (i > 48);
+            seed ^= see1 ^ see2;
+        }
+        while (i > 16) {
+            seed = mix(read8(p) ^ kSecret1, read8(p + 8) ^ seed);
+            p += 16;
+            i -= 16;
+        }
+        // 最后16字节（可能与已处理部分重叠）
+        a = read8(p + i - 16);
+        b = read8(p + i - 8);
+    }
+    a ^= kSecret1;
+    b ^= seed;
+    mul128(a, b);
+    return static_cast<size_t>(mix(a ^ kSecret0 ^ len, b ^ kSecret1));
+}
+
+// 以'\0'结尾的C字符串
+inline size_t hash_cstring(const char* str) {
+    if (str == nullptr) {
+        return 0;
+    }
+    return hash_bytes(str, strlen(str));
+}
+
+// 浮点数：按位模式混合，+0.0与-0.0相等，因此哈希值也必须相同
+inline size_t hash_double(double val) {
+    if (val == 0.0) {
+        val = 0.0;
+    }
+    uint64_t bits;
+    memcpy(&bits, &val, sizeof(bits));
+    return hash_finalize_mix(static_cast<size_t>(bits));
+}
+
+#endif // HASH_FUNCTION_H
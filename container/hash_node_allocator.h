@@ -0,0 +1,192 @@
+#ifndef HASH_NODE_ALLOCATOR_H
+#define HASH_NODE_ALLOCATOR_H
+
+#include <cstddef> // size_t
+#include <new> // ::operator new / ::operator delete
+
+// ------- 链式哈希容器的节点分配策略 ------- //
+// 容器通过策略对象拿到/归还一块能放下一个Node的原始内存，自己负责placement new和显式析构。
+// 策略接口约定：
+//   void* allocate()               取一个节点大小的内存块
+//   void deallocate(void* p)       归还单个内存块（erase时使用）
+//   static constexpr bool kReleaseAll
+//                                  为true时支持release_all()：一次性归还所有内存块，
+//                                  容器的clear()/析构可以跳过逐个deallocate
+//   void release_all()
+//   void splice(Allocator& other)  接管other分配出去的全部内存块（并行建表时各线程用私有的分配器，
+//                                  建完后并入容器自己的分配器，由它统一释放）；other变为空
+
+// 策略一：每个节点单独::operator new / ::operator delete（原有行为）
+template <typename Node>
+class NewDeleteNodeAllocator {
+public:
+    static constexpr bool kReleaseAll = false;
+
+    void* allocate() {
+        return ::operator new(sizeof(Node));
+    }
+
+    void deallocate(void* p) {
+        ::operator delete(p);
+    }
+
+    void release_all() {}
+
+    // 节点逐个归还，没有需要接管的状态
+    void splice(NewDeleteNodeAllocator&) {}
+};
+
+// 策略二：按容器私有的slab批量分配节点
+// - 节点从当前slab顺序切出；slab容量从16个节点开始翻倍，上限4096个，小容器不会浪费太多内存
+// - erase归还的节点挂到空闲链表，下一次插入优先复用
+// - release_all()按slab释放，代价是O(slab个数)而不是O(节点个数)
+template <typename Node>
+class SlabNodeAllocator {
+private:
+    // 空闲时复用节点内存存放空闲链表指针
+    union Slot {
+        Slot* next_free;
+        alignas(Node) unsigned char storage[sizeof(Node)];
+    };
+
+    // slab头部，后面紧跟capacity个Slot
+    struct Slab {
+        Slab* next;
+        size_t capacity;
+    };
+
+    static constexpr size_t kFirstSlabNodes = 16;
+    static constexpr size_t kMaxSlabNodes = 4096;
+    // 头部按Slot对齐后的大小
+    static constexpr size_t kHeaderSize = (sizeof(Slab) + alignof(Slot) - 1) / alignof(Slot) * alignof(Slot);
+
+    Slab* slabs_ = nullptr; // slab链表（最新的在表头）
+    Slot* free_list_ = nullptr; // 已归还节点组成的空闲链表
+    size_t used_in_current_ = 0; // 当前slab已切出的节点数
+    size_t slab_count_ = 0;
+
+    Slot* slots_of(Slab* slab) {
+        return reinterpret_cast<Slot*>(reinterpret_cast<unsigned char*>(slab) + kHeaderSize);
+    }
+
+    void add_slab() {
+        size_t capacity = slabs_ == nullptr ? kFirstSlabNodes : slabs_->capacity * 2;
+        if (capacity > kMaxSlabNodes) {
+            capacity = kMaxSlabNodes;
+        }
+        Slab* slab = static_cast<Slab*>(::operator new(kHeaderSize + capacity * sizeof(Slot)));
+        slab->next = slabs_;
+        slab->capacity = capacity;
+        slabs_ = slab;
+        used_in_current_ = 0;
+        ++slab_count_;
+    }
+
+public:
+    static constexpr bool kReleaseAll = true;
+
+    SlabNodeAllocator() = default;
+
+    // 移动：直接接管slab链表（容器移动构造/移动赋值时使用）
+    SlabNodeAllocator(SlabNodeAllocator&& other) noexcept
+        : slabs_(other.slabs_), free_list_(other.free_list_),
+          used_in_current_(other.used_in_current_), slab_count_(other.slab_count_) {
+        other.slabs_ = nullptr;
+        other.free_list_ = nullptr;
+        other.used_in_current_ = 0;
+        other.slab_count_ = 0;
+    }
+
+    SlabNodeAllocator& operator=(SlabNodeAllocator&& other) noexcept {
+        if (this != &other) {
+            release_all();
+            slabs_ = other.slabs_;
+            free_list_ = other.free_list_;
+            used_in_current_ = other.used_in_current_;
+            slab_count_ = other.slab_count_;
+            other.slabs_ = nullptr;
+            other.free_list_ = nullptr;
+            other.used_in_current_ = 0;
+            other.slab_count_ = 0;
+        }
+        return *this;
+    }
+
+    // 禁止拷贝（slab归属唯一）
+    SlabNodeAllocator(const SlabNodeAllocator&) = delete;
+    SlabNodeAllocator& operator=(const SlabNodeAllocator&) = delete;
+
+    ~SlabNodeAllocator() {
+        release_all();
+    }
+
+    void* allocate() {
+        if (free_list_) {
+            Slot* slot = free_list_;
+            free_list_ = slot->next_free;
+            return slot;
+        }
+        if (slabs_ == nullptr || used_in_current_ == slabs_->capacity) {
+            add_slab();
+        }
+        return &slots_of(slabs_)[used_in_current_++];
+    }
+
+    void deallocate(void* p) {
+        Slot* slot = static_cast<Slot*>(p);
+        slot->next_free = free_list_;
+        free_list_ = slot;
+    }
+
+    // 归还全部slab（调用前容器必须已析构所有节点，或节点可平凡析构）
+    void release_all() {
+        while (slabs_) {
+            Slab* next = slabs_->next;
+            ::operator delete(slabs_);
+            slabs_ = next;
+        }
+        free_list_ = nullptr;
+        used_in_current_ = 0;
+        slab_count_ = 0;
+    }
+
+    size_t slab_count() const {
+        return slab_count_;
+    }
+
+    // 把other的slab接到自己的slab链表末尾（当前slab仍是表头，继续顺序切分），
+    // other空闲链表中的节点和其当前slab里尚未切出的节点都并入自己的空闲链表
+    void splice(SlabNodeAllocator& other) {
+        if (other.slabs_ == nullptr) {
+            return;
+        }
+        for (size_t i = other.used_in_current_; i < other.slabs_->capacity; ++i) {
+            other.deallocate(&other.slots_of(other.slabs_)[i]);
+        }
+        if (other.free_list_) {
+            Slot* tail = other.free_list_;
+            while (tail->next_free) {
+                tail = tail->next_free;
+            }
+            tail->next_free = free_list_;
+            free_list_ = other.free_list_;
+        }
+        if (slabs_ == nullptr) {
+            slabs_ = other.slabs_;
+            used_in_current_ = slabs_->capacity; // 接过来的表头slab已全部切出或进了空闲链表
+        } else {
+            Slab* tail = slabs_;
+            while (tail->next) {
+                tail = tail->next;
+            }
+            tail->next = other.slabs_;
+        }
+        slab_count_ += other.slab_count_;
+        other.slabs_ = nullptr;
+        other.free_list_ = nullptr;
+        other.used_in_current_ = 0;
+        other.slab_count_ = 0;
+    }
+};
+
+#endif // HASH_NODE_ALLOCATOR_H
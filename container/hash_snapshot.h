@@ -0,0 +1,455 @@
+#ifndef HASH_SNAPSHOT_H
+#define HASH_SNAPSHOT_H
+
+#include <cerrno> // EINTR
+#include <cstddef> // size_t、offsetof
+#include <cstdint> // uint32_t、uint64_t
+#include <cstdlib> // malloc、realloc、free
+#include <cstring> // memcpy、memcmp、strlen
+#include <istream> // std::istream
+#include <new> // std::bad_alloc
+#include <ostream> // std::ostream
+#include <string> // std::string（字符串键的读出缓冲）
+#include <sys/stat.h> // fstat（文件剩余长度）
+#include <type_traits> // std::is_trivially_copyable、std::is_pointer
+#include <unistd.h> // read、write、lseek
+#include "hash_function.h" // hash_bytes（块校验和）
+
+// ------- 哈希容器的二进制快照 ------- //
+// 容器的save/load把全部元素写成一个流式快照，重启时直接读回，不必再从上游逐条重建。
+// 文件布局：
+//   [SnapshotHeader]                         固定48字节，带自身的校验和
+//   [uint32 长度][数据][uint64 校验和] ...   数据块，默认满64KB写出一块
+//   [uint32 0][uint64 校验和]                结束块
+// 校验和是hash_bytes(数据, 长度, 种子 + 块序号)：块被截断、改写或调换顺序都会被发现。
+// 写入端按块缓冲，读取端每次read()整块读入并先校验再交给容器解析；头部和块都按本机字节序存放。
+//
+// 键/值的编码由序列化器决定（容器的save/load模板参数，可以替换）：
+//   static constexpr bool kRaw           为true时记录就是对象表示（sizeof(T)个字节），容器走快速路径
+//   using load_type = ...                load读出的类型，容器用它构造键/值
+//   template <typename Writer> static bool save(Writer& w, const T& v)       调w.write(data, n)写出
+//   template <typename Reader> static bool load(Reader& r, load_type& out)   调r.read(data, n)读回
+// 键和值都是kRaw时，一条记录是连续的 键字节 + 值字节，并且不会跨块：
+// load逐块取出记录、原地建节点、直接头插进桶，不经过insert的负载检查。
+// 头部的元素个数不可信（校验和不带密钥，任何人都能改完重新算）：load按流中实际能容纳的记录数
+// （SnapshotReader::record_bound）预留桶，读入更多块时再翻倍扩大，被截断或虚报个数的快照
+// 只会在读不到记录时返回false，不会先按虚报的个数分配内存。
+// load先读进一个临时容器，全部成功后才替换原有内容；失败时原容器保持不变。
+
+constexpr char kSnapshotMagic[8] = {'M', 'Y', 'H', 'S', 'N', 'A', 'P', '\0'};
+constexpr uint32_t kSnapshotVersion = 1;
+constexpr uint32_t kSnapshotByteOrder = 0x01020304; // 按本机字节序写入，读到别的值说明快照来自字节序不同的机器
+constexpr uint64_t kSnapshotSeed = 0x5a17c0de2b6e9d41ULL;
+constexpr size_t kSnapshotBlockSize = 64 * 1024; // 写入端攒满这么多字节写出一块
+constexpr size_t kSnapshotMaxBlock = 256u << 20; // 读取端接受的最大块（单条记录超过64KB时块会更大）
+
+// 快照中的容器种类，不同种类的快照不能互相加载
+constexpr uint32_t kSnapshotKindMap = 1;
+constexpr uint32_t kSnapshotKindMultiSet = 2;
+constexpr uint32_t kSnapshotKindMultimap = 3;
+
+struct SnapshotHeader {
+    char magic[8]; // "MYHSNAP"
+    uint32_t version;
+    uint32_t byte_order;
+    uint32_t kind; // kSnapshotKindXxx
+    uint32_t raw_records; // 1表示记录是定长的对象表示
+    uint32_t key_size; // raw_records为1时是sizeof(Key)，否则为0
+    uint32_t value_size; // 同上；集合为0
+    uint64_t count; // 元素个数
+    uint64_t checksum; // 前面各字段的校验和
+};
+
+// 按容器的参数填好头部（校验和由SnapshotWriter::begin计算）
+inline SnapshotHeader make_snapshot_header(uint32_t kind, bool raw, size_t key_size, size_t value_size,
+                                           uint64_t count) {
+    SnapshotHeader header;
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, kSnapshotMagic, sizeof(header.magic));
+    header.version = kSnapshotVersion;
+    header.byte_order = kSnapshotByteOrder;
+    header.kind = kind;
+    header.raw_records = raw ? 1 : 0;
+    header.key_size = raw ? static_cast<uint32_t>(key_size) : 0;
+    header.value_size = raw ? static_cast<uint32_t>(value_size) : 0;
+    header.count = count;
+    return header;
+}
+
+// 读到的头部与加载方的类型是否一致（magic/版本/字节序/校验和已由SnapshotReader::begin检查）
+inline bool snapshot_header_matches(const SnapshotHeader& header, uint32_t kind, bool raw, size_t key_size,
+                                    size_t value_size) {
+    SnapshotHeader expect = make_snapshot_header(kind, raw, key_size, value_size, 0);
+    return header.kind == expect.kind && header.raw_records == expect.raw_records &&
+           header.key_size == expect.key_size && header.value_size == expect.value_size;
+}
+
+// ------- 输出端/输入端：write/read全部写完或读满才返回true ------- //
+// 输入端的remaining()返回当前位置之后还剩多少字节，无法得知（管道、不可定位的流）时返回kSnapshotUnknownLength
+constexpr uint64_t kSnapshotUnknownLength = ~0ULL;
+
+struct OstreamSnapshotSink {
+    std::ostream& os;
+
+    bool write(const void* data, size_t n) {
+        os.write(static_cast<const char*>(data), static_cast<std::streamsize>(n));
+        return static_cast<bool>(os);
+    }
+};
+
+struct IstreamSnapshotSource {
+    std::istream& is;
+
+    bool read(void* data, size_t n) {
+        is.read(static_cast<char*>(data), static_cast<std::streamsize>(n));
+        return static_cast<size_t>(is.gcount()) == n;
+    }
+
+    uint64_t remaining() {
+        std::streampos pos = is.tellg();
+        if (pos == std::streampos(-1)) {
+            return kSnapshotUnknownLength;
+        }
+        is.seekg(0, std::ios::end);
+        std::streampos end = is.tellg();
+        is.clear(); // 流不支持定位时seekg会置failbit，清掉后回到原位置继续读
+        is.seekg(pos);
+        if (end == std::streampos(-1) || end < pos) {
+            return kSnapshotUnknownLength;
+        }
+        return static_cast<uint64_t>(end - pos);
+    }
+};
+
+// 文件描述符：处理短写/短读，被信号打断时重试
+struct FdSnapshotSink {
+    int fd;
+
+    bool write(const void* data, size_t n) {
+        const char* p = static_cast<const char*>(data);
+        while (n > 0) {
+            ssize_t written = ::write(fd, p, n);
+            if (written < 0) {
+                if (errno == EINTR) {
+                    continue;
+                }
+                return false;
+            }
+            p += written;
+            n -= static_cast<size_t>(written);
+        }
+        return true;
+    }
+};
+
+struct FdSnapshotSource {
+    int fd;
+
+    bool read(void* data, size_t n) {
+        char* p = static_cast<char*>(data);
+        while (n > 0) {
+            ssize_t got = ::read(fd, p, n);
+            if (got < 0) {
+                if (errno == EINTR) {
+                    continue;
+                }
+                return false;
+            }
+            if (got == 0) {
+                return false; // 提前到达文件末尾
+            }
+            p += got;
+            n -= static_cast<size_t>(got);
+        }
+        return true;
+    }
+
+    // 只有普通文件的长度是确定的
+    uint64_t remaining() {
+        struct stat st;
+        off_t pos = ::lseek(fd, 0, SEEK_CUR);
+        if (pos < 0 || ::fstat(fd, &st) != 0 || !S_ISREG(st.st_mode) || st.st_size < pos) {
+            return kSnapshotUnknownLength;
+        }
+        return static_cast<uint64_t>(st.st_size - pos);
+    }
+};
+
+// ------- 写入端：攒块、算校验和、写出 ------- //
+// 输出端出错后后续操作都不再写出，finish()返回false
+template <typename Sink>
+class SnapshotWriter {
+public:
+    explicit SnapshotWriter(Sink& sink) : sink_(sink) {}
+
+    SnapshotWriter(const SnapshotWriter&) = delete;
+    SnapshotWriter& operator=(const SnapshotWriter&) = delete;
+
+    ~SnapshotWriter() {
+        free(buffer_);
+    }
+
+    bool begin(SnapshotHeader header) {
+        header.checksum = hash_bytes(&header, offsetof(SnapshotHeader, checksum), kSnapshotSeed);
+        ok_ = sink_.write(&header, sizeof(header));
+        return ok_;
+    }
+
+    // 在当前块中留出n个连续字节由调用方填满（放不下时先写出当前块），保证这n个字节不跨块
+    unsigned char* reserve(size_t n) {
+        if (used_ + n > capacity_) {
+            if (used_ > 0) {
+                flush_block();
+            }
+            if (n > capacity_) {
+                grow(n);
+            }
+        }
+        unsigned char* p = buffer_ + used_;
+        used_ += n;
+        return p;
+    }
+
+    // 写出n个字节，可以跨块
+    bool write(const void* data, size_t n) {
+        const unsigned char* p = static_cast<const unsigned char*>(data);
+        if (capacity_ == 0) {
+            grow(kSnapshotBlockSize);
+        }
+        while (n > 0) {
+            if (used_ == capacity_) {
+                flush_block();
+            }
+            size_t part = capacity_ - used_ < n ? capacity_ - used_ : n;
+            memcpy(buffer_ + used_, p, part);
+            used_ += part;
+            p += part;
+            n -= part;
+        }
+        return ok_;
+    }
+
+    // 写出最后一块和结束块
+    bool finish() {
+        if (used_ > 0) {
+            flush_block();
+        }
+        flush_block(); // 长度为0的结束块
+        return ok_;
+    }
+
+private:
+    Sink& sink_;
+    unsigned char* buffer_ = nullptr;
+    size_t capacity_ = 0;
+    size_t used_ = 0;
+    uint64_t block_index_ = 0;
+    bool ok_ = true;
+
+    void grow(size_t n) {
+        size_t capacity = n > kSnapshotBlockSize ? n : kSnapshotBlockSize;
+        buffer_ = static_cast<unsigned char*>(realloc(buffer_, capacity));
+        if (buffer_ == nullptr) {
+            throw std::bad_alloc();
+        }
+        capacity_ = capacity;
+    }
+
+    void flush_block() {
+        uint32_t len = static_cast<uint32_t>(used_);
+        uint64_t checksum = hash_bytes(buffer_, used_, kSnapshotSeed + block_index_++);
+        ok_ = ok_ && sink_.write(&len, sizeof(len)) && (len == 0 || sink_.write(buffer_, len)) &&
+              sink_.write(&checksum, sizeof(checksum));
+        used_ = 0;
+    }
+};
+
+// ------- 读取端：整块读入、校验后再交给容器 ------- //
+// 任何错误（读不满、校验和不符、块过大、记录跨块）之后都返回nullptr/false
+template <typename Source>
+class SnapshotReader {
+public:
+    explicit SnapshotReader(Source& source) : source_(source) {}
+
+    SnapshotReader(const SnapshotReader&) = delete;
+    SnapshotReader& operator=(const SnapshotReader&) = delete;
+
+    ~SnapshotReader() {
+        free(buffer_);
+    }
+
+    bool begin(SnapshotHeader& header) {
+        ok_ = source_.read(&header, sizeof(header)) &&
+              memcmp(header.magic, kSnapshotMagic, sizeof(header.magic)) == 0 &&
+              header.version == kSnapshotVersion && header.byte_order == kSnapshotByteOrder &&
+              header.checksum == hash_bytes(&header, offsetof(SnapshotHeader, checksum), kSnapshotSeed);
+        return ok_;
+    }
+
+    // 头部声明了count条记录、每条至少record_bytes字节时，流里实际最多能有多少条：
+    // 剩余长度已知时按剩余字节数计算；否则读入第一块，按这一块能装下的记录数给出（之后的块由调用方按需扩大）。
+    // 只应在count > 0时调用（否则会把结束块当成数据块读掉）
+    uint64_t record_bound(uint64_t count, size_t record_bytes) {
+        uint64_t remaining = source_.remaining();
+        if (remaining == kSnapshotUnknownLength) {
+            remaining = available();
+        }
+        uint64_t bound = remaining / record_bytes;
+        return bound < count ? bound : count;
+    }
+
+    // 当前块中还没取走的字节数；当前块已取完时先读入下一块，没有下一块（出错或到达结束块）时返回0
+    size_t available() {
+        if (pos_ == len_ && !next_block()) {
+            return 0;
+        }
+        return len_ - pos_;
+    }
+
+    // 取出n个连续字节（与写入端的reserve对应）：当前块用完时读入下一块；记录跨块视为损坏
+    const unsigned char* take(size_t n) {
+        if (pos_ == len_ && !next_block()) {
+            return nullptr;
+        }
+        if (len_ - pos_ < n) {
+            ok_ = false;
+            return nullptr;
+        }
+        const unsigned char* p = buffer_ + pos_;
+        pos_ += n;
+        return p;
+    }
+
+    // 读出n个字节，可以跨块
+    bool read(void* data, size_t n) {
+        unsigned char* p = static_cast<unsigned char*>(data);
+        while (n > 0) {
+            if (pos_ == len_ && !next_block()) {
+                return false;
+            }
+            size_t part = len_ - pos_ < n ? len_ - pos_ : n;
+            memcpy(p, buffer_ + pos_, part);
+            pos_ += part;
+            p += part;
+            n -= part;
+        }
+        return true;
+    }
+
+    // 当前块已读完，且下一块是结束块
+    bool finish() {
+        if (!ok_ || pos_ != len_) {
+            return false;
+        }
+        next_block();
+        return ok_ && ended_;
+    }
+
+private:
+    Source& source_;
+    unsigned char* buffer_ = nullptr;
+    size_t capacity_ = 0;
+    size_t len_ = 0; // 当前块的长度
+    size_t pos_ = 0; // 当前块中已取走的字节数
+    uint64_t block_index_ = 0;
+    bool ok_ = true;
+    bool ended_ = false; // 已读到结束块
+
+    bool next_block() {
+        pos_ = len_ = 0;
+        if (!ok_ || ended_) {
+            ok_ = false;
+            return false;
+        }
+        uint32_t len;
+        if (!source_.read(&len, sizeof(len)) || len > kSnapshotMaxBlock) {
+            ok_ = false;
+            return false;
+        }
+        if (len > capacity_) {
+            unsigned char* grown = static_cast<unsigned char*>(realloc(buffer_, len));
+            if (grown == nullptr) {
+                ok_ = false;
+                return false;
+            }
+            buffer_ = grown;
+            capacity_ = len;
+        }
+        uint64_t checksum;
+        if ((len > 0 && !source_.read(buffer_, len)) || !source_.read(&checksum, sizeof(checksum)) ||
+            checksum != hash_bytes(buffer_, len, kSnapshotSeed + block_index_++)) {
+            ok_ = false;
+            return false;
+        }
+        if (len == 0) {
+            ended_ = true;
+            return false;
+        }
+        len_ = len;
+        return true;
+    }
+};
+
+// ------- 默认序列化器 ------- //
+// 定长类型直接写对象表示；指针和不可平凡复制的类型需要特化或自带序列化器
+template <typename T>
+struct SnapshotSerializer {
+    static_assert(std::is_trivially_copyable<T>::value && !std::is_pointer<T>::value,
+                  "SnapshotSerializer<T>只能直接保存可平凡复制的非指针类型，其他类型请提供自定义序列化器");
+
+    static constexpr bool kRaw = true;
+    using load_type = T;
+
+    template <typename Writer>
+    static bool save(Writer& w, const T& v) {
+        return w.write(&v, sizeof(T));
+    }
+
+    template <typename Reader>
+    static bool load(Reader& r, T& out) {
+        return r.read(&out, sizeof(T));
+    }
+};
+
+// 字符串编码为 uint64长度 + 字节
+template <>
+struct SnapshotSerializer<std::string> {
+    static constexpr bool kRaw = false;
+    using load_type = std::string;
+
+    template <typename Writer>
+    static bool save(Writer& w, const std::string& s) {
+        uint64_t len = s.size();
+        return w.write(&len, sizeof(len)) && w.write(s.data(), s.size());
+    }
+
+    template <typename Reader>
+    static bool load(Reader& r, std::string& out) {
+        uint64_t len;
+        if (!r.read(&len, sizeof(len)) || len > kSnapshotMaxBlock) {
+            return false;
+        }
+        out.resize(static_cast<size_t>(len));
+        return r.read(&out[0], out.size());
+    }
+};
+
+// char*键（MyUnorderedMap的字符串键）：与std::string编码相同，读回std::string交给容器复制进StringArena
+template <>
+struct SnapshotSerializer<char*> {
+    static constexpr bool kRaw = false;
+    using load_type = std::string;
+
+    template <typename Writer>
+    static bool save(Writer& w, const char* s) {
+        uint64_t len = strlen(s);
+        return w.write(&len, sizeof(len)) && w.write(s, static_cast<size_t>(len));
+    }
+
+    template <typename Reader>
+    static bool load(Reader& r, std::string& out) {
+        return SnapshotSerializer<std::string>::load(r, out);
+    }
+};
+
+#endif // HASH_SNAPSHOT_H
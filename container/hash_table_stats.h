@@ -0,0 +1,164 @@
+#ifndef HASH_TABLE_STATS_H
+#define HASH_TABLE_STATS_H
+
+#include <chrono> // std::chrono::steady_clock
+#include <cstddef> // size_t
+#include <cstdint> // uint32_t、uint64_t
+#include <cstdio> // snprintf
+#include <string> // std::string（仅to_json使用）
+
+// ------- 哈希容器健康度统计 ------- //
+// 容器的stats()返回HashTableStats快照，包括三部分：
+// 1. 桶分布：调用stats()时扫描一遍桶数组现算（O(桶数)，不在热路径上）——空桶数、链长直方图、最长链
+// 2. 查找探测长度：采样统计，每kProbeSampleInterval次find抽一次，重走一遍链数出比较了几个节点；
+//    未被抽中的find只多一次计数器递减，可以在生产环境常开
+// 3. rehash时间线：次数、总耗时、最长耗时，以及最近kRehashHistory次的明细（rehash很少发生，计时开销可忽略）
+
+// 一次rehash的记录
+struct RehashEvent {
+    uint64_t size; // rehash时的元素个数
+    uint64_t old_buckets;
+    uint64_t new_buckets;
+    uint64_t duration_ns; // 迁移耗时（渐进式rehash为各步耗时之和）
+};
+
+struct HashTableStats {
+    static constexpr size_t kChainHistogram = 8; // 链长0~6各占一格，最后一格统计长度>=7的链
+    static constexpr size_t kRehashHistory = 8;
+
+    size_t size = 0;
+    size_t bucket_count = 0;
+    double load_factor = 0;
+    size_t empty_buckets = 0;
+    size_t max_chain = 0;
+    size_t chain_histogram[kChainHistogram] = {};
+
+    uint64_t sampled_finds = 0; // 被采样的find次数
+    double avg_probe = 0; // 被采样的find平均比较的节点数（未命中时为整条链长）
+    size_t max_probe = 0;
+
+    uint64_t rehash_count = 0;
+    uint64_t rehash_total_ns = 0;
+    uint64_t rehash_max_ns = 0;
+    size_t rehash_history_count = 0; // rehash_history中有效的条数
+    RehashEvent rehash_history[kRehashHistory] = {}; // 最近几次rehash，按时间从早到晚
+
+    // 导出为单行JSON
+    std::string to_json() const {
+        std::string out;
+        char buf[256];
+        snprintf(buf, sizeof(buf),
+                 "{\"size\":%zu,\"bucket_count\":%zu,\"load_factor\":%.4f,\"empty_buckets\":%zu,\"max_chain\":%zu,"
+                 "\"chain_histogram\":[",
+                 size, bucket_count, load_factor, empty_buckets, max_chain);
+        out += buf;
+        for (size_t i = 0; i < kChainHistogram; ++i) {
+            snprintf(buf, sizeof(buf), i == 0 ? "%zu" : ",%zu", chain_histogram[i]);
+            out += buf;
+        }
+        snprintf(buf, sizeof(buf),
+                 "],\"sampled_finds\":%llu,\"avg_probe\":%.4f,\"max_probe\":%zu,\"rehash_count\":%llu,"
+                 "\"rehash_total_ns\":%llu,\"rehash_max_ns\":%llu,\"rehash_history\":[",
+                 static_cast<unsigned long long>(sampled_finds), avg_probe, max_probe,
+                 static_cast<unsigned long long>(rehash_count), static_cast<unsigned long long>(rehash_total_ns),
+                 static_cast<unsigned long long>(rehash_max_ns));
+        out += buf;
+        for (size_t i = 0; i < rehash_history_count; ++i) {
+            const RehashEvent& e = rehash_history[i];
+            snprintf(buf, sizeof(buf), "%s{\"size\":%llu,\"old_buckets\":%llu,\"new_buckets\":%llu,\"duration_ns\":%llu}",
+                     i == 0 ? "" : ",", static_cast<unsigned long long>(e.size),
+                     static_cast<unsigned long long>(e.old_buckets), static_cast<unsigned long long>(e.new_buckets),
+                     static_cast<unsigned long long>(e.duration_ns));
+            out += buf;
+        }
+        out += "]}";
+        return out;
+    }
+};
+
+// 容器内嵌的统计收集器：记录采样的探测长度和rehash事件，stats()时连同桶分布一起填入HashTableStats
+class HashTableMonitor {
+public:
+    static constexpr uint32_t kProbeSampleInterval = 64;
+
+    // 本次find是否需要采样
+    bool sample_find() {
+        if (--countdown_ != 0) {
+            return false;
+        }
+        countdown_ = kProbeSampleInterval;
+        return true;
+    }
+
+    void record_probe(size_t probes) {
+        ++sampled_finds_;
+        probe_sum_ += probes;
+        if (probes > max_probe_) {
+            max_probe_ = probes;
+        }
+    }
+
+    static uint64_t now_ns() {
+        return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                                         std::chrono::steady_clock::now().time_since_epoch())
+                                         .count());
+    }
+
+    void record_rehash(size_t size, size_t old_buckets, size_t new_buckets, uint64_t duration_ns) {
+        ++rehash_count_;
+        rehash_total_ns_ += duration_ns;
+        if (duration_ns > rehash_max_ns_) {
+            rehash_max_ns_ = duration_ns;
+        }
+        history_[history_next_ % HashTableStats::kRehashHistory] = {size, old_buckets, new_buckets, duration_ns};
+        ++history_next_;
+    }
+
+    // 填入探测与rehash部分；chain_length(i)返回第i个桶的链长，用于统计桶分布
+    template <typename ChainLength>
+    void fill(HashTableStats& out, size_t size, size_t bucket_count, ChainLength chain_length) const {
+        out.size = size;
+        out.bucket_count = bucket_count;
+        out.load_factor = bucket_count ? static_cast<double>(size) / bucket_count : 0.0;
+        for (size_t i = 0; i < bucket_count; ++i) {
+            size_t len = chain_length(i);
+            out.empty_buckets += len == 0;
+            out.max_chain = len > out.max_chain ? len : out.max_chain;
+            ++out.chain_histogram[len < HashTableStats::kChainHistogram ? len : HashTableStats::kChainHistogram - 1];
+        }
+
+        out.sampled_finds = sampled_finds_;
+        out.avg_probe = sampled_finds_ ? static_cast<double>(probe_sum_) / sampled_finds_ : 0.0;
+        out.max_probe = max_probe_;
+
+        out.rehash_count = rehash_count_;
+        out.rehash_total_ns = rehash_total_ns_;
+        out.rehash_max_ns = rehash_max_ns_;
+        size_t kept = history_next_ < HashTableStats::kRehashHistory ? history_next_ : HashTableStats::kRehashHistory;
+        out.rehash_history_count = kept;
+        for (size_t i = 0; i < kept; ++i) {
+            out.rehash_history[i] = history_[(history_next_ - kept + i) % HashTableStats::kRehashHistory];
+        }
+    }
+
+    // 清零探测统计（rehash记录保留），便于按时间窗口观察
+    void reset_probes() {
+        sampled_finds_ = 0;
+        probe_sum_ = 0;
+        max_probe_ = 0;
+    }
+
+private:
+    uint32_t countdown_ = kProbeSampleInterval;
+    uint64_t sampled_finds_ = 0;
+    uint64_t probe_sum_ = 0;
+    size_t max_probe_ = 0;
+
+    uint64_t rehash_count_ = 0;
+    uint64_t rehash_total_ns_ = 0;
+    uint64_t rehash_max_ns_ = 0;
+    RehashEvent history_[HashTableStats::kRehashHistory] = {};
+    size_t history_next_ = 0;
+};
+
+#endif // HASH_TABLE_STATS_H
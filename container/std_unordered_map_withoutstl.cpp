@@ -1,19 +1,32 @@
 ﻿// reference: https://www.doubao.com/chat/27464450228393730
 #include <cstdlib> // 提供malloc/free、rand等
-#include <cstring> // memcpy（仅用于字符串复制）
+#include <cstring> // memcpy（字符串复制）
 #include <iostream> // 用于调试输出
+#include <new> // placement new
+#include <algorithm> // std::min、std::max
+#include <utility> // std::forward、std::swap
+#include <type_traits> // std::is_trivially_destructible、std::is_same
+#include <string_view> // std::string_view（char*键的免拷贝查找）
+#include <thread> // std::thread（bulk_build并行建表）
+#include <memory> // std::unique_ptr
+#include <iterator> // std::distance
+#include "hash_function.h" // 默认哈希函数（整数混合、字节串wyhash）
+#include "hash_bucket_policy.h" // 桶索引策略（质数表/2的幂掩码）
+#include "hash_node_allocator.h" // 节点分配策略（slab/逐个new）
+#include "string_arena.h" // char*键的连续存储
+#include "hash_code_cache.h" // 节点中可选缓存的完整哈希值
+#include "hash_table_stats.h" // 健康度统计（链长分布、采样探测长度、rehash时间线）
+#include "hash_snapshot.h" // 二进制快照（save/load）
+#include "string_simd.h" // SIMD字符串长度/比较（一次处理16/32字节）
 
 // 字符串工具函数（提供std::string相关功能）
+// 长度和比较转调string_simd.h，每次处理一个向量宽度而不是一个字节
 // 计算字符串长度
 size_t my_strlen(const char* str) {
     if (str == nullptr) {
         return 0;
     }
-    size_t len = 0;
-    while (str[len] != '\0') {
-        len++;
-    }
-    return len;
+    return simd_strlen(str);
 }
 
 // 复制字符串（返回新分配的内存，需手动释放）
@@ -27,10 +40,7 @@ char* my_strdup(const char* str) {
         std::cerr << "内存分配失败！" << std::endl;
         exit(1);
     }
-    // 复制字符（包括'\0'）
-    for (size_t i = 0; i <= len; ++i) {
-        new_str[i] = str[i];
-    }
+    memcpy(new_str, str, len + 1); // 复制字符（包括'\0'）
     return new_str;
 }
 
@@ -45,45 +55,43 @@ int my_strcmp(const char* str1, const char* str2) {
     if (str2 == nullptr) {
         return 1;
     }
-    size_t i = 0;
-    while (str1[i] != '\0' && str2[i] != '\0') {
-        if (str1[i] != str2[i]) {
-            return (unsigned char)str1[i] - (unsigned char)str2[i];
-        }
-        i++;
-    }
-    return (unsigned char)str1[i] - (unsigned char)str2[i];
+    return simd_strcmp(str1, str2);
+}
+
+// 软件预取：提示CPU提前把p所在缓存行读入缓存（不支持的编译器上为空操作，p可以为nullptr）
+inline void prefetch_read(const void* p) {
+#if defined(__GNUC__) || defined(__clang__)
+    __builtin_prefetch(p, 0, 3);
+#else
+    (void)p;
+#endif
 }
 
 // ------- 哈希节点结构（存储键值对及链表指针） ------- //
-template <typename Key, typename Value>
-struct HashNode {
+// CacheHash为true时基类里多存一份完整哈希值，见hash_code_cache.h
+template <typename Key, typename Value, bool CacheHash = false>
+struct HashNode : CachedHashCode<CacheHash> {
     Key key;
     Value value;
     HashNode* next;
-    
-    HashNode(const Key& k, const Value& v) : key(k), value(v), next(nullptr) {}
+
+    // 键转发构造，值由其余参数原地构造（没有参数时值初始化），支持只能移动的键/值
+    template <typename K, typename... Args>
+    explicit HashNode(K&& k, Args&&... args)
+        : key(std::forward<K>(k)), value(std::forward<Args>(args)...), next(nullptr) {}
 };
 
-// 针对char*的哈希节点结构特化（需手动管理字符串内存）
-template <typename Value>
-struct HashNode<char*, Value> {
-    char* key;
+// 针对char*的哈希节点结构特化
+// 键字节由所属容器的StringArena统一存放（连同预先算好的长度和哈希），节点只保存指针、不负责释放
+template <typename Value, bool CacheHash>
+struct HashNode<char*, Value, CacheHash> : CachedHashCode<CacheHash> {
+    char* key; // 指向StringArena中以'\0'结尾的副本
     Value value;
     HashNode* next;
 
-    // 构造时复制字符串
-    HashNode(const char* k, const Value& v) : value(v), next(nullptr) {
-        key = my_strdup(k);
-    }
-
-    // 析构时释放字符串内存
-    ~HashNode() {
-        if (key) {
-            free(key);
-            key = nullptr;
-        }
-    }
+    template <typename... Args>
+    explicit HashNode(char* arena_key, Args&&... args)
+        : key(arena_key), value(std::forward<Args>(args)...), next(nullptr) {}
 };
 
 // 哈希函数模板
@@ -93,25 +101,27 @@ struct MyHash {
 };
 
 // 整型哈希函数特化
+// 不能直接返回整数值：连续/等步长的ID会集中在少数桶里，先经fmix64混合
 template <>
 struct MyHash<int> {
     size_t operator()(const int& key) const {
-        return (size_t)key; // 简单哈希，直接返回整数值
+        return hash_finalize_mix(static_cast<size_t>(static_cast<unsigned int>(key)));
     }
 };
 
 // char* 类型哈希函数特化
+// 另提供(指针, 长度)重载，供不以'\0'结尾的缓冲区直接查找，两种调用对同一字符串结果相同
 template <>
 struct MyHash<char*> {
     size_t operator()(const char* key) const {
         if (key == nullptr) {
             return 0;
         }
-        size_t hash_val = 0;
-        for (size_t i = 0; key[i] != '\0'; ++i) {
-            hash_val = hash_val * 31 + (unsigned char)key[i];
-        }
-        return hash_val;
+        return (*this)(key, my_strlen(key));
+    }
+
+    size_t operator()(const char* key, size_t len) const {
+        return hash_bytes(key, len); // wyhash，每步8字节，取代逐字节的h*31+c
     }
 };
 
@@ -133,7 +143,10 @@ struct KeyEqual<int> {
 template <>
 struct KeyEqual<char*> {
     bool operator()(const char* a, const char* b) const {
-        return my_strcmp(a, b) == 0;
+        if (a == nullptr || b == nullptr) {
+            return a == b;
+        }
+        return simd_strequal(a, b); // 只判断相等，找到第一个不同的字节即可返回
     }
 };
 
@@ -141,82 +154,511 @@ struct KeyEqual<char*> {
 template <typename Key,
           typename Value,
           typename Hash = MyHash<Key>,
-          typename KeyEqual = KeyEqual<Key>>
+          typename KeyEqual = KeyEqual<Key>,
+          typename BucketPolicy = PrimeBucketPolicy,
+          template <typename> class NodeAllocator = SlabNodeAllocator,
+          bool CacheHash = false> // 节点中缓存完整哈希值：rehash不再调用哈希函数，查找时先比哈希再比键
 class MyUnorderedMap {
 private:
-    using Node = HashNode<Key, Value>;
+    using Node = HashNode<Key, Value, CacheHash>;
     Node** buckets; // 桶数组（每个元素是链表头指针）
     size_t size_; // 当前元素数量
     size_t bucket_count_; // 桶的数量
     const float max_load_factor_; // 最大负载因子（默认0.75）
     Hash hash_func; // 哈希函数对象
     KeyEqual key_eq; // 键比较函数对象
+    BucketPolicy bucket_policy_; // 桶索引策略（决定桶数量与hash->桶下标的映射）
+    NodeAllocator<Node> node_alloc_; // 节点分配策略
+    StringArena key_arena_; // char*键的字节存放处（其他键类型不使用）
+
+    static constexpr bool kStringKey = std::is_same<Key, char*>::value;
+
+    // 渐进式rehash状态：迁移期间保留旧桶数组，每次操作只迁移有限个旧桶，查找时新旧两张表都要检查
+    bool incremental_rehash_ = false; // 是否启用渐进式rehash（默认一次性迁移）
+    Node** old_buckets_ = nullptr; // 正在迁移的旧桶数组，nullptr表示当前没有进行中的rehash
+    size_t old_bucket_count_ = 0; // 旧桶数量
+    BucketPolicy old_policy_; // 旧桶数组对应的索引策略
+    size_t migrate_pos_ = 0; // 下一个待迁移的旧桶下标
+    static constexpr size_t kRehashStepBuckets = 8; // 每次操作最多迁移的非空旧桶数
+
+    static constexpr size_t kBatchGroup = 16; // 批量查找时同时在途的查找个数
+    static constexpr size_t kBulkParallelMin = 4096; // bulk_build元素少于它时不开线程
+    static constexpr unsigned kBulkMaxThreads = 256; // bulk_build线程数上限（分区号存成uint16_t）
+
+    mutable HashTableMonitor monitor_; // 健康度统计
+    uint64_t incremental_rehash_ns_ = 0; // 进行中的渐进式rehash已累计的迁移耗时
+    size_t incremental_rehash_size_ = 0; // 渐进式rehash开始时的元素个数
 
 private:
-    // 判断质数（用于扩容）
-    bool is_prime(size_t n) const {
-        if (n <= 1) return false;
-        if (n == 2) return true;
-        if (n % 2 == 0) return false;
-        for (size_t i = 3; i * i <= n; i += 2) {
-            if (n % i == 0) return false;
+    // 分配桶数组并初始化为nullptr
+    static Node** allocate_buckets(size_t n) {
+        Node** new_buckets = (Node**)calloc(n, sizeof(Node*)); // 使用calloc初始化为0
+        // calloc是C标准库函数，分配内存并初始化为0
+        if (new_buckets == nullptr) {
+            std::cerr << "内存分配失败！" << std::endl;
+            exit(1);
         }
-        return true;
+        return new_buckets;
+    }
+
+    // 从分配策略取内存并原地构造节点
+    template <typename... Args>
+    Node* create_node(Args&&... args) {
+        return new (node_alloc_.allocate()) Node(std::forward<Args>(args)...);
+    }
+
+    // 析构节点并把内存还给分配策略
+    void destroy_node(Node* node) {
+        node->~Node();
+        node_alloc_.deallocate(node);
     }
 
-    // 获取下一个质数
-    size_t next_prime(size_t n) const {
-        while (!is_prime(n)) {
-            n++;
+    // 把一整条链上的节点头插到当前（新）桶数组中
+    void migrate_chain(Node* curr) {
+        while (curr) {
+            Node* next = curr->next; // 保存下一个节点
+
+            // 计算新桶索引
+            size_t new_idx = bucket_policy_.index(node_hash(curr));
+            // 插入新桶的头部
+            curr->next = buckets[new_idx];
+            buckets[new_idx] = curr;
+            curr = next;
         }
-        return n;
     }
 
-    // 扩容：重新分配桶并迁移所有元素
-    void rehash() {
+    // 扩容：重新分配桶并迁移所有元素；桶数至少翻倍，min_buckets更大时（reserve）直接扩到它
+    void rehash(size_t min_buckets = 0) {
+        if (old_buckets_) {
+            rehash_step(old_bucket_count_); // 先完成进行中的渐进式迁移
+        }
+        uint64_t start_ns = HashTableMonitor::now_ns();
         size_t old_bucket_count = bucket_count_;
         Node** old_buckets = buckets;
 
-        // 计算新桶数量
-        bucket_count_ = next_prime(bucket_count_ * 2);
-        // 分配新桶数组（初始化为nullptr）
-        buckets = (Node**)calloc(bucket_count_, sizeof(Node*)); // 使用calloc初始化为0
-        // calloc是C标准库函数，分配内存并初始化为0
-        if (buckets == nullptr) {
-            std::cerr << "内存分配失败！" << std::endl;
-            exit(1);
-        }
+        // 计算新桶数量（由策略取不小于2倍的质数/2的幂）
+        bucket_count_ = bucket_policy_.reset(min_buckets > bucket_count_ * 2 ? min_buckets : bucket_count_ * 2);
+        buckets = allocate_buckets(bucket_count_);
 
         // 迁移旧桶中的数据
         for (size_t i = 0; i < old_bucket_count; ++i) {
-            Node* curr = old_buckets[i];
-            while (curr) {
-                Node* next = curr->next; // 保存下一个节点
-
-                // 计算新桶索引
-                size_t new_idx = hash_func(curr->key) % bucket_count_;
-                // 插入新桶的头部
-                curr->next = buckets[new_idx];
-                buckets[new_idx] = curr;
-                curr = next;
-            }
+            migrate_chain(old_buckets[i]);
         }
 
         // 释放旧桶数组（注意：节点已迁移，此处仅释放桶数组本身）
         free(old_buckets);
+        monitor_.record_rehash(size_, old_bucket_count, bucket_count_, HashTableMonitor::now_ns() - start_ns);
+    }
+
+    // 渐进式扩容：只分配新桶数组，旧桶留待后续操作逐步迁移
+    void start_incremental_rehash() {
+        if (old_buckets_) {
+            rehash_step(old_bucket_count_); // 上一轮尚未迁移完，先收尾
+        }
+        old_buckets_ = buckets;
+        old_bucket_count_ = bucket_count_;
+        old_policy_ = bucket_policy_;
+        migrate_pos_ = 0;
+        incremental_rehash_ns_ = 0;
+        incremental_rehash_size_ = size_;
+
+        bucket_count_ = bucket_policy_.reset(bucket_count_ * 2);
+        buckets = allocate_buckets(bucket_count_);
+    }
+
+    // 迁移至多max_buckets个非空旧桶；连续空桶最多跳过max_buckets*10个，保证单次操作耗时有界
+    void rehash_step(size_t max_buckets) {
+        if (old_buckets_ == nullptr) {
+            return;
+        }
+        uint64_t start_ns = HashTableMonitor::now_ns();
+        size_t empty_visits = max_buckets * 10;
+        while (max_buckets > 0 && migrate_pos_ < old_bucket_count_) {
+            Node* chain = old_buckets_[migrate_pos_];
+            old_buckets_[migrate_pos_++] = nullptr;
+            if (chain == nullptr) {
+                if (--empty_visits == 0) {
+                    break;
+                }
+                continue;
+            }
+            migrate_chain(chain);
+            --max_buckets;
+        }
+        incremental_rehash_ns_ += HashTableMonitor::now_ns() - start_ns;
+        // 全部迁移完毕，释放旧桶数组，记录这次rehash（耗时为各步之和）
+        if (migrate_pos_ >= old_bucket_count_) {
+            monitor_.record_rehash(incremental_rehash_size_, old_bucket_count_, bucket_count_, incremental_rehash_ns_);
+            free(old_buckets_);
+            old_buckets_ = nullptr;
+            old_bucket_count_ = 0;
+        }
+    }
+
+    // 节点键的哈希值：开启CacheHash时直接取节点中缓存的值；
+    // char*键可以取StringArena中保存的哈希（要读一次键所在的内存），都无需再扫描字节
+    size_t node_hash(const Node* node) const {
+        if constexpr (CacheHash) {
+            return node->hash_code;
+        } else if constexpr (kStringKey) {
+            return StringArena::hash(node->key);
+        } else {
+            return hash_func(node->key);
+        }
+    }
+
+    // 在新表（以及迁移中的旧表）里查找第一个满足match的节点
+    template <typename Match>
+    Node* find_node_if(size_t hash_val, Match match) const {
+        for (Node* curr = buckets[bucket_policy_.index(hash_val)]; curr; curr = curr->next) {
+            if (match(curr)) {
+                return curr;
+            }
+        }
+        if (old_buckets_) {
+            for (Node* curr = old_buckets_[old_policy_.index(hash_val)]; curr; curr = curr->next) {
+                if (match(curr)) {
+                    return curr;
+                }
+            }
+        }
+        return nullptr;
+    }
+
+    // 未开启CacheHash时hash_may_equal恒为true，编译器会把这次比较直接消掉
+    auto key_matcher(const Key& key, size_t hash_val) const {
+        return [this, &key, hash_val](const Node* node) {
+            return node->hash_may_equal(hash_val) && key_eq(node->key, key);
+        };
+    }
+
+    // 采样用：数出查找比较了几个节点（命中时数到匹配节点为止，未命中时为新旧两条链的总长）
+    template <typename Match>
+    size_t probe_length(size_t hash_val, Match match) const {
+        size_t probes = 0;
+        for (Node* curr = buckets[bucket_policy_.index(hash_val)]; curr; curr = curr->next) {
+            ++probes;
+            if (match(curr)) {
+                return probes;
+            }
+        }
+        if (old_buckets_) {
+            for (Node* curr = old_buckets_[old_policy_.index(hash_val)]; curr; curr = curr->next) {
+                ++probes;
+                if (match(curr)) {
+                    return probes;
+                }
+            }
+        }
+        return probes;
+    }
+
+    Node* find_node(const Key& key, size_t hash_val) const {
+        return find_node_if(hash_val, key_matcher(key, hash_val));
+    }
+
+    // char*键：先比较节点中缓存的哈希（如有），再比较arena中记录的长度，最后逐字节比较
+    static auto string_matcher(const char* data, size_t len, size_t hash_val) {
+        return [data, len, hash_val](const Node* node) {
+            return node->hash_may_equal(hash_val) && StringArena::length(node->key) == len &&
+                   memcmp(node->key, data, len) == 0;
+        };
+    }
+
+    // 批量查找（分组预取）：每组kBatchGroup个键分三趟处理，
+    //   1. 算出整组的哈希值和桶下标，预取桶槽位
+    //   2. 读出桶头指针（此时大多已到缓存），预取链表首节点
+    //   3. 沿链比较
+    // 同一组内的访存未命中相互重叠，而不是像逐个find那样串行等待"桶槽位->节点"两次未命中
+    // emit(i, node)：第i个键的查找结果，未找到时node为nullptr
+    template <typename Emit>
+    void lookup_batch(const Key* keys, size_t n, Emit emit) {
+        rehash_step(kRehashStepBuckets);
+        size_t hashes[kBatchGroup];
+        size_t indexes[kBatchGroup];
+        Node* heads[kBatchGroup];
+        for (size_t base = 0; base < n; base += kBatchGroup) {
+            size_t m = n - base < kBatchGroup ? n - base : kBatchGroup;
+            for (size_t j = 0; j < m; ++j) {
+                hashes[j] = hash_func(keys[base + j]);
+                indexes[j] = bucket_policy_.index(hashes[j]);
+                prefetch_read(&buckets[indexes[j]]);
+            }
+            for (size_t j = 0; j < m; ++j) {
+                heads[j] = buckets[indexes[j]];
+                prefetch_read(heads[j]);
+            }
+            for (size_t j = 0; j < m; ++j) {
+                auto match = key_matcher(keys[base + j], hashes[j]);
+                Node* found = nullptr;
+                for (Node* curr = heads[j]; curr; curr = curr->next) {
+                    if (match(curr)) {
+                        found = curr;
+                        break;
+                    }
+                }
+                // 渐进式rehash进行中：新表没有时再查旧表（不预取，迁移期很短）
+                if (found == nullptr && old_buckets_) {
+                    for (Node* curr = old_buckets_[old_policy_.index(hashes[j])]; curr; curr = curr->next) {
+                        if (match(curr)) {
+                            found = curr;
+                            break;
+                        }
+                    }
+                }
+                emit(base + j, found);
+            }
+        }
+    }
+
+    // 从table[idx]链表中摘下第一个满足match的节点（不释放），没有则返回nullptr
+    template <typename Match>
+    Node* detach_node(Node** table, size_t idx, Match match) {
+        Node* curr = table[idx];
+        Node* prev = nullptr;
+
+        // 遍历链表查找目标节点
+        while (curr) {
+            if (match(curr)) {
+                if (prev == nullptr) {
+                    table[idx] = curr->next; // 删除头节点
+                } else {
+                    prev->next = curr->next; // 删除中间或尾节点
+                }
+                curr->next = nullptr;
+                size_--;
+                return curr;
+            }
+            prev = curr;
+            curr = curr->next;
+        }
+        return nullptr;
+    }
+
+    // 从新表（以及迁移中的旧表）摘下满足match的节点
+    template <typename Match>
+    Node* detach_matching(size_t hash_val, Match match) {
+        Node* node = detach_node(buckets, bucket_policy_.index(hash_val), match);
+        if (node == nullptr && old_buckets_) {
+            node = detach_node(old_buckets_, old_policy_.index(hash_val), match);
+        }
+        return node;
+    }
+
+    // 摘除并释放满足match的节点
+    template <typename Match>
+    bool unlink_node(Node** table, size_t idx, Match match) {
+        Node* node = detach_node(table, idx, match);
+        if (node == nullptr) {
+            return false;
+        }
+        destroy_node(node);
+        return true;
+    }
+
+    // 释放table中所有链表节点
+    // 分配策略支持整体释放时只析构节点、不逐个归还内存；节点可平凡析构时连遍历链表都省掉
+    void destroy_chains(Node** table, size_t count) {
+        for (size_t i = 0; i < count; ++i) {
+            if (!NodeAllocator<Node>::kReleaseAll || !std::is_trivially_destructible<Node>::value) {
+                Node* curr = table[i];
+                while (curr) {
+                    Node* next = curr->next;
+                    if (NodeAllocator<Node>::kReleaseAll) {
+                        curr->~Node();
+                    } else {
+                        destroy_node(curr);
+                    }
+                    curr = next;
+                }
+            }
+            table[i] = nullptr;
+        }
+    }
+
+    // 确定要插入新节点后再检查负载，超限时扩容（键已存在时不会白白扩容）
+    void grow_if_needed() {
+        if (size_ >= max_load_factor_ * bucket_count_) {
+            if (incremental_rehash_) {
+                start_incremental_rehash();
+            } else {
+                rehash();
+            }
+        }
+    }
+
+    // 把新节点头插到新表中（扩容只改变桶下标，用已算好的哈希值重新定位即可，不必再走一遍链表）
+    void link_new_node(Node* node, size_t hash_val) {
+        node->store_hash(hash_val);
+        size_t idx = bucket_policy_.index(hash_val);
+        node->next = buckets[idx];
+        buckets[idx] = node;
+        size_++;
+    }
+
+    // 单次探测的插入核心：哈希只算一次、链表只走一次，键不存在时才用args原地构造值
+    // 返回{节点, 是否新插入}
+    template <typename K, typename... Args>
+    std::pair<Node*, bool> emplace_unique(K&& key, Args&&... args) {
+        if constexpr (kStringKey) {
+            return emplace_string(key, my_strlen(key), std::forward<Args>(args)...);
+        } else {
+            rehash_step(kRehashStepBuckets);
+            size_t hash_val = hash_func(key);
+            Node* exist = find_node(key, hash_val);
+            if (exist) {
+                return {exist, false};
+            }
+            grow_if_needed();
+            Node* new_node = create_node(std::forward<K>(key), std::forward<Args>(args)...);
+            link_new_node(new_node, hash_val);
+            return {new_node, true};
+        }
+    }
+
+    // char*键的插入核心：键字节连同长度、哈希一起存入StringArena
+    template <typename... Args>
+    std::pair<Node*, bool> emplace_string(const char* data, size_t len, Args&&... args) {
+        rehash_step(kRehashStepBuckets);
+        size_t hash_val = hash_func(data, len);
+        Node* exist = find_node_if(hash_val, string_matcher(data, len, hash_val));
+        if (exist) {
+            return {exist, false};
+        }
+        grow_if_needed();
+        Node* new_node = create_node(key_arena_.intern(data, len, hash_val), std::forward<Args>(args)...);
+        link_new_node(new_node, hash_val);
+        return {new_node, true};
+    }
+
+    // 写出快照：键和值都是定长记录时整条拷进写入端的块里，否则交给序列化器
+    template <typename KeySer, typename ValSer, typename Sink>
+    bool save_snapshot(Sink& sink) const {
+        constexpr bool raw = KeySer::kRaw && ValSer::kRaw;
+        static_assert(!(raw && kStringKey), "char*键不能按定长记录保存");
+        SnapshotWriter<Sink> writer(sink);
+        if (!writer.begin(make_snapshot_header(kSnapshotKindMap, raw, sizeof(Key), sizeof(Value), size_))) {
+            return false;
+        }
+        bool ok = true;
+        for_each([&writer, &ok](const Key& key, const Value& value) {
+            if constexpr (raw) {
+                unsigned char* p = writer.reserve(sizeof(Key) + sizeof(Value));
+                memcpy(p, &key, sizeof(Key));
+                memcpy(p + sizeof(Key), &value, sizeof(Value));
+            } else {
+                ok = ok && KeySer::save(writer, key) && ValSer::save(writer, value);
+            }
+        });
+        return writer.finish() && ok;
+    }
+
+    // 读回快照：先读进一个临时容器，全部成功后再与本容器交换，失败时本容器保持不变
+    template <typename KeySer, typename ValSer, typename Source>
+    bool load_snapshot(Source& source) {
+        MyUnorderedMap staging(11, max_load_factor_);
+        staging.hash_func = hash_func;
+        staging.key_eq = key_eq;
+        if (!staging.template read_snapshot<KeySer, ValSer>(source)) {
+            return false;
+        }
+        clear();
+        swap_storage(staging);
+        return true;
+    }
+
+    // 把快照读进空容器。头部的元素个数不可信：桶按流中实际能容纳的记录数预留，
+    // 流长度未知时读到新块再翻倍扩大（不超过头部的个数）。
+    // 定长记录直接建节点头插，插入前查一次重：save写出的键互不相同，重复说明快照损坏，直接拒绝；
+    // 其他情况读出键值后正常插入
+    template <typename KeySer, typename ValSer, typename Source>
+    bool read_snapshot(Source& source) {
+        constexpr bool raw = KeySer::kRaw && ValSer::kRaw;
+        static_assert(!(raw && kStringKey), "char*键不能按定长记录加载");
+        constexpr size_t kRecordBytes = raw ? sizeof(Key) + sizeof(Value) : 1;
+        SnapshotReader<Source> reader(source);
+        SnapshotHeader header;
+        if (!reader.begin(header) ||
+            !snapshot_header_matches(header, kSnapshotKindMap, raw, sizeof(Key), sizeof(Value))) {
+            return false;
+        }
+        uint64_t reserved = header.count > 0 ? reader.record_bound(header.count, kRecordBytes) : 0;
+        reserve(static_cast<size_t>(reserved));
+        typename KeySer::load_type key{}; // 读出缓冲在各条记录间复用（字符串的容量不必每条重新分配）
+        typename ValSer::load_type value{};
+        for (uint64_t i = 0; i < header.count; ++i) {
+            if constexpr (raw) {
+                if (i == reserved) {
+                    uint64_t in_stream = i + reader.available() / kRecordBytes;
+                    reserved = std::min<uint64_t>(header.count, std::max<uint64_t>(reserved * 2, in_stream));
+                    reserve(static_cast<size_t>(reserved));
+                }
+                const unsigned char* p = reader.take(kRecordBytes);
+                if (p == nullptr) {
+                    return false;
+                }
+                Key raw_key;
+                Value raw_value;
+                memcpy(&raw_key, p, sizeof(Key));
+                memcpy(&raw_value, p + sizeof(Key), sizeof(Value));
+                size_t hash_val = hash_func(raw_key);
+                if (find_node(raw_key, hash_val) != nullptr) {
+                    return false;
+                }
+                link_new_node(create_node(raw_key, raw_value), hash_val);
+            } else {
+                if (!KeySer::load(reader, key) || !ValSer::load(reader, value)) {
+                    return false;
+                }
+                if constexpr (kStringKey) {
+                    emplace_string(key.data(), key.size(), std::move(value));
+                } else {
+                    emplace_unique(Key(std::move(key)), std::move(value));
+                }
+            }
+        }
+        return reader.finish();
+    }
+
+    // 与other交换全部元素及其存储（桶数组、节点内存、键字节、进行中的rehash），
+    // 哈希/比较函数对象一并交换；健康度统计和渐进式rehash开关各自保留
+    void swap_storage(MyUnorderedMap& other) noexcept {
+        std::swap(buckets, other.buckets);
+        std::swap(size_, other.size_);
+        std::swap(bucket_count_, other.bucket_count_);
+        std::swap(hash_func, other.hash_func);
+        std::swap(key_eq, other.key_eq);
+        std::swap(bucket_policy_, other.bucket_policy_);
+        std::swap(node_alloc_, other.node_alloc_);
+        key_arena_.swap(other.key_arena_);
+        std::swap(old_buckets_, other.old_buckets_);
+        std::swap(old_bucket_count_, other.old_bucket_count_);
+        std::swap(old_policy_, other.old_policy_);
+        std::swap(migrate_pos_, other.migrate_pos_);
+        std::swap(incremental_rehash_ns_, other.incremental_rehash_ns_);
+        std::swap(incremental_rehash_size_, other.incremental_rehash_size_);
+    }
+
+    // 在threads个线程上执行fn(t)，t = 0..threads-1；第0份在调用线程上执行
+    template <typename Fn>
+    static void run_parallel(unsigned threads, Fn fn) {
+        std::unique_ptr<std::thread[]> workers(new std::thread[threads]);
+        for (unsigned t = 1; t < threads; ++t) {
+            workers[t] = std::thread(fn, t);
+        }
+        fn(0u);
+        for (unsigned t = 1; t < threads; ++t) {
+            workers[t].join();
+        }
     }
 
 public:
-    // 构造函数（初始桶数量为11，小质数）
+    // 构造函数（初始桶数量为11，实际桶数由策略向上取整）
     MyUnorderedMap(size_t initial_buckets = 11, float max_load = 0.75f)
         : max_load_factor_(max_load), size_(0) {
-        bucket_count_ = next_prime(initial_buckets);
+        bucket_count_ = bucket_policy_.reset(initial_buckets);
         // 分配桶数组并初始化为nullptr（calloc会初始化为0）
-        buckets = (Node**)calloc(bucket_count_, sizeof(Node*));
-        if (buckets == nullptr) {
-            std::cerr << "内存分配失败！" << std::endl;
-            exit(1);
-        }
+        buckets = allocate_buckets(bucket_count_);
     }
 
     // 析构函数，释放所有节点和桶数组内存
@@ -226,91 +668,464 @@ public:
         buckets = nullptr;
     }
 
-    // 清空所有元素
+    // 清空所有元素（进行中的渐进式rehash一并终止）
     void clear() {
-        for (size_t i = 0; i < bucket_count_; ++i) {
-            Node* curr = buckets[i];
-            while (curr) {
-                Node* next = curr->next;
-                delete curr;
-                curr = next;
-            }
-            buckets[i] = nullptr;
+        destroy_chains(buckets, bucket_count_);
+        if (old_buckets_) {
+            destroy_chains(old_buckets_, old_bucket_count_);
+            free(old_buckets_);
+            old_buckets_ = nullptr;
+            old_bucket_count_ = 0;
         }
+        node_alloc_.release_all(); // 按slab整体归还节点内存
+        key_arena_.clear(); // char*键的字节随arena一起释放
         size_ = 0;
     }
 
+    // 开启/关闭渐进式rehash：开启后扩容不再一次迁移全部节点，而是分摊到之后的insert/find/erase中
+    void incremental_rehash(bool enable) {
+        incremental_rehash_ = enable;
+        if (!enable && old_buckets_) {
+            rehash_step(old_bucket_count_);
+        }
+    }
+
+    bool incremental_rehash() const {
+        return incremental_rehash_;
+    }
+
+    // 是否有尚未迁移完的旧桶数组
+    bool is_rehashing() const {
+        return old_buckets_ != nullptr;
+    }
+
+    // ------- 节点句柄：extract摘下的节点，可以改值后重新插入，期间不释放也不复制 ------- //
+    // 句柄不能比所属容器活得更久，也不能跨过所属容器的clear()（节点内存和char*键的字节都归容器所有）
+    class node_handle {
+    public:
+        node_handle() = default;
+
+        node_handle(node_handle&& other) noexcept : node_(other.node_), owner_(other.owner_) {
+            other.node_ = nullptr;
+            other.owner_ = nullptr;
+        }
+
+        node_handle& operator=(node_handle&& other) noexcept {
+            if (this != &other) {
+                reset();
+                node_ = other.node_;
+                owner_ = other.owner_;
+                other.node_ = nullptr;
+                other.owner_ = nullptr;
+            }
+            return *this;
+        }
+
+        node_handle(const node_handle&) = delete;
+        node_handle& operator=(const node_handle&) = delete;
+
+        // 句柄被丢弃时把节点还给所属容器
+        ~node_handle() {
+            reset();
+        }
+
+        bool empty() const {
+            return node_ == nullptr;
+        }
+
+        explicit operator bool() const {
+            return node_ != nullptr;
+        }
+
+        const Key& key() const {
+            return node_->key;
+        }
+
+        Value& mapped() const {
+            return node_->value;
+        }
+
+    private:
+        friend class MyUnorderedMap;
+
+        Node* node_ = nullptr;
+        MyUnorderedMap* owner_ = nullptr;
+
+        node_handle(Node* node, MyUnorderedMap* owner) : node_(node), owner_(owner) {}
+
+        void reset() {
+            if (node_) {
+                owner_->destroy_node(node_);
+                node_ = nullptr;
+                owner_ = nullptr;
+            }
+        }
+    };
+
     // 插入或更新键值对
     void insert(const Key& key, const Value& value) {
-        // 检查是否需要扩容
-        if (size_ >= max_load_factor_ * bucket_count_) {
-            rehash();
+        insert_or_assign(key, value);
+    }
+
+    // 键不存在时用args原地构造值并插入；键已存在时什么都不做（args不会被移走）
+    // 返回{值的指针, 是否新插入}
+    template <typename... Args>
+    std::pair<Value*, bool> try_emplace(const Key& key, Args&&... args) {
+        auto result = emplace_unique(key, std::forward<Args>(args)...);
+        return {&result.first->value, result.second};
+    }
+
+    template <typename... Args>
+    std::pair<Value*, bool> try_emplace(Key&& key, Args&&... args) {
+        auto result = emplace_unique(std::move(key), std::forward<Args>(args)...);
+        return {&result.first->value, result.second};
+    }
+
+    // 键不存在时插入，已存在时赋值；整个过程只探测一次
+    template <typename V>
+    std::pair<Value*, bool> insert_or_assign(const Key& key, V&& value) {
+        auto result = emplace_unique(key, std::forward<V>(value));
+        if (!result.second) {
+            result.first->value = std::forward<V>(value);
         }
+        return {&result.first->value, result.second};
+    }
 
-        // 计算桶索引
-        size_t idx = hash_func(key) % bucket_count_;
-        Node* curr = buckets[idx];
-        // 检查键是否已存在，若存在则更新值
-        while (curr) {
-            if (key_eq(curr->key, key)) {
-                curr->value = value; // 更新值
-                return;
+    template <typename V>
+    std::pair<Value*, bool> insert_or_assign(Key&& key, V&& value) {
+        auto result = emplace_unique(std::move(key), std::forward<V>(value));
+        if (!result.second) {
+            result.first->value = std::forward<V>(value);
+        }
+        return {&result.first->value, result.second};
+    }
+
+    // 与try_emplace相同：值由args原地构造，键已存在时不构造值、也不覆盖
+    template <typename K, typename... Args>
+    std::pair<Value*, bool> emplace(K&& key, Args&&... args) {
+        auto result = emplace_unique(std::forward<K>(key), std::forward<Args>(args)...);
+        return {&result.first->value, result.second};
+    }
+
+    // 预留至少能放下n个元素的桶，之后插入n个元素不会再触发rehash
+    void reserve(size_t n) {
+        size_t need = static_cast<size_t>(n / max_load_factor_) + 1;
+        if (need > bucket_count_) {
+            rehash(need);
+        }
+    }
+
+    // 批量建表：把[first, last)中的键值对（有.first/.second，随机访问迭代器）插入容器，已有的键被覆盖，
+    // 区间内重复的键以靠后的为准，结果与逐个insert相同。
+    // 1. 按 size() + 区间长度 一次预留桶，整个过程不再rehash
+    // 2. 各线程分段计算哈希，按桶下标所在的区间（threads段，与桶策略无关）统计直方图
+    // 3. 前缀和后各线程把元素下标分散到各自分区（分区内保持输入顺序）
+    // 4. 每个线程独占一段桶：在私有的节点分配器上建节点、直接链入这些桶，无需加锁；
+    //    最后把各线程的分配器并入容器的分配器，累加元素数
+    // char*键的字节要进StringArena（非线程安全），threads <= 1或元素很少时都退化为逐个insert。
+    template <typename RandomIt>
+    void bulk_build(RandomIt first, RandomIt last, unsigned threads = 1) {
+        size_t n = static_cast<size_t>(std::distance(first, last));
+        if (n == 0) {
+            return;
+        }
+        if (old_buckets_) {
+            rehash_step(old_bucket_count_); // 先完成进行中的渐进式迁移，之后只有一张表
+        }
+        reserve(size_ + n);
+        if (kStringKey || threads <= 1 || n < kBulkParallelMin) {
+            for (RandomIt it = first; it != last; ++it) {
+                insert_or_assign(it->first, it->second);
             }
-            curr = curr->next;
+            return;
         }
-        // 不存在则插入新节点到链表头部
-        Node* new_node = new Node(key, value);
-        new_node->next = buckets[idx];
-        buckets[idx] = new_node;
-        size_++;
+        if (threads > kBulkMaxThreads) {
+            threads = kBulkMaxThreads;
+        }
+
+        // 每个元素的哈希与所属分区；hist[t * threads + p]为第t段输入落入分区p的元素数
+        std::unique_ptr<size_t[]> hashes(new size_t[n]);
+        std::unique_ptr<uint16_t[]> parts(new uint16_t[n]);
+        std::unique_ptr<size_t[]> order(new size_t[n]);
+        std::unique_ptr<size_t[]> hist(new size_t[threads * threads]());
+        std::unique_ptr<size_t[]> part_begin(new size_t[threads + 1]);
+        std::unique_ptr<size_t[]> added(new size_t[threads]());
+        std::unique_ptr<NodeAllocator<Node>[]> allocs(new NodeAllocator<Node>[threads]);
+        auto chunk_begin = [n, threads](unsigned t) { return n * t / threads; };
+
+        run_parallel(threads, [&](unsigned t) {
+            size_t* my_hist = &hist[t * threads];
+            for (size_t i = chunk_begin(t); i < chunk_begin(t + 1); ++i) {
+                size_t h = hash_func(first[i].first);
+                // 桶下标按区间均分给各线程：bucket * threads / bucket_count
+                size_t p = bucket_policy_.index(h) * threads / bucket_count_;
+                hashes[i] = h;
+                parts[i] = static_cast<uint16_t>(p);
+                ++my_hist[p];
+            }
+        });
+
+        // 前缀和：分区p的元素在order中连续，分区内按输入段t的顺序排列；hist改写为各段在分区中的写入起点
+        size_t offset = 0;
+        for (unsigned p = 0; p < threads; ++p) {
+            part_begin[p] = offset;
+            for (unsigned t = 0; t < threads; ++t) {
+                size_t count = hist[t * threads + p];
+                hist[t * threads + p] = offset;
+                offset += count;
+            }
+        }
+        part_begin[threads] = offset;
+
+        run_parallel(threads, [&](unsigned t) {
+            size_t* cursor = &hist[t * threads];
+            for (size_t i = chunk_begin(t); i < chunk_begin(t + 1); ++i) {
+                order[cursor[parts[i]]++] = i;
+            }
+        });
+
+        run_parallel(threads, [&](unsigned p) {
+            NodeAllocator<Node>& alloc = allocs[p];
+            size_t count = 0;
+            for (size_t k = part_begin[p]; k < part_begin[p + 1]; ++k) {
+                size_t i = order[k];
+                size_t h = hashes[i];
+                size_t idx = bucket_policy_.index(h);
+                const Key& key = first[i].first;
+                Node* node = buckets[idx];
+                while (node && !(node->hash_may_equal(h) && key_eq(node->key, key))) {
+                    node = node->next;
+                }
+                if (node) {
+                    node->value = first[i].second;
+                    continue;
+                }
+                node = new (alloc.allocate()) Node(key, first[i].second);
+                node->store_hash(h);
+                node->next = buckets[idx];
+                buckets[idx] = node;
+                ++count;
+            }
+            added[p] = count;
+        });
+
+        for (unsigned p = 0; p < threads; ++p) {
+            node_alloc_.splice(allocs[p]);
+            size_ += added[p];
+        }
+    }
+
+    // 摘下键对应的节点交给句柄（节点不释放、值不移动），键不存在时返回空句柄
+    node_handle extract(const Key& key) {
+        rehash_step(kRehashStepBuckets);
+        Node* node;
+        if constexpr (kStringKey) {
+            size_t len = my_strlen(key);
+            size_t hash_val = hash_func(key, len);
+            node = detach_matching(hash_val, string_matcher(key, len, hash_val));
+        } else {
+            size_t hash_val = hash_func(key);
+            node = detach_matching(hash_val, key_matcher(key, hash_val));
+        }
+        return node_handle(node, node ? this : nullptr);
+    }
+
+    // 插入句柄中的节点：成功后句柄变空；键已存在时不插入，句柄保持原样
+    // 来自本容器的节点直接重新挂链；来自其他容器的节点（内存归对方所有）则移出键值重新构造
+    std::pair<Value*, bool> insert(node_handle&& handle) {
+        if (handle.empty()) {
+            return {nullptr, false};
+        }
+        Node* node = handle.node_;
+        if (handle.owner_ != this) {
+            std::pair<Node*, bool> result;
+            if constexpr (kStringKey) {
+                result = emplace_string(node->key, StringArena::length(node->key), std::move(node->value));
+            } else {
+                result = emplace_unique(std::move(node->key), std::move(node->value));
+            }
+            if (result.second) {
+                handle.reset();
+            }
+            return {&result.first->value, result.second};
+        }
+        rehash_step(kRehashStepBuckets);
+        size_t hash_val = node_hash(node);
+        Node* exist = find_node(node->key, hash_val);
+        if (exist) {
+            return {&exist->value, false};
+        }
+        grow_if_needed();
+        link_new_node(node, hash_val);
+        handle.node_ = nullptr;
+        handle.owner_ = nullptr;
+        return {&node->value, true};
     }
 
     // 查找键：返回值的指针，不存在则返回nullptr
     Value* find(const Key& key) {
-        size_t idx = hash_func(key) % bucket_count_;
-        Node* curr = buckets[idx];
-        while (curr) {
-            if (key_eq(curr->key, key)) {
-                return &(curr->value);
-            }
-            curr = curr->next;
+        if constexpr (kStringKey) {
+            return find(key, my_strlen(key));
         }
-        return nullptr;
+        rehash_step(kRehashStepBuckets);
+        size_t hash_val = hash_func(key);
+        Node* node = find_node(key, hash_val);
+        if (monitor_.sample_find()) {
+            monitor_.record_probe(probe_length(hash_val, key_matcher(key, hash_val)));
+        }
+        return node ? &(node->value) : nullptr;
+    }
+
+    // 批量查找：out[i]为keys[i]对应值的指针，不存在则为nullptr
+    // 与逐个调用find结果相同，但整批分组预取，适合大表上成批探测（如哈希连接的探测阶段）
+    void find_batch(const Key* keys, size_t n, Value** out) {
+        lookup_batch(keys, n, [out](size_t i, Node* node) { out[i] = node ? &(node->value) : nullptr; });
+    }
+
+    // 批量判断键是否存在：out[i]表示keys[i]是否存在，返回存在的键个数
+    size_t contains_batch(const Key* keys, size_t n, bool* out) {
+        size_t hits = 0;
+        lookup_batch(keys, n, [out, &hits](size_t i, Node* node) {
+            out[i] = node != nullptr;
+            hits += node != nullptr;
+        });
+        return hits;
     }
 
     // 删除键，成功返回true，失败返回false
     bool erase(const Key& key) {
-        size_t idx = hash_func(key) % bucket_count_;
-        Node* curr = buckets[idx];
-        Node* prev = nullptr;
+        if constexpr (kStringKey) {
+            return erase(key, my_strlen(key));
+        }
+        rehash_step(kRehashStepBuckets);
+        size_t hash_val = hash_func(key);
+        auto match = key_matcher(key, hash_val);
+        if (unlink_node(buckets, bucket_policy_.index(hash_val), match)) {
+            return true;
+        }
+        return old_buckets_ != nullptr && unlink_node(old_buckets_, old_policy_.index(hash_val), match);
+    }
 
-        // 遍历链表查找目标节点
-        while (curr) {
-            if (key_eq(curr->key, key)) {
-                if (prev == nullptr) {
-                    buckets[idx] = curr->next; // 删除头节点
-                } else {
-                    prev->next = curr->next; // 删除中间或尾节点
-                }
-                delete curr;
-                size_--;
-                return true;
-            }
-            prev = curr;
-            curr = curr->next;
+    // ------- 仅char*键可用：按(指针, 长度)或string_view操作，data不需要以'\0'结尾，也不会被复制 ------- //
+    // 要求Hash提供operator()(const char*, size_t)，且与operator()(const char*)结果一致
+    template <typename K = Key, typename = typename std::enable_if<std::is_same<K, char*>::value>::type>
+    void insert(std::string_view key, const Value& value) {
+        auto result = emplace_string(key.data(), key.size(), value);
+        if (!result.second) {
+            result.first->value = value;
+        }
+    }
+
+    template <typename K = Key, typename = typename std::enable_if<std::is_same<K, char*>::value>::type,
+              typename... Args>
+    std::pair<Value*, bool> try_emplace(std::string_view key, Args&&... args) {
+        auto result = emplace_string(key.data(), key.size(), std::forward<Args>(args)...);
+        return {&result.first->value, result.second};
+    }
+
+    template <typename K = Key, typename = typename std::enable_if<std::is_same<K, char*>::value>::type>
+    Value* find(const char* data, size_t len) {
+        rehash_step(kRehashStepBuckets);
+        size_t hash_val = hash_func(data, len);
+        Node* node = find_node_if(hash_val, string_matcher(data, len, hash_val));
+        if (monitor_.sample_find()) {
+            monitor_.record_probe(probe_length(hash_val, string_matcher(data, len, hash_val)));
+        }
+        return node ? &(node->value) : nullptr;
+    }
+
+    template <typename K = Key, typename = typename std::enable_if<std::is_same<K, char*>::value>::type>
+    Value* find(std::string_view key) {
+        return find(key.data(), key.size());
+    }
+
+    template <typename K = Key, typename = typename std::enable_if<std::is_same<K, char*>::value>::type>
+    bool erase(const char* data, size_t len) {
+        rehash_step(kRehashStepBuckets);
+        size_t hash_val = hash_func(data, len);
+        auto match = string_matcher(data, len, hash_val);
+        if (unlink_node(buckets, bucket_policy_.index(hash_val), match)) {
+            return true;
         }
-        return false;
+        return old_buckets_ != nullptr && unlink_node(old_buckets_, old_policy_.index(hash_val), match);
+    }
+
+    template <typename K = Key, typename = typename std::enable_if<std::is_same<K, char*>::value>::type>
+    bool erase(std::string_view key) {
+        return erase(key.data(), key.size());
     }
 
     // 重载操作符[]，用于插入或访问元素
+    // 不存在则原地值初始化一个Value（要求可默认构造），只探测一次
     Value& operator[](const Key& key) {
-        Value* val = find(key);
-        if (val) {
-            return *val;
+        return *try_emplace(key).first;
+    }
+
+    Value& operator[](Key&& key) {
+        return *try_emplace(std::move(key)).first;
+    }
+
+    // 遍历所有键值对（顺序不确定），fn(const Key&, const Value&)；遍历期间不能修改容器
+    template <typename Fn>
+    void for_each(Fn fn) const {
+        for (size_t i = 0; i < bucket_count_; ++i) {
+            for (const Node* curr = buckets[i]; curr; curr = curr->next) {
+                fn(curr->key, curr->value);
+            }
         }
-        // 不存在则插入默认值（假设Value类型可默认构造）
-        insert(key, Value());
-        return *find(key); // *用于解引用指针，获得值引用
+        for (size_t i = 0; old_buckets_ && i < old_bucket_count_; ++i) {
+            for (const Node* curr = old_buckets_[i]; curr; curr = curr->next) {
+                fn(curr->key, curr->value);
+            }
+        }
+    }
+
+    // ------- 二进制快照（格式见hash_snapshot.h） ------- //
+    // save写出全部键值对；load读回并替换容器原有内容，成功返回true，失败（读写出错、校验和不符、
+    // 快照被截断、头部个数与记录不符、键重复、快照的容器种类或键值大小与本容器不一致）返回false且容器不变。
+    // KeySer/ValSer是键/值的序列化器：默认定长类型直接写字节（load按流中实际的记录数预留桶，逐条头插），
+    // char*键写 长度 + 字节。保存和加载必须使用相同的序列化器。
+    template <typename KeySer = SnapshotSerializer<Key>, typename ValSer = SnapshotSerializer<Value>>
+    bool save(std::ostream& os) const {
+        OstreamSnapshotSink sink{os};
+        return save_snapshot<KeySer, ValSer>(sink);
+    }
+
+    template <typename KeySer = SnapshotSerializer<Key>, typename ValSer = SnapshotSerializer<Value>>
+    bool save(int fd) const {
+        FdSnapshotSink sink{fd};
+        return save_snapshot<KeySer, ValSer>(sink);
+    }
+
+    template <typename KeySer = SnapshotSerializer<Key>, typename ValSer = SnapshotSerializer<Value>>
+    bool load(std::istream& is) {
+        IstreamSnapshotSource source{is};
+        return load_snapshot<KeySer, ValSer>(source);
+    }
+
+    template <typename KeySer = SnapshotSerializer<Key>, typename ValSer = SnapshotSerializer<Value>>
+    bool load(int fd) {
+        FdSnapshotSource source{fd};
+        return load_snapshot<KeySer, ValSer>(source);
+    }
+
+    // 健康度快照：桶分布现场统计（O(桶数)），探测长度与rehash记录来自运行期采样
+    // 渐进式rehash进行中时，桶分布只统计新表
+    HashTableStats stats() const {
+        HashTableStats out;
+        monitor_.fill(out, size_, bucket_count_, [this](size_t i) {
+            size_t len = 0;
+            for (const Node* curr = buckets[i]; curr; curr = curr->next) {
+                ++len;
+            }
+            return len;
+        });
+        return out;
+    }
+
+    // 清零探测长度统计，开始新的观察窗口
+    void reset_probe_stats() {
+        monitor_.reset_probes();
     }
 
     // 获取当前元素数量
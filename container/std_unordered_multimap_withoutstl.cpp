@@ -2,13 +2,52 @@
 #include <functional>
 #include <cstddef> // size_t
 #include <cstdlib> // for std::malloc, std::free
+#include <cstring> // memcpy（快照的定长记录）
+#include <iostream> // std::cerr（内存分配失败）
+#include <algorithm> // std::min、std::max
+#include <iterator> // std::forward_iterator_tag、std::iterator_traits、std::distance
+#include <new> // placement new
+#include <type_traits> // std::is_trivially_destructible、std::is_base_of
+#include <string> // std::string（DefaultMultimapHash特化）
+#include "hash_function.h" // 默认哈希函数（整数混合、字节串wyhash）
+#include "hash_bucket_policy.h" // 桶索引策略（质数表/2的幂掩码）
+#include "hash_node_allocator.h" // 节点分配策略（slab/逐个new）
+#include "hash_code_cache.h" // 节点中可选缓存的完整哈希值
+#include "bucket_bitmap.h" // 非空桶位图（迭代时用tzcnt跳过空桶）
+#include "hash_snapshot.h" // 二进制快照（save/load）
+#include "std_vector_withoutstl_completeversion.cpp" // MyVector（按键分组布局中每个键的值数组）
+
+// ------- 默认哈希函数 ------- //
+// std::hash对整数是恒等映射、对字符串的质量依实现而定；这里统一换成hash_function.h中的实现：
+// 整数/枚举经fmix64混合，字符串用wyhash，其他类型在std::hash的结果上再混合一次
+template <typename Key, typename = void>
+struct DefaultMultimapHash {
+    size_t operator()(const Key& key) const {
+        return hash_finalize_mix(std::hash<Key>()(key));
+    }
+};
+
+template <typename Key>
+struct DefaultMultimapHash<Key, std::enable_if_t<std::is_integral<Key>::value || std::is_enum<Key>::value>> {
+    size_t operator()(const Key& key) const {
+        return hash_finalize_mix(static_cast<size_t>(key));
+    }
+};
+
+template <>
+struct DefaultMultimapHash<std::string> {
+    size_t operator()(const std::string& key) const {
+        return hash_bytes(key.data(), key.size());
+    }
+};
 
 // ------- 自定义的独立节点结构体 ------- //
-template <typename Key, typename T>
-struct MyUnorderedMultimapNode {
-    using value_type = std:::pair<const Key, T>;
+// CacheHash为true时基类里多存一份完整哈希值，见hash_code_cache.h
+template <typename Key, typename T, bool CacheHash = false>
+struct MyUnorderedMultimapNode : CachedHashCode<CacheHash> {
+    using value_type = std::pair<const Key, T>;
     value_type value; // 键值对
-    MyUnorderedMultimapNode* next;
+    MyUnorderedMultimapNode* prev;
     MyUnorderedMultimapNode* next;
 
     // 完美转发构造：支持左值/右值键值对
@@ -44,26 +83,29 @@ struct MyUnorderedMultimapNode {
 };
 
 // 前置声明（提前声明MyUnorderedMultimap类，以便在iterator中使用）
-template <typename Key, typename T, typename Hash, typename KeyEqual>
+template <typename Key, typename T, typename Hash, typename KeyEqual, typename BucketPolicy,
+          template <typename> class NodeAllocator, bool CacheHash>
 class MyUnorderedMultimap;
 
 // ------- 自定义独立的迭代器类 ------- //
-template <typename Key, typename T, typename Hash = std::hash<Key>, typename KeyEqual = std::equal_to<Key>>
+template <typename Key, typename T, typename Hash = DefaultMultimapHash<Key>, typename KeyEqual = std::equal_to<Key>,
+          typename BucketPolicy = PrimeBucketPolicy, template <typename> class NodeAllocator = SlabNodeAllocator,
+          bool CacheHash = false>
 class MyUnorderedMultimapIterator {
 private:
     // 指向当前节点（某个桶中的节点）
-    MyUnorderedMultimapNode<Key, T>* curr_; // 当前节点指针，即某个桶中的节点
+    MyUnorderedMultimapNode<Key, T, CacheHash>* curr_; // 当前节点指针，即某个桶中的节点
     // 指向所属容器（需要访问容器的私有成员，通过友元关系实现）
-    MyUnorderedMultimap<key, T, Hash, KeyEqual>* map_;
+    MyUnorderedMultimap<Key, T, Hash, KeyEqual, BucketPolicy, NodeAllocator, CacheHash>* map_;
+    // 当前节点所在的桶：跨桶时不必对节点的键重新求哈希，也不用等节点加载完才能找下一个非空桶
+    size_t bucket_;
 
 private:
     // 跨桶查找下一个非空桶的头节点
+    // 在非空桶位图中定位，空桶按64个一组跳过
     void find_next_non_empty_bucket(size_t curr_bucket) {
-        size_t i = curr_bucket + 1;
-        while (i < map_->buckets_.size() && map_->buckets_[i] == nullptr) {
-            ++i;
-        }
-        curr_ = (i < map_->buckets_.size()) ? map_->buckets_[i] : nullptr;
+        bucket_ = map_->occupied_.next(curr_bucket + 1);
+        curr_ = (bucket_ < map_->bucket_count_) ? map_->buckets_[bucket_] : nullptr;
     }
 
 public:
@@ -80,9 +122,16 @@ public:
 public:
     // 构造函数（仅允许容器类调用以创建迭代器）
     MyUnorderedMultimapIterator(
-        MyUnorderedMultimapNode<Key, T>* curr,
-        MyUnorderedMultimap<Key, T, Hash, KeyEqual>* map)
-        : curr_(curr), map_(map) {}
+        MyUnorderedMultimapNode<Key, T, CacheHash>* curr,
+        MyUnorderedMultimap<Key, T, Hash, KeyEqual, BucketPolicy, NodeAllocator, CacheHash>* map)
+        : curr_(curr), map_(map), bucket_(curr ? map->node_bucket_idx(curr) : 0) {}
+
+    // 调用方已知节点所在的桶
+    MyUnorderedMultimapIterator(
+        MyUnorderedMultimapNode<Key, T, CacheHash>* curr,
+        MyUnorderedMultimap<Key, T, Hash, KeyEqual, BucketPolicy, NodeAllocator, CacheHash>* map,
+        size_t bucket)
+        : curr_(curr), map_(map), bucket_(bucket) {}
     
     // 解引用
     reference operator*() const { return curr_->value; } // 返回当前节点的值引用
@@ -93,8 +142,7 @@ public:
         if (curr_ && curr_->next != nullptr) {
             curr_ = curr_->next;
         } else {
-            size_t curr_bucket = map_->get_bucket_idx(curr_->value.first);
-            find_next_non_empty_bucket(curr_bucket);
+            find_next_non_empty_bucket(bucket_);
         }
         return *this;
     }
@@ -115,42 +163,102 @@ public:
     }
 
     // 允许容器类访问迭代器的私有成员
-    friend class MyUnorderedMultimap<Key, T, Hash, KeyEqual>;
+    friend class MyUnorderedMultimap<Key, T, Hash, KeyEqual, BucketPolicy, NodeAllocator, CacheHash>;
 };
 
 // ------- 自定义独立的无序多重映射类std_unordered_multimap ------- //
 template <
     typename Key,
     typename T,
-    typename Hash = std::hash<Key>,
-    typename KeyEqual = std::equal_to<Key>>
+    typename Hash = DefaultMultimapHash<Key>,
+    typename KeyEqual = std::equal_to<Key>,
+    typename BucketPolicy = PrimeBucketPolicy,
+    template <typename> class NodeAllocator = SlabNodeAllocator,
+    bool CacheHash = false> // 节点中缓存完整哈希值：rehash和迭代器跨桶时不再调用哈希函数，查找时先比哈希再比键
 class MyUnorderedMultimap {
 private:
     // 桶数组：存储节点指针（使用独立的Node类型）
-    MyUnorderedMultimapNode<Key, T>** buckets_;
+    MyUnorderedMultimapNode<Key, T, CacheHash>** buckets_;
     size_t bucket_count_; // 桶的数量
     size_t size_;         // 元素数量
     Hash hash_func_;      // 哈希函数
     KeyEqual equal_func_; // 键相等比较函数
     const float max_load_factor_ = 1.0f; // 最大负载因子
+    BucketPolicy bucket_policy_; // 桶索引策略
+    NodeAllocator<MyUnorderedMultimapNode<Key, T, CacheHash>> node_alloc_; // 节点分配策略
+    BucketBitmap occupied_; // 非空桶位图
 
 private:
     // 计算桶索引
     size_t get_bucket_idx(const Key& key) const {
-        return hash_func_(key) % bucket_count_;
+        return bucket_policy_.index(hash_func_(key));
     }
 
-    // 重哈希（扩容动态数组）
+    // 节点键的哈希值（开启CacheHash时直接取缓存，不再调用哈希函数）
+    size_t node_hash(const MyUnorderedMultimapNode<Key, T, CacheHash>* node) const {
+        if constexpr (CacheHash) {
+            return node->hash_code;
+        } else {
+            return hash_func_(node->value.first);
+        }
+    }
+
+    // 节点所在的桶
+    size_t node_bucket_idx(const MyUnorderedMultimapNode<Key, T, CacheHash>* node) const {
+        return bucket_policy_.index(node_hash(node));
+    }
+
+    // 从分配策略取内存并原地构造节点
+    template <typename... Args>
+    MyUnorderedMultimapNode<Key, T, CacheHash>* create_node(Args&&... args) {
+        return new (node_alloc_.allocate()) MyUnorderedMultimapNode<Key, T, CacheHash>(std::forward<Args>(args)...);
+    }
+
+    // 析构节点并把内存还给分配策略
+    void destroy_node(MyUnorderedMultimapNode<Key, T, CacheHash>* node) {
+        node->~MyUnorderedMultimapNode<Key, T, CacheHash>();
+        node_alloc_.deallocate(node);
+    }
+
+    // 分配并初始化桶数组，内存不足时返回nullptr
+    static MyUnorderedMultimapNode<Key, T, CacheHash>** allocate_buckets(size_t n) {
+        auto* buckets = static_cast<MyUnorderedMultimapNode<Key, T, CacheHash>**>(
+            std::malloc(n * sizeof(MyUnorderedMultimapNode<Key, T, CacheHash>*)));
+        if (buckets == nullptr) {
+            return nullptr;
+        }
+        for (size_t i = 0; i < n; ++i) {
+            buckets[i] = nullptr;
+        }
+        return buckets;
+    }
+
+    [[noreturn]] static void out_of_memory() {
+        std::cerr << "内存分配失败！" << std::endl;
+        exit(1);
+    }
+
+    // 重哈希（扩容动态数组），桶数组分配失败时报错退出（与MyUnorderedMap一致）
     void rehash(size_t new_bucket_count) {
+        if (!try_rehash(new_bucket_count)) {
+            out_of_memory();
+        }
+    }
+
+    // 重哈希，桶数组分配失败时返回false且容器不变
+    bool try_rehash(size_t new_bucket_count) {
         if (new_bucket_count <= bucket_count_) {
-            return;
+            return true;
         }
+        BucketPolicy new_policy;
+        new_bucket_count = new_policy.reset(new_bucket_count); // 向上取整到策略支持的桶数
         // 分配新桶数组
-        auto* new_buckets = static_cast<MyUnorderedMultimapNode<Key, T>**>(
-            std::malloc(new_bucket_count * sizeof(MyUnorderedMultimapNode<Key, T>*)));
-        for (size_t i = 0; i < new_bucket_count; ++i) {
-            new_buckets[i] = nullptr;
+        auto* new_buckets = allocate_buckets(new_bucket_count);
+        if (new_buckets == nullptr) {
+            return false;
         }
+        BucketBitmap new_occupied;
+        new_occupied.reset(new_bucket_count);
 
         // 数据迁移
         for (size_t i = 0; i < bucket_count_; ++i) {
@@ -159,7 +267,7 @@ private:
                 auto* next_node = curr->next; // 保存下一个节点
 
                 // 计算新桶索引
-                size_t new_idx = hash_func_(curr->value.first) % new_bucket_count;
+                size_t new_idx = new_policy.index(node_hash(curr));
                 // 头插法
                 curr->next = new_buckets[new_idx];
                 if (new_buckets[new_idx]) {
@@ -167,6 +275,7 @@ private:
                 }
                 curr->prev = nullptr;
                 new_buckets[new_idx] = curr;
+                new_occupied.set(new_idx);
 
                 curr = next_node; // 继续处理下一个节点
             }
@@ -176,34 +285,71 @@ private:
         free(buckets_);
         buckets_ = new_buckets;
         bucket_count_ = new_bucket_count;
+        bucket_policy_ = new_policy;
+        occupied_ = std::move(new_occupied);
+        return true;
+    }
+
+    // 能容纳n个元素的桶，分配失败时返回false
+    bool try_reserve(uint64_t n) {
+        return try_rehash(static_cast<size_t>(n / max_load_factor_) + 1);
+    }
+
+    // 把新节点链入桶：桶内已有相同的键时插到第一个相同键之后，保证相同键的节点相邻（equal_range依赖这一点），
+    // 否则头插
+    void link_grouped(MyUnorderedMultimapNode<Key, T, CacheHash>* new_node, size_t hash_val, size_t bucket_idx) {
+        auto* same = buckets_[bucket_idx];
+        while (same && !(same->hash_may_equal(hash_val) && equal_func_(same->value.first, new_node->value.first))) {
+            same = same->next;
+        }
+        if (same) {
+            new_node->prev = same;
+            new_node->next = same->next;
+            if (same->next) {
+                same->next->prev = new_node;
+            }
+            same->next = new_node;
+        } else {
+            // 头插法
+            new_node->next = buckets_[bucket_idx];
+            if (buckets_[bucket_idx]) {
+                buckets_[bucket_idx]->prev = new_node;
+            } else {
+                occupied_.set(bucket_idx); // 空桶变为非空
+            }
+            buckets_[bucket_idx] = new_node;
+        }
     }
 
 public:
     // 迭代器类型别名（使用独立的迭代器类型）
-    using iterator = MyUnorderedMultimapIterator<Key, T, Hash, KeyEqual>;
+    using iterator = MyUnorderedMultimapIterator<Key, T, Hash, KeyEqual, BucketPolicy, NodeAllocator, CacheHash>;
     using value_type = std::pair<const Key, T>;
 
     // 构造函数
     explicit MyUnorderedMultimap(
         size_t bucket_count = 16,
         const Hash& hash = Hash(),
-        const KeyEqual& equal = KeyEqual()) : bucket_count_(bucket_count),
-            size_(0),
+        const KeyEqual& equal = KeyEqual()) : size_(0),
             hash_func_(hash),
             equal_func_(equal) {
-        buckets_ = static_cast<MyUnorderedMultimapNode<Key, T>**>(
-            malloc(bucket_count_ * sizeof(MyUnorderedMultimapNode<Key, T>*)));
-        for (size_t i = 0; i < bucket_count_; ++i) {
-            buckets_[i] = nullptr;
+        bucket_count_ = bucket_policy_.reset(bucket_count); // 桶数由策略向上取整
+        buckets_ = allocate_buckets(bucket_count_);
+        if (buckets_ == nullptr) {
+            out_of_memory();
         }
+        occupied_.reset(bucket_count_);
     }
 
     // 移动构造
     MyUnorderedMultimap(MyUnorderedMultimap&& other) noexcept
         : buckets_(other.buckets_), bucket_count_(other.bucket_count_),
           size_(other.size_),
-          hash_func_(std::move(other.hash_func_),
-          equal_func_(std::move(other.equal_func_)) {
+          hash_func_(std::move(other.hash_func_)),
+          equal_func_(std::move(other.equal_func_)),
+          bucket_policy_(other.bucket_policy_),
+          node_alloc_(std::move(other.node_alloc_)),
+          occupied_(std::move(other.occupied_)) {
         other.buckets_ = nullptr;
         other.bucket_count_ = 0;
         other.size_ = 0;
@@ -220,6 +366,9 @@ public:
             size_ = other.size_;
             hash_func_ = std::move(other.hash_func_);
             equal_func_ = std::move(other.equal_func_);
+            bucket_policy_ = other.bucket_policy_;
+            node_alloc_ = std::move(other.node_alloc_); // 节点内存随slab一起转移
+            occupied_ = std::move(other.occupied_);
 
             other.buckets_ = nullptr;
             other.bucket_count_ = 0;
@@ -243,81 +392,130 @@ public:
     // 插入（完美转发）
     template <typename K, typename V>
     iterator insert(K&& key, V&& value) {
-        if (size_ + 1 > buckets_count_ * max_load_factor_) {
+        if (size_ + 1 > bucket_count_ * max_load_factor_) {
             rehash(bucket_count_ * 2);
         }
 
-        size_t bucket_idx = get_bucket_idx(key);
-        auto* new_node = new MyUnorderedMultimapNode<Key, T>(
-            std::forward<K>(key), std::forward<V>(value)
-        );
+        size_t hash_val = hash_func_(key);
+        size_t bucket_idx = bucket_policy_.index(hash_val);
+        auto* new_node = create_node(std::forward<K>(key), std::forward<V>(value));
         // 上面这句解释：使用完美转发构造节点，避免不必要的拷贝或移动
-
-        // 头插法
-        new_node->next = buckets_[bucket_idx];
-        if (buckets_[bucket_idx]) {
-            buckets_[bucket_idx]->prev = new_node;
-        }
-        buckets_[bucket_idx] = new_node;
+        new_node->store_hash(hash_val);
+        link_grouped(new_node, hash_val, bucket_idx);
         ++size_;
 
-        return iterator(new_node, this);
+        return iterator(new_node, this, bucket_idx);
     }
 
     // 重载insert，接受value_type右值
-    iterator insert(value&& val) {
+    iterator insert(value_type&& val) {
         return insert(std::move(val.first), std::move(val.second));
     }
 
     // 查找键的范围
     std::pair<iterator, iterator> equal_range(const Key& key) {
-        size_t bucket_idx = get_bucket_idx(key);
+        size_t hash_val = hash_func_(key);
+        size_t bucket_idx = bucket_policy_.index(hash_val);
         auto* curr = buckets_[bucket_idx];
 
-        // 找到第一个匹配节点
-        while (curr && !equal_func_(curr->value.first, key)) {
+        // 找到第一个匹配节点（先比缓存的哈希值，未开启CacheHash时该比较恒为true）
+        while (curr && !(curr->hash_may_equal(hash_val) && equal_func_(curr->value.first, key))) {
             curr = curr->next;
         }
-        iterator begin_it(curr, this);
+        if (curr == nullptr) {
+            return {end(), end()};
+        }
+        iterator begin_it(curr, this, bucket_idx);
 
         // 找到范围终点
         auto* end_curr = curr;
-        while (end_curr && equal_func_(end_curr->value.first, key)) {
+        while (end_curr && end_curr->hash_may_equal(hash_val) && equal_func_(end_curr->value.first, key)) {
             end_curr = end_curr->next;
         }
-        iterator end_it(end_curr, this);
+        iterator end_it(end_curr, this, bucket_idx);
+        if (end_curr == nullptr) {
+            end_it.find_next_non_empty_bucket(bucket_idx); // 相同键排在桶尾，终点是下一个非空桶的头节点
+        }
 
         return {begin_it, end_it};
     }
+
+    // 键对应的元素个数（相同键相邻，数到第一段连续匹配结束即可）
+    size_t count(const Key& key) const {
+        size_t hash_val = hash_func_(key);
+        auto* curr = buckets_[bucket_policy_.index(hash_val)];
+        while (curr && !(curr->hash_may_equal(hash_val) && equal_func_(curr->value.first, key))) {
+            curr = curr->next;
+        }
+        size_t cnt = 0;
+        while (curr && curr->hash_may_equal(hash_val) && equal_func_(curr->value.first, key)) {
+            ++cnt;
+            curr = curr->next;
+        }
+        return cnt;
+    }
     
     // 按迭代器删除
     iterator erase(iterator pos) {
         if (pos == end()) return end();
 
         auto* to_delete = pos.curr_;
-        iterator next_it(to_delete->next, this);
+        size_t bucket_idx = pos.bucket_;
+        iterator next_it(to_delete->next, this, bucket_idx);
 
         if (to_delete->prev) {
             to_delete->prev->next = to_delete->next;
         } else {
-            size_t bucket_idx = get_bucket_idx(to_delete->value.first);
-            next_it.find_next_non_empty_bucket(bucket_idx);
+            buckets_[bucket_idx] = to_delete->next; // 删除的是桶头节点
+            if (to_delete->next == nullptr) {
+                occupied_.clear(bucket_idx); // 桶中最后一个节点被删除
+            }
+        }
+        if (to_delete->next) {
+            to_delete->next->prev = to_delete->prev;
+        } else {
+            next_it.find_next_non_empty_bucket(bucket_idx); // 本桶已到末尾，跳到下一个非空桶
         }
 
-        delete to_delete;
+        destroy_node(to_delete);
         --size_;
 
         return next_it;
     }
 
+    // ------- 二进制快照（格式见hash_snapshot.h） ------- //
+    // save写出全部键值对；load读回并替换容器原有内容，失败时（包括快照被截断、头部个数与记录不符、
+    // 桶数组分配失败）返回false且容器不变。
+    // KeySer/ValSer是键/值的序列化器：默认定长类型直接写字节，load按流中实际的记录数预留桶，逐条链入桶。
+    // 保存时相同键的记录连续（桶内相邻），加载时仍然相邻
+    template <typename KeySer = SnapshotSerializer<Key>, typename ValSer = SnapshotSerializer<T>>
+    bool save(std::ostream& os) const {
+        OstreamSnapshotSink sink{os};
+        return save_snapshot<KeySer, ValSer>(sink);
+    }
+
+    template <typename KeySer = SnapshotSerializer<Key>, typename ValSer = SnapshotSerializer<T>>
+    bool save(int fd) const {
+        FdSnapshotSink sink{fd};
+        return save_snapshot<KeySer, ValSer>(sink);
+    }
+
+    template <typename KeySer = SnapshotSerializer<Key>, typename ValSer = SnapshotSerializer<T>>
+    bool load(std::istream& is) {
+        IstreamSnapshotSource source{is};
+        return load_snapshot<KeySer, ValSer>(source);
+    }
+
+    template <typename KeySer = SnapshotSerializer<Key>, typename ValSer = SnapshotSerializer<T>>
+    bool load(int fd) {
+        FdSnapshotSource source{fd};
+        return load_snapshot<KeySer, ValSer>(source);
+    }
+
     // 迭代器接口
     iterator begin() {
-        for (size_t i = 0; i < bucket_count_; ++i) {
-            if (buckets_[i]) {
-                return iterator(buckets_[i], this);
-            }
-        }
-        return end();
+        size_t i = occupied_.first(); // 第一个非空桶
+        return i < bucket_count_ ? iterator(buckets_[i], this, i) : end();
     }
 
     iterator end() {
@@ -329,19 +527,393 @@ public:
     bool empty() const { return size_ == 0; }
 
     // 清空元素
+    // 分配策略支持整体释放时只析构节点、最后按slab归还内存；节点可平凡析构时连链表遍历都省掉
     void clear() {
-        for (size_t i = 0; i < bucket_count_; ++i) {
-            auto* curr = buckets_[i];
-            while (curr) {
-                auto* next_node = curr->next;
-                delete curr;
-                curr = next_node;
+        using Node = MyUnorderedMultimapNode<Key, T, CacheHash>;
+        constexpr bool bulk = NodeAllocator<Node>::kReleaseAll;
+        // 只访问位图中的非空桶
+        for (size_t i = occupied_.first(); i < bucket_count_; i = occupied_.next(i + 1)) {
+            if (!bulk || !std::is_trivially_destructible<Node>::value) {
+                auto* curr = buckets_[i];
+                while (curr) {
+                    auto* next_node = curr->next;
+                    if (bulk) {
+                        curr->~Node();
+                    } else {
+                        destroy_node(curr);
+                    }
+                    curr = next_node;
+                }
             }
             buckets_[i] = nullptr;
         }
+        if (bucket_count_) {
+            occupied_.clear_all();
+        }
+        node_alloc_.release_all();
         size_ = 0;
     }
 
+private:
+    // 写出快照，按位图只访问非空桶
+    template <typename KeySer, typename ValSer, typename Sink>
+    bool save_snapshot(Sink& sink) const {
+        constexpr bool raw = KeySer::kRaw && ValSer::kRaw;
+        SnapshotWriter<Sink> writer(sink);
+        if (!writer.begin(make_snapshot_header(kSnapshotKindMultimap, raw, sizeof(Key), sizeof(T), size_))) {
+            return false;
+        }
+        bool ok = true;
+        for (size_t i = occupied_.first(); i < bucket_count_; i = occupied_.next(i + 1)) {
+            for (auto* curr = buckets_[i]; curr; curr = curr->next) {
+                if constexpr (raw) {
+                    unsigned char* p = writer.reserve(sizeof(Key) + sizeof(T));
+                    memcpy(p, &curr->value.first, sizeof(Key));
+                    memcpy(p + sizeof(Key), &curr->value.second, sizeof(T));
+                } else {
+                    ok = ok && KeySer::save(writer, curr->value.first) && ValSer::save(writer, curr->value.second);
+                }
+            }
+        }
+        return writer.finish() && ok;
+    }
+
+    // 读回快照：先读进一个临时容器，全部成功后再移动过来，失败时本容器保持不变
+    template <typename KeySer, typename ValSer, typename Source>
+    bool load_snapshot(Source& source) {
+        MyUnorderedMultimap staging(16, hash_func_, equal_func_);
+        if (!staging.template read_snapshot<KeySer, ValSer>(source)) {
+            return false;
+        }
+        *this = std::move(staging);
+        return true;
+    }
+
+    // 把快照读进空容器。头部的元素个数不可信：桶按流中实际能容纳的记录数预留，
+    // 流长度未知时读到新块再翻倍扩大（不超过头部的个数）；桶数组分配失败返回false。
+    // 定长记录直接建节点链入桶（不检查负载）；相同键仍要保持相邻，所以同样经过link_grouped——
+    // save写出的相同键是连续的，通常桶头就是它，只有损坏/拼凑的快照才需要往后找。其他情况走insert
+    template <typename KeySer, typename ValSer, typename Source>
+    bool read_snapshot(Source& source) {
+        constexpr bool raw = KeySer::kRaw && ValSer::kRaw;
+        constexpr size_t kRecordBytes = raw ? sizeof(Key) + sizeof(T) : 1;
+        SnapshotReader<Source> reader(source);
+        SnapshotHeader header;
+        if (!reader.begin(header) ||
+            !snapshot_header_matches(header, kSnapshotKindMultimap, raw, sizeof(Key), sizeof(T))) {
+            return false;
+        }
+        uint64_t reserved = header.count > 0 ? reader.record_bound(header.count, kRecordBytes) : 0;
+        if (!try_reserve(reserved)) {
+            return false;
+        }
+        typename KeySer::load_type key{}; // 读出缓冲在各条记录间复用（字符串的容量不必每条重新分配）
+        typename ValSer::load_type value{};
+        for (uint64_t i = 0; i < header.count; ++i) {
+            if constexpr (raw) {
+                if (i == reserved) {
+                    uint64_t in_stream = i + reader.available() / kRecordBytes;
+                    reserved = std::min<uint64_t>(header.count, std::max<uint64_t>(reserved * 2, in_stream));
+                    if (!try_reserve(reserved)) {
+                        return false;
+                    }
+                }
+                const unsigned char* p = reader.take(kRecordBytes);
+                if (p == nullptr) {
+                    return false;
+                }
+                Key raw_key;
+                T raw_value;
+                memcpy(&raw_key, p, sizeof(Key));
+                memcpy(&raw_value, p + sizeof(Key), sizeof(T));
+                auto* new_node = create_node(raw_key, raw_value);
+                size_t hash_val = hash_func_(new_node->value.first);
+                size_t bucket_idx = bucket_policy_.index(hash_val);
+                new_node->store_hash(hash_val);
+                link_grouped(new_node, hash_val, bucket_idx);
+                ++size_;
+            } else {
+                if (!KeySer::load(reader, key) || !ValSer::load(reader, value)) {
+                    return false;
+                }
+                insert(Key(std::move(key)), T(std::move(value)));
+            }
+        }
+        return reader.finish();
+    }
+
     // 允许迭代器访问容器的私有成员（桶数组、桶数量等）
-    friend class MyUnorderedMultimapIterator<Key, T, Hash, KeyEqual>;
-};
\ No newline at end of file
+    friend class MyUnorderedMultimapIterator<Key, T, Hash, KeyEqual, BucketPolicy, NodeAllocator, CacheHash>;
+};
+
+// ------- 按键分组的布局 ------- //
+// MyUnorderedMultimap每个元素一个节点，热点键的成千上万个值分散在各处的节点里，遍历一次就是成千上万次缓存未命中。
+// MyGroupedMultimap改为每个不同的键只占一个节点，节点里用MyVector连续存放该键的全部值：
+// - count(key)：O(1)，直接取值数组的长度
+// - equal_range(key)：返回连续内存上的[first, last)，遍历就是顺序扫数组
+// - erase(key)：一次摘下整个节点，值数组整块释放
+// 代价是同一个键的值没有各自独立的节点：插入可能触发值数组搬迁，之前取得的值指针随之失效。
+template <typename Key, typename T, bool CacheHash = false>
+struct MyGroupedMultimapEntry : CachedHashCode<CacheHash> {
+    Key key;
+    MyVector<T> values; // 该键的全部值，按插入顺序
+    MyGroupedMultimapEntry* next;
+
+    template <typename K>
+    explicit MyGroupedMultimapEntry(K&& k) : key(std::forward<K>(k)), next(nullptr) {}
+
+    MyGroupedMultimapEntry(const MyGroupedMultimapEntry&) = delete;
+    MyGroupedMultimapEntry& operator=(const MyGroupedMultimapEntry&) = delete;
+};
+
+// 一个键的全部值：连续内存上的[first, last)
+template <typename T>
+struct MyGroupedValueSpan {
+    T* first = nullptr;
+    T* last = nullptr;
+
+    T* begin() const { return first; }
+    T* end() const { return last; }
+    size_t size() const { return static_cast<size_t>(last - first); }
+    bool empty() const { return first == last; }
+    T& operator[](size_t i) const { return first[i]; }
+};
+
+template <
+    typename Key,
+    typename T,
+    typename Hash = DefaultMultimapHash<Key>,
+    typename KeyEqual = std::equal_to<Key>,
+    typename BucketPolicy = PrimeBucketPolicy,
+    template <typename> class NodeAllocator = SlabNodeAllocator,
+    bool CacheHash = false>
+class MyGroupedMultimap {
+private:
+    using Entry = MyGroupedMultimapEntry<Key, T, CacheHash>;
+
+    Entry** buckets_;
+    size_t bucket_count_; // 桶的数量
+    size_t key_count_;    // 不同键的个数（即节点数）
+    size_t size_;         // 值的总个数
+    Hash hash_func_;
+    KeyEqual equal_func_;
+    const float max_load_factor_ = 1.0f; // 按不同键的个数计算负载
+    BucketPolicy bucket_policy_;
+    NodeAllocator<Entry> node_alloc_;
+
+    size_t entry_hash(const Entry* entry) const {
+        if constexpr (CacheHash) {
+            return entry->hash_code;
+        } else {
+            return hash_func_(entry->key);
+        }
+    }
+
+    Entry* find_entry(const Key& key, size_t hash_val) const {
+        for (Entry* curr = buckets_[bucket_policy_.index(hash_val)]; curr; curr = curr->next) {
+            if (curr->hash_may_equal(hash_val) && equal_func_(curr->key, key)) {
+                return curr;
+            }
+        }
+        return nullptr;
+    }
+
+    // 取得键对应的节点，不存在则新建一个空值数组的节点
+    template <typename K>
+    Entry* find_or_create(K&& key) {
+        size_t hash_val = hash_func_(key);
+        Entry* entry = find_entry(key, hash_val);
+        if (entry) {
+            return entry;
+        }
+        if (key_count_ + 1 > bucket_count_ * max_load_factor_) {
+            rehash(bucket_count_ * 2);
+        }
+        size_t bucket_idx = bucket_policy_.index(hash_val);
+        entry = new (node_alloc_.allocate()) Entry(std::forward<K>(key));
+        entry->store_hash(hash_val);
+        entry->next = buckets_[bucket_idx];
+        buckets_[bucket_idx] = entry;
+        ++key_count_;
+        return entry;
+    }
+
+    void destroy_entry(Entry* entry) {
+        entry->~Entry();
+        node_alloc_.deallocate(entry);
+    }
+
+    static Entry** allocate_buckets(size_t n) {
+        auto* buckets = static_cast<Entry**>(std::malloc(n * sizeof(Entry*)));
+        for (size_t i = 0; i < n; ++i) {
+            buckets[i] = nullptr;
+        }
+        return buckets;
+    }
+
+    void rehash(size_t new_bucket_count) {
+        if (new_bucket_count <= bucket_count_) {
+            return;
+        }
+        BucketPolicy new_policy;
+        new_bucket_count = new_policy.reset(new_bucket_count);
+        Entry** new_buckets = allocate_buckets(new_bucket_count);
+        for (size_t i = 0; i < bucket_count_; ++i) {
+            Entry* curr = buckets_[i];
+            while (curr) {
+                Entry* next_entry = curr->next;
+                size_t new_idx = new_policy.index(entry_hash(curr));
+                curr->next = new_buckets[new_idx];
+                new_buckets[new_idx] = curr;
+                curr = next_entry;
+            }
+        }
+        free(buckets_);
+        buckets_ = new_buckets;
+        bucket_count_ = new_bucket_count;
+        bucket_policy_ = new_policy;
+    }
+
+public:
+    using value_span = MyGroupedValueSpan<T>;
+
+    explicit MyGroupedMultimap(
+        size_t bucket_count = 16,
+        const Hash& hash = Hash(),
+        const KeyEqual& equal = KeyEqual()) : key_count_(0), size_(0),
+            hash_func_(hash),
+            equal_func_(equal) {
+        bucket_count_ = bucket_policy_.reset(bucket_count);
+        buckets_ = allocate_buckets(bucket_count_);
+    }
+
+    ~MyGroupedMultimap() {
+        clear();
+        free(buckets_);
+    }
+
+    MyGroupedMultimap(const MyGroupedMultimap&) = delete;
+    MyGroupedMultimap& operator=(const MyGroupedMultimap&) = delete;
+
+    // 插入一个值，返回它在值数组中的地址（同一个键再插入时可能失效）
+    template <typename K, typename V>
+    T* insert(K&& key, V&& value) {
+        Entry* entry = find_or_create(std::forward<K>(key));
+        entry->values.emplace_back(std::forward<V>(value));
+        ++size_;
+        return &entry->values.back();
+    }
+
+    // 为一个键批量追加[first, last)中的值（只查找一次）
+    // 前向及以上的迭代器先用distance求出个数，值数组一次扩到位；单趟的输入迭代器（如istream_iterator）
+    // 求个数会把区间消耗掉，只能边读边追加。空区间直接返回，不会留下没有值的键
+    template <typename K, typename InputIt>
+    void insert(K&& key, InputIt first, InputIt last) {
+        if (first == last) {
+            return;
+        }
+        Entry* entry = find_or_create(std::forward<K>(key));
+        size_t old_size = entry->values.size();
+        using Category = typename std::iterator_traits<InputIt>::iterator_category;
+        if constexpr (std::is_base_of<std::forward_iterator_tag, Category>::value) {
+            entry->values.reserve(old_size + static_cast<size_t>(std::distance(first, last)));
+        }
+        for (; first != last; ++first) {
+            entry->values.emplace_back(*first);
+        }
+        size_ += entry->values.size() - old_size;
+    }
+
+    // 预留已有键的值数组容量（已知热点键还会追加多少值时可避免多次搬迁）
+    // 键不存在时什么也不做：表中的每个键至少有一个值，contains/count/key_count才一致；
+    // 新键要一次分配到位，用上面的区间insert
+    void reserve_values(const Key& key, size_t n) {
+        Entry* entry = find_entry(key, hash_func_(key));
+        if (entry) {
+            entry->values.reserve(n);
+        }
+    }
+
+    // 键对应的全部值，连续存放；键不存在时为空区间
+    value_span equal_range(const Key& key) const {
+        Entry* entry = find_entry(key, hash_func_(key));
+        if (entry == nullptr || entry->values.empty()) {
+            return {};
+        }
+        return {entry->values.data(), entry->values.data() + entry->values.size()};
+    }
+
+    // O(1)：值数组的长度
+    size_t count(const Key& key) const {
+        Entry* entry = find_entry(key, hash_func_(key));
+        return entry ? entry->values.size() : 0;
+    }
+
+    bool contains(const Key& key) const {
+        return find_entry(key, hash_func_(key)) != nullptr;
+    }
+
+    // 删除键及其全部值，返回删除的值个数
+    size_t erase(const Key& key) {
+        size_t hash_val = hash_func_(key);
+        Entry** link = &buckets_[bucket_policy_.index(hash_val)];
+        while (*link) {
+            Entry* curr = *link;
+            if (curr->hash_may_equal(hash_val) && equal_func_(curr->key, key)) {
+                size_t removed = curr->values.size();
+                *link = curr->next;
+                destroy_entry(curr);
+                --key_count_;
+                size_ -= removed;
+                return removed;
+            }
+            link = &curr->next;
+        }
+        return 0;
+    }
+
+    // 按组遍历：fn(const Key&, value_span)
+    template <typename Fn>
+    void for_each_group(Fn fn) const {
+        for (size_t i = 0; i < bucket_count_; ++i) {
+            for (Entry* curr = buckets_[i]; curr; curr = curr->next) {
+                fn(static_cast<const Key&>(curr->key),
+                   value_span{curr->values.data(), curr->values.data() + curr->values.size()});
+            }
+        }
+    }
+
+    // 逐个元素遍历：fn(const Key&, T&)
+    template <typename Fn>
+    void for_each(Fn fn) const {
+        for_each_group([&fn](const Key& key, value_span values) {
+            for (T& value : values) {
+                fn(key, value);
+            }
+        });
+    }
+
+    size_t size() const { return size_; }
+    size_t key_count() const { return key_count_; }
+    bool empty() const { return size_ == 0; }
+
+    void clear() {
+        constexpr bool bulk = NodeAllocator<Entry>::kReleaseAll;
+        for (size_t i = 0; i < bucket_count_; ++i) {
+            Entry* curr = buckets_[i];
+            while (curr) {
+                Entry* next_entry = curr->next;
+                if (bulk) {
+                    curr->~Entry(); // 值数组要析构，节点内存最后随slab一起归还
+                } else {
+                    destroy_entry(curr);
+                }
+                curr = next_entry;
+            }
+            buckets_[i] = nullptr;
+        }
+        node_alloc_.release_all();
+        key_count_ = 0;
+        size_ = 0;
+    }
+};
@@ -3,6 +3,20 @@
 #include <cstdlib> // 用于malloc、free等内存管理函数
 #include <utility>    // std::move、std::forward
 #include <type_traits> // std::is_nothrow_move_constructible（可选）
+#include <iterator> // std::forward_iterator_tag
+#include <new> // placement new
+#include <cstdint> // uint64_t（计数模式的重数）
+#include <cstring> // memcpy（快照的定长记录）
+#include <iostream> // std::cerr（内存分配失败）
+#include <algorithm> // std::min、std::max
+#include "hash_function.h" // 默认哈希函数（整数混合、字节串wyhash）
+#include "hash_bucket_policy.h" // 桶索引策略（质数表/2的幂掩码）
+#include "hash_node_allocator.h" // 节点分配策略（slab/逐个new）
+#include "hash_code_cache.h" // 节点中可选缓存的完整哈希值
+#include "hash_table_stats.h" // 健康度统计（链长分布、采样探测长度、rehash时间线）
+#include "bucket_bitmap.h" // 非空桶位图（迭代时用tzcnt跳过空桶）
+#include "hash_snapshot.h" // 二进制快照（save/load）
+#include "string_simd.h" // SIMD字符串比较
 
 // 前置声明：哈希函数默认实现（脱离std::hash）
 template <typename T>
@@ -13,8 +27,9 @@ template <typename T>
 struct DefaultEqual;
 
 // ------- 节点结构：双向链表节点 ------- //
-template <typename T>
-struct HashNode {
+// CacheHash为true时基类里多存一份完整哈希值，见hash_code_cache.h
+template <typename T, bool CacheHash = false>
+struct HashNode : CachedHashCode<CacheHash> {
     T data; // 存储的数据
     HashNode* next; // 后继节点
     HashNode* prev; // 前驱节点
@@ -28,18 +43,24 @@ struct HashNode {
     explicit HashNode(T&& val, size_t idx)
         : data(std::move(val)), prev(nullptr), next(nullptr), bucket_idx(idx) {}
 
-    // 原地构造数据（完美转发参数）
+    // 原地构造数据（完美转发参数）：数据在节点内只构造一次，桶索引要等算出哈希后再填
     template <typename... Args>
-    explicit HashNode(Args&&... args, size_t idx)
-        : data(std::forward<Args>(args)...), prev(nullptr), next(nullptr), bucket_idx(idx) {}
+    explicit HashNode(std::in_place_t, Args&&... args)
+        : data(std::forward<Args>(args)...), next(nullptr), prev(nullptr), bucket_idx(0) {}
 
 };
 
 // ------- 自定义unordered_multiset ------- //
 template <typename T,
           typename Hash = DefaultHash<T>,
-          typename KeyEqual = DefaultEqual<T>>
+          typename KeyEqual = DefaultEqual<T>,
+          typename BucketPolicy = PrimeBucketPolicy,
+          template <typename> class NodeAllocator = SlabNodeAllocator,
+          bool CacheHash = false> // 节点中缓存完整哈希值：rehash不再调用哈希函数，查找时先比哈希再比键
 class MyUnorderedMultiSet {
+private:
+    using Node = HashNode<T, CacheHash>;
+
 public:
     // 类型定义
     using value_type = T;
@@ -51,8 +72,9 @@ public:
     // 迭代器（前向迭代器）
     class iterator {
     private:
-        HashNode<T>* m_node; // 指向当前节点的指针
+        Node* m_node; // 指向当前节点的指针
         MyUnorderedMultiSet* m_container; // 指向所属容器的指针
+        size_t m_bucket; // 当前节点所在的桶：跨桶时不必先读出节点里的bucket_idx，找下一个非空桶不用等节点加载完
         friend class MyUnorderedMultiSet;
 
     public:
@@ -63,17 +85,23 @@ public:
         using pointer = T*;
         using difference_type = ptrdiff_t;
 
-        iterator() : m_node(nullptr), m_container(nullptr) {}
-        iterator(HashNode<T>* node, MyUnorderedMultiSet* container)
-            : m_node(node), m_container(container) {}
+        iterator() : m_node(nullptr), m_container(nullptr), m_bucket(0) {}
+        iterator(Node* node, MyUnorderedMultiSet* container)
+            : m_node(node), m_container(container), m_bucket(node ? node->bucket_idx : 0) {}
+        iterator(Node* node, size_t bucket, MyUnorderedMultiSet* container)
+            : m_node(node), m_container(container), m_bucket(bucket) {}
 
         // 移动迭代器
         iterator(iterator&& other) noexcept
-            : m_node(other.m_node), m_container(other.m_container) {
+            : m_node(other.m_node), m_container(other.m_container), m_bucket(other.m_bucket) {
             other.m_node = nullptr;
             other.m_container = nullptr;
         }
 
+        // 声明了移动构造后拷贝构造/赋值会被隐式删除，这里显式恢复（迭代器只是两个指针，拷贝很便宜）
+        iterator(const iterator&) = default;
+        iterator& operator=(const iterator&) = default;
+
         reference operator*() const {
             return m_node->data;
         }
@@ -88,14 +116,9 @@ public:
             if (m_node->next) {
                 m_node = m_node->next;
             } else {
-                size_t current_bucket = m_node->bucket_idx;
-                for (size_t i = current_bucket + 1; i < m_container->m_buckets.size(); ++i) {
-                    if (m_container->m_buckets[i]) {
-                        m_node = m_container->m_buckets[i]; // 这是桶的头节点
-                        return *this;
-                    }
-                }
-                m_node = nullptr; // 到达容器末尾
+                // 在非空桶位图中找下一个非空桶，空桶按64个一组跳过
+                m_bucket = m_container->m_occupied.next(m_bucket + 1);
+                m_node = m_bucket < m_container->m_bucket_count ? m_container->m_buckets[m_bucket] : nullptr; // 桶的头节点，或到达容器末尾
             }
             return *this;
         }
@@ -126,8 +149,13 @@ public:
     explicit MyUnorderedMultiSet(size_type bucket_count = 16,
                                  const Hash& hash = Hash(),
                                  const KeyEqual& key_eq = KeyEqual())
-        : m_bucket_count(bucket_count), m_size(0), m_hash(hash), m_key_eq(key_eq), m_max_load_factor(0.7f) {
+        : m_size(0), m_hash(hash), m_key_eq(key_eq), m_max_load_factor(0.7f) {
+        m_bucket_count = m_bucket_policy.reset(bucket_count); // 桶数由策略向上取整
         m_buckets = allocate_buckets(m_bucket_count);
+        if (m_buckets == nullptr) {
+            out_of_memory();
+        }
+        m_occupied.reset(m_bucket_count);
     }
 
     // 移动构造函数（转移资源，不复制节点）
@@ -137,7 +165,11 @@ public:
           m_size(other.m_size), // std::move 的作用是触发对象的移动构造 / 赋值，仅对具有资源的对象有意义；而指针和基本类型的 “移动” 本质是浅拷贝，无需 std::move。
           m_hash(std::move(other.m_hash)),
           m_key_eq(std::move(other.m_key_eq)),
-          m_max_load_factor(other.m_max_load_factor) {
+          m_max_load_factor(other.m_max_load_factor),
+          m_bucket_policy(other.m_bucket_policy),
+          m_node_alloc(std::move(other.m_node_alloc)),
+          m_occupied(std::move(other.m_occupied)),
+          m_monitor(other.m_monitor) {
         // 将other置于有效但空状态
         other.m_buckets = nullptr;
         other.m_bucket_count = 0;
@@ -171,6 +203,10 @@ public:
             m_hash = std::move(other.m_hash);
             m_key_eq = std::move(other.m_key_eq);
             m_max_load_factor = other.m_max_load_factor;
+            m_bucket_policy = other.m_bucket_policy;
+            m_node_alloc = std::move(other.m_node_alloc); // 节点内存随slab一起转移
+            m_occupied = std::move(other.m_occupied);
+            m_monitor = other.m_monitor;
 
             // 源对象置空
             other.m_buckets = nullptr;
@@ -205,35 +241,59 @@ public:
     }
 
     // 3. 原地构造元素（完美转发，避免临时对象）
+    // 先从分配策略取节点内存，在节点里直接构造T（只构造一次，参数只被消费一次），再对节点中的数据求哈希
     template <typename... Args>
     iterator emplace(Args&&... args) {
-        // 先构造临时对象计算哈希（实际STL可能优化此步骤以避免临时对象）
-        T tmp(std::forward<Args>(args)...); // 完美转发参数构造临时对象，这里调用了T的构造函数，至于是哪个构造函数取决于Args的类型和数量
-        size_t hash_val = m_hash(tmp);
-        size_t bucket_idx = hash_val % m_bucket_count;
+        Node* new_node = construct_in_node(std::forward<Args>(args)...);
+        size_t hash_val = m_hash(new_node->data);
+        size_t bucket_idx = prepare_bucket(hash_val);
+        new_node->store_hash(hash_val);
+        new_node->bucket_idx = bucket_idx;
+        link_node(new_node, bucket_idx);
+        ++m_size;
 
-        // 检查重哈希
-        if (load_factor() > m_max_load_factor) {
-            rehash(m_bucket_count * 2);
-            bucket_idx = hash_val % m_bucket_count; // 重新计算桶索引
-        }
+        return iterator(new_node, this);
+    }
 
-        // 直接在节点中构造函数（完美转发参数）
-        HashNode<T>* new_node = new HashNode<T>(std::forward<Args>(args)..., bucket_idx); // 调用了HashNode的完美转发构造函数，
-        // 如果HashNode没有定义完美转发构造函数，则会报错
-        link_node(new_node, bucket_idx);
+    // 4. 带提示的原地构造：hint指向与新元素相等的元素时，新节点直接链在它后面，
+    // 相等元素保持相邻（遍历/equal_range更友好），且省掉在桶里再找一遍；提示不对时退化为普通emplace
+    template <typename... Args>
+    iterator emplace_hint(const iterator& hint, Args&&... args) {
+        Node* new_node = construct_in_node(std::forward<Args>(args)...);
+        size_t hash_val = m_hash(new_node->data);
+        size_t bucket_idx = prepare_bucket(hash_val);
+        new_node->store_hash(hash_val);
+        new_node->bucket_idx = bucket_idx;
+        Node* pos = hint.m_node;
+        if (pos && hint.m_container == this && pos->bucket_idx == bucket_idx && pos->hash_may_equal(hash_val) &&
+            m_key_eq(pos->data, new_node->data)) {
+            new_node->prev = pos;
+            new_node->next = pos->next;
+            if (pos->next) {
+                pos->next->prev = new_node;
+            }
+            pos->next = new_node;
+        } else {
+            link_node(new_node, bucket_idx);
+        }
         ++m_size;
 
         return iterator(new_node, this);
     }
 
+    // 预留能容纳n个元素的桶，之后插入n个元素的过程中不再rehash
+    void reserve(size_type n) {
+        rehash(static_cast<size_type>(n / m_max_load_factor) + 1);
+    }
+
     // 计数元素
     size_type count(const T& val) const {
         if (empty()) return 0;
-        siz_t bucket_idx = m_hash(val) % m_bucket_count;
+        size_t hash_val = m_hash(val);
+        size_t bucket_idx = m_bucket_policy.index(hash_val);
         size_type cnt = 0;
-        for (HashNode<T>* p = m_buckets[bucket_idx]; p; p = p->next) {
-            if (m_key_eq(p->data, val)) {
+        for (Node* p = m_buckets[bucket_idx]; p; p = p->next) {
+            if (p->hash_may_equal(hash_val) && m_key_eq(p->data, val)) {
                 ++cnt;
             }
         }
@@ -245,26 +305,38 @@ public:
         if (empty()) {
             return end();
         }
-        size_t bucket_idx = m_hash(val) % m_bucket_count;
-        for (HashNode<T>* p = m_buckets[bucket_idx]; p; p = p->next) {
-            if (m_key_eq(p->data, val)) {
+        size_t hash_val = m_hash(val);
+        size_t bucket_idx = m_bucket_policy.index(hash_val);
+        // 被采样时顺带数出比较过的节点数，未被采样的查找只多一次计数器递减
+        bool sampled = m_monitor.sample_find();
+        size_t probes = 0;
+        for (Node* p = m_buckets[bucket_idx]; p; p = p->next) {
+            ++probes;
+            if (p->hash_may_equal(hash_val) && m_key_eq(p->data, val)) {
+                if (sampled) {
+                    m_monitor.record_probe(probes);
+                }
                 return iterator(p, this);
             }
         }
+        if (sampled) {
+            m_monitor.record_probe(probes);
+        }
         return end();
     }
 
     // 按值删除，返回删除个数（因为是multiset，可能删除多个）
     size_type erase(const T& val) {
         if (empty()) return 0;
-        size_t bucket_idx = m_hash(val) % m_bucket_count;
+        size_t hash_val = m_hash(val);
+        size_t bucket_idx = m_bucket_policy.index(hash_val);
         size_type cnt = 0;
-        HashNode<T>* p = m_buckets[bucket_idx];
+        Node* p = m_buckets[bucket_idx];
         while (p) {
-            HashNode<T>* next = p->next;
-            if (m_key_eq(p->data, val)) {
+            Node* next = p->next;
+            if (p->hash_may_equal(hash_val) && m_key_eq(p->data, val)) {
                 unlink_node(p, bucket_idx);
-                delete p;
+                destroy_node(p);
                 --m_size;
                 ++cnt;
             }
@@ -273,18 +345,33 @@ public:
         return cnt;
     }
 
-    // 重哈希
+    // 重哈希（桶数组分配失败时报错退出，与MyUnorderedMap一致）
     void rehash(size_type new_bucket_count) {
+        if (!try_rehash(new_bucket_count)) {
+            out_of_memory();
+        }
+    }
+
+    // 重哈希，桶数组分配失败时返回false且容器不变
+    bool try_rehash(size_type new_bucket_count) {
         if (new_bucket_count <= m_bucket_count) {
-            return; // 新桶数必须大于当前桶数
+            return true; // 新桶数必须大于当前桶数
+        }
+        uint64_t start_ns = HashTableMonitor::now_ns();
+        BucketPolicy new_policy;
+        new_bucket_count = new_policy.reset(new_bucket_count); // 向上取整到策略支持的桶数
+        Node** new_buckets = allocate_buckets(new_bucket_count);
+        if (new_buckets == nullptr) {
+            return false;
         }
-        HashNode<T>** new_buckets = allocate_buckets(new_bucket_count);
+        BucketBitmap new_occupied;
+        new_occupied.reset(new_bucket_count);
         // 迁移节点到新桶
         for (size_t i = 0; i < m_bucket_count; ++i) {
-            HashNode<T>* p = m_buckets[i];
+            Node* p = m_buckets[i];
             while (p) {
-                HashNode<T>* next = p->next;
-                size_t new_idx = m_hash(p->data) % new_bucket_count;
+                Node* next = p->next;
+                size_t new_idx = new_policy.index(node_hash(p));
                 p->bucket_idx = new_idx;
                 // 插入到新桶头部
                 p->prev = nullptr;
@@ -293,40 +380,82 @@ public:
                     new_buckets[new_idx]->prev = p;
                 }
                 new_buckets[new_idx] = p;
+                new_occupied.set(new_idx);
                 p = next;
             }
         }
         // 替换桶数组
         free(m_buckets);
+        m_monitor.record_rehash(m_size, m_bucket_count, new_bucket_count, HashTableMonitor::now_ns() - start_ns);
         m_buckets = new_buckets;
         m_bucket_count = new_bucket_count;
+        m_bucket_policy = new_policy;
+        m_occupied = std::move(new_occupied);
+        return true;
     }
 
     // 清空容器
+    // 分配策略支持整体释放时只析构节点、最后按slab归还内存；元素可平凡析构时连链表遍历都省掉
+    // 只访问位图中的非空桶，大表删到只剩少量元素后clear不再逐个扫描全部桶
     void clear() {
-        for (size_t i = 0; i < m_bucket_count; ++i) {
-            HashNode<T>* p = m_buckets[i];
-            while (p) {
-                HashNode<T>* next = p->next;
-                delete p;
-                p = next;
+        constexpr bool bulk = NodeAllocator<Node>::kReleaseAll;
+        for (size_t i = m_occupied.first(); i < m_bucket_count; i = m_occupied.next(i + 1)) {
+            if (!bulk || !std::is_trivially_destructible<Node>::value) {
+                Node* p = m_buckets[i];
+                while (p) {
+                    Node* next = p->next;
+                    if (bulk) {
+                        p->~Node();
+                    } else {
+                        destroy_node(p);
+                    }
+                    p = next;
+                }
             }
             m_buckets[i] = nullptr;
         }
+        if (m_bucket_count) {
+            m_occupied.clear_all();
+        }
+        m_node_alloc.release_all();
         m_size = 0;
     }
 
+    // ------- 二进制快照（格式见hash_snapshot.h） ------- //
+    // save写出全部元素（重复元素各写一条）；load读回并替换容器原有内容，失败时（包括快照被截断、
+    // 头部个数与记录不符、桶数组分配失败）返回false且容器不变。
+    // Ser是元素的序列化器：默认定长类型直接写字节，load按流中实际的记录数预留桶，逐条头插
+    template <typename Ser = SnapshotSerializer<T>>
+    bool save(std::ostream& os) const {
+        OstreamSnapshotSink sink{os};
+        return save_snapshot<Ser>(sink);
+    }
+
+    template <typename Ser = SnapshotSerializer<T>>
+    bool save(int fd) const {
+        FdSnapshotSink sink{fd};
+        return save_snapshot<Ser>(sink);
+    }
+
+    template <typename Ser = SnapshotSerializer<T>>
+    bool load(std::istream& is) {
+        IstreamSnapshotSource source{is};
+        return load_snapshot<Ser>(source);
+    }
+
+    template <typename Ser = SnapshotSerializer<T>>
+    bool load(int fd) {
+        FdSnapshotSource source{fd};
+        return load_snapshot<Ser>(source);
+    }
+
     // 迭代器相关
     iterator begin() {
         if (empty()) {
             return end();
         }
-        for (size_t i = 0; i < m_bucket_count; ++i) {
-            if (m_buckets[i]) {
-                return iterator(m_buckets[i], this); // 返回第一个非空桶的头节点
-            }
-        }
-        return end();
+        size_t i = m_occupied.first(); // 第一个非空桶
+        return i < m_bucket_count ? iterator(m_buckets[i], i, this) : end(); // 返回第一个非空桶的头节点
     }
 
     iterator end() {
@@ -343,6 +472,9 @@ public:
     float load_factor() const {
         return m_bucket_count == 0 ? 0.0f : static_cast<float>(m_size) / m_bucket_count;
     }
+    size_type bucket_count() const {
+        return m_bucket_count;
+    }
     float max_load_factor() const {
         return m_max_load_factor;
     }
@@ -350,70 +482,231 @@ public:
         m_max_load_factor = lf;
     }
 
+    // 健康度快照：桶分布现场统计（O(桶数)），探测长度与rehash记录来自运行期采样
+    HashTableStats stats() const {
+        HashTableStats out;
+        m_monitor.fill(out, m_size, m_bucket_count, [this](size_t i) {
+            size_t len = 0;
+            for (const Node* p = m_buckets[i]; p; p = p->next) {
+                ++len;
+            }
+            return len;
+        });
+        return out;
+    }
+
+    // 清零探测长度统计，开始新的观察窗口
+    void reset_probe_stats() {
+        m_monitor.reset_probes();
+    }
+
 private:
-    HashNode<T>** m_buckets = nullptr; // 桶数组，指向每个桶的头节点指针
+    Node** m_buckets = nullptr; // 桶数组，指向每个桶的头节点指针
     size_type m_bucket_count; // 桶数量
     size_type m_size; // 元素数量
     Hash m_hash; // 哈希函数对象
     KeyEqual m_key_eq; // 键比较函数对象
     float m_max_load_factor; // 最大负载因子
+    BucketPolicy m_bucket_policy; // 桶索引策略
+    NodeAllocator<Node> m_node_alloc; // 节点分配策略
+    BucketBitmap m_occupied; // 非空桶位图
+    HashTableMonitor m_monitor; // 健康度统计
 
-    // 辅助函数：分配并初始化桶数组
-    HashNode<T>** allocate_buckets(size_type n) {
+    // 辅助函数：分配并初始化桶数组，内存不足时返回nullptr
+    Node** allocate_buckets(size_type n) {
         if (n == 0) return nullptr;
-        auto buckets = static_cast<HashNode<T>**>(malloc(n * sizeof(HashNode<T>*))); // buckets是指向指针的指针，是一个指针数组，
-        // 在这里的含义是：每个元素都是一个HashNode<T>*类型的指针，指向对应桶的头节点
+        auto buckets = static_cast<Node**>(malloc(n * sizeof(Node*))); // buckets是指向指针的指针，是一个指针数组，
+        // 在这里的含义是：每个元素都是一个Node*类型的指针，指向对应桶的头节点
+        if (buckets == nullptr) {
+            return nullptr;
+        }
         for (size_type i = 0; i < n; ++i) {
             buckets[i] = nullptr; // 初始化每个桶为空
         }
         return buckets;
     }
 
+    [[noreturn]] static void out_of_memory() {
+        std::cerr << "内存分配失败！" << std::endl;
+        exit(1);
+    }
+
+    // 辅助函数：能容纳n个元素的桶，分配失败时返回false
+    bool try_reserve(uint64_t n) {
+        return try_rehash(static_cast<size_type>(n / m_max_load_factor) + 1);
+    }
+
+    // 辅助函数：从分配策略取内存并原地构造节点
+    template <typename... Args>
+    Node* create_node(Args&&... args) {
+        return new (m_node_alloc.allocate()) Node(std::forward<Args>(args)...);
+    }
+
+    // 辅助函数：取节点内存并在其中原地构造T；T的构造抛异常时把内存还给分配策略
+    template <typename... Args>
+    Node* construct_in_node(Args&&... args) {
+        void* mem = m_node_alloc.allocate();
+        try {
+            return new (mem) Node(std::in_place, std::forward<Args>(args)...);
+        } catch (...) {
+            m_node_alloc.deallocate(mem);
+            throw;
+        }
+    }
+
+    // 辅助函数：插入前按需分配桶数组/扩容，返回hash_val在（可能扩容后的）桶数组中的下标
+    size_t prepare_bucket(size_t hash_val) {
+        if (m_bucket_count == 0) {
+            m_bucket_count = m_bucket_policy.reset(16);
+            m_buckets = allocate_buckets(m_bucket_count);
+            if (m_buckets == nullptr) {
+                out_of_memory();
+            }
+            m_occupied.reset(m_bucket_count);
+        }
+        if (load_factor() > m_max_load_factor) {
+            rehash(m_bucket_count * 2);
+        }
+        return m_bucket_policy.index(hash_val);
+    }
+
+    // 辅助函数：节点元素的哈希值（开启CacheHash时直接取缓存，不再调用哈希函数）
+    size_t node_hash(const Node* node) const {
+        if constexpr (CacheHash) {
+            return node->hash_code;
+        } else {
+            return m_hash(node->data);
+        }
+    }
+
+    // 辅助函数：析构节点并把内存还给分配策略
+    void destroy_node(Node* node) {
+        node->~Node();
+        m_node_alloc.deallocate(node);
+    }
+
     // 辅助函数：将节点插入桶链表头部
-    void link_node(HashNode<T>* node, size_type bucket_idx) {
+    void link_node(Node* node, size_type bucket_idx) {
         if (m_buckets[bucket_idx]) {
             m_buckets[bucket_idx]->prev = node;
             node->next = m_buckets[bucket_idx];
+        } else {
+            m_occupied.set(bucket_idx); // 空桶变为非空
         }
         m_buckets[bucket_idx] = node;
         node->prev = nullptr; // 这一句需要吗？答：需要，确保新节点的前驱为空
     }
 
     // 辅助函数：将节点从桶链表中移除
-    void unlink_node(HashNode<T>* node, size_type bucket_idx) {
+    void unlink_node(Node* node, size_type bucket_idx) {
         if (node->prev) {
             node->prev->next = node->next;
         } else {
             m_buckets[bucket_idx] = node->next; // 更新桶头指针
+            if (node->next == nullptr) {
+                m_occupied.clear(bucket_idx); // 桶中最后一个节点被移除
+            }
         }
         if (node->next) {
             node->next->prev = node->prev;
         }
     }
 
-    // 辅助函数：插入节点（统一处理左值和右值）
-    template <typename U>
-    iterator emplace_node(U&& val) {
-        if (m_bucket_count == 0) {
-            m_bucket_count = 16;
-            m_buckets = allocate_buckets(m_bucket_count);
+    // 辅助函数：写出快照，按位图只访问非空桶
+    template <typename Ser, typename Sink>
+    bool save_snapshot(Sink& sink) const {
+        SnapshotWriter<Sink> writer(sink);
+        if (!writer.begin(make_snapshot_header(kSnapshotKindMultiSet, Ser::kRaw, sizeof(T), 0, m_size))) {
+            return false;
         }
+        bool ok = true;
+        for (size_t i = m_occupied.first(); i < m_bucket_count; i = m_occupied.next(i + 1)) {
+            for (const Node* p = m_buckets[i]; p; p = p->next) {
+                if constexpr (Ser::kRaw) {
+                    memcpy(writer.reserve(sizeof(T)), &p->data, sizeof(T));
+                } else {
+                    ok = ok && Ser::save(writer, p->data);
+                }
+            }
+        }
+        return writer.finish() && ok;
+    }
 
-        // 计算哈希和桶索引
-        size_t hash_val = m_hash(val);
-        size_t bucket_idx = hash_val % m_bucket_count;
+    // 辅助函数：读回快照。先读进一个临时容器，全部成功后再移动过来，失败时本容器保持不变
+    template <typename Ser, typename Source>
+    bool load_snapshot(Source& source) {
+        MyUnorderedMultiSet staging(16, m_hash, m_key_eq);
+        staging.m_max_load_factor = m_max_load_factor;
+        if (!staging.template read_snapshot<Ser>(source)) {
+            return false;
+        }
+        HashTableMonitor monitor = m_monitor; // 健康度统计留在本容器
+        *this = std::move(staging);
+        m_monitor = monitor;
+        return true;
+    }
 
-        // 检查重哈希
-        if (load_factor() > m_max_load_factor) {
-            rehash(m_bucket_count * 2);
-            bucket_idx = hash_val % m_bucket_count; // 重新计算桶索引
+    // 辅助函数：把快照读进空容器。头部的元素个数不可信：桶按流中实际能容纳的记录数预留，
+    // 流长度未知时读到新块再翻倍扩大（不超过头部的个数）；桶数组分配失败返回false。
+    // 定长记录直接建节点头插，不经过prepare_bucket的负载检查（集合允许重复，不必查重）
+    template <typename Ser, typename Source>
+    bool read_snapshot(Source& source) {
+        constexpr size_t kRecordBytes = Ser::kRaw ? sizeof(T) : 1;
+        SnapshotReader<Source> reader(source);
+        SnapshotHeader header;
+        if (!reader.begin(header) || !snapshot_header_matches(header, kSnapshotKindMultiSet, Ser::kRaw, sizeof(T), 0)) {
+            return false;
         }
+        uint64_t reserved = header.count > 0 ? reader.record_bound(header.count, kRecordBytes) : 0;
+        if (!try_reserve(reserved)) {
+            return false;
+        }
+        typename Ser::load_type loaded{}; // 读出缓冲在各条记录间复用
+        for (uint64_t i = 0; i < header.count; ++i) {
+            if constexpr (Ser::kRaw) {
+                if (i == reserved) {
+                    uint64_t in_stream = i + reader.available() / kRecordBytes;
+                    reserved = std::min<uint64_t>(header.count, std::max<uint64_t>(reserved * 2, in_stream));
+                    if (!try_reserve(reserved)) {
+                        return false;
+                    }
+                }
+                const unsigned char* p = reader.take(kRecordBytes);
+                if (p == nullptr) {
+                    return false;
+                }
+                T val;
+                memcpy(&val, p, sizeof(T));
+                Node* new_node = construct_in_node(val);
+                size_t hash_val = m_hash(new_node->data);
+                size_t bucket_idx = m_bucket_policy.index(hash_val);
+                new_node->store_hash(hash_val);
+                new_node->bucket_idx = bucket_idx;
+                link_node(new_node, bucket_idx);
+                ++m_size;
+            } else {
+                if (!Ser::load(reader, loaded)) {
+                    return false;
+                }
+                emplace(std::move(loaded));
+            }
+        }
+        return reader.finish();
+    }
+
+    // 辅助函数：插入节点（统一处理左值和右值）
+    template <typename U>
+    iterator emplace_node(U&& val) {
+        // 计算哈希和桶索引（必要时先扩容）
+        size_t hash_val = m_hash(val);
+        size_t bucket_idx = prepare_bucket(hash_val);
 
         // 构造节点（根据val是左值还是右值，调用复制/移动构造函数）
-        HashNode<T>* new_node = new HashNode<T>(std::forward<U>(val), bucket_idx); // 完美转发，
+        Node* new_node = create_node(std::forward<U>(val), bucket_idx); // 完美转发，
         // 完美转发的两个条件：
         // 1. 模板参数U是通过类型推导得到的，这是转发引用的必要条件
         // 2. 传递给构造函数的参数val是通过std::forward<U>(val)传递的
+        new_node->store_hash(hash_val);
         link_node(new_node, bucket_idx);
         ++m_size;
 
@@ -426,7 +719,7 @@ private:
 template <typename T>
 struct DefaultHash {
     size_t operator()(const T& val) const {
-        return static_cast<size_t>(val); // 整数哈希
+        return hash_finalize_mix(static_cast<size_t>(val)); // 整数哈希：fmix64混合，避免连续值集中在少数桶
     }
 };
 
@@ -434,14 +727,7 @@ struct DefaultHash {
 template <>
 struct DefaultHash<const char*> {
     size_t operator()(const char* str) const {
-        size_t hash = 5381; // 初始值
-        while (*str) {
-            hash = ((hash << 5) + hash) + static_cast<size_t>(*str++);
-            // 上一句代码的*str++是什么意思？
-            // *str++表示先取str指向的字符，然后str指针自增，指向下一个字符
-            // str指向的字符指的是字符串中的当前字符，自增后指向下一个字符
-        }
-        return hash;
+        return hash_cstring(str); // wyhash，每步8字节，取代逐字节的djb2
     }
 };
 
@@ -453,18 +739,384 @@ struct DefaultEqual {
     }
 };
 
-// 字符串相等比较特化
+// 字符串相等比较特化（string_simd.h：每次比较一个向量宽度，同时找'\0'）
 template <>
 struct DefaultEqual<const char*> {
     bool operator()(const char* a, const char* b) const {
-        while (*a && *b && *a == *b) {
-            ++a;
-            ++b;
-            // 指针的++是什么意思？答：指针的++表示指针向后移动一个位置，指向下一个内存地址
-            // 如果这是一个int类型的指针，则会移动4个字节（假设int是4字节）
-            // 如果这是一个char类型的指针，则会移动1个字节
-            // 也就是说：指针的++会根据指针类型移动相应的字节数
+        return simd_strequal(a, b);
+    }
+};
+
+// ------- 计数模式：每个不同的值只存一次，附带64位重数 ------- //
+// MyUnorderedMultiSet的每个重复元素都单独占一个节点（数据 + next/prev/bucket_idx），
+// 同一个值插入上百万次就是上百万个节点。MyCountedMultiSet对每个不同的值只建一个节点，节点里记录它出现的次数：
+// - count(val)：O(1)，查到节点直接返回重数
+// - erase(val)：删除全部重复，O(1)摘下一个节点
+// - erase_one(val)：只删一个，重数减一，减到0才释放节点
+// - 迭代器仍然逐个产出每一个重复（同一节点产出count次），与MyUnorderedMultiSet的遍历结果一致
+// 适用于元素可以互相替代的场景：相等的元素被视为同一个，不能保存“相等但不完全相同”的对象。
+template <typename T, bool CacheHash = false>
+struct CountedHashNode : CachedHashCode<CacheHash> {
+    T data;
+    uint64_t count; // 重数
+    CountedHashNode* next;
+
+    template <typename U>
+    CountedHashNode(U&& val, uint64_t n) : data(std::forward<U>(val)), count(n), next(nullptr) {}
+};
+
+template <typename T,
+          typename Hash = DefaultHash<T>,
+          typename KeyEqual = DefaultEqual<T>,
+          typename BucketPolicy = PrimeBucketPolicy,
+          template <typename> class NodeAllocator = SlabNodeAllocator,
+          bool CacheHash = false>
+class MyCountedMultiSet {
+private:
+    using Node = CountedHashNode<T, CacheHash>;
+
+public:
+    using value_type = T;
+    using size_type = uint64_t; // 重数可能超过32位
+
+    // 前向迭代器：(节点, 已产出的重复个数, 所在桶)
+    class iterator {
+    private:
+        Node* m_node;
+        uint64_t m_rep; // 当前节点已产出到第几个重复
+        size_t m_bucket;
+        const MyCountedMultiSet* m_container;
+        friend class MyCountedMultiSet;
+
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = T;
+        using reference = const T&; // 重复元素共享同一份数据，只读
+        using pointer = const T*;
+        using difference_type = ptrdiff_t;
+
+        iterator() : m_node(nullptr), m_rep(0), m_bucket(0), m_container(nullptr) {}
+        iterator(Node* node, size_t bucket, const MyCountedMultiSet* container)
+            : m_node(node), m_rep(0), m_bucket(bucket), m_container(container) {}
+
+        reference operator*() const {
+            return m_node->data;
+        }
+
+        pointer operator->() const {
+            return &(m_node->data);
+        }
+
+        iterator& operator++() {
+            if (++m_rep < m_node->count) {
+                return *this; // 同一个值还有重复没产出
+            }
+            m_rep = 0;
+            if (m_node->next) {
+                m_node = m_node->next;
+                return *this;
+            }
+            for (size_t i = m_bucket + 1; i < m_container->m_bucket_count; ++i) {
+                if (m_container->m_buckets[i]) {
+                    m_node = m_container->m_buckets[i];
+                    m_bucket = i;
+                    return *this;
+                }
+            }
+            m_node = nullptr;
+            return *this;
+        }
+
+        iterator operator++(int) {
+            iterator tmp = *this;
+            ++(*this);
+            return tmp;
+        }
+
+        // 当前值的重数（迭代器停在同一个值的哪个重复上不影响结果）
+        uint64_t multiplicity() const {
+            return m_node->count;
+        }
+
+        bool operator==(const iterator& other) const {
+            return m_node == other.m_node && m_rep == other.m_rep;
+        }
+
+        bool operator!=(const iterator& other) const {
+            return !(*this == other);
+        }
+    };
+
+    explicit MyCountedMultiSet(size_t bucket_count = 16,
+                               const Hash& hash = Hash(),
+                               const KeyEqual& key_eq = KeyEqual())
+        : m_distinct(0), m_size(0), m_hash(hash), m_key_eq(key_eq), m_max_load_factor(0.7f) {
+        m_bucket_count = m_bucket_policy.reset(bucket_count);
+        m_buckets = allocate_buckets(m_bucket_count);
+    }
+
+    MyCountedMultiSet(const MyCountedMultiSet&) = delete;
+    MyCountedMultiSet& operator=(const MyCountedMultiSet&) = delete;
+
+    ~MyCountedMultiSet() {
+        clear();
+        free(m_buckets);
+    }
+
+    // 插入n个val（默认1个），返回指向该值的迭代器
+    iterator insert(const T& val, uint64_t n = 1) {
+        return insert_counted(val, n);
+    }
+
+    iterator insert(T&& val, uint64_t n = 1) {
+        return insert_counted(std::move(val), n);
+    }
+
+    // O(1)：查到节点直接返回重数
+    size_type count(const T& val) const {
+        Node* node = find_node(val, m_hash(val));
+        return node ? node->count : 0;
+    }
+
+    iterator find(const T& val) const {
+        size_t hash_val = m_hash(val);
+        size_t bucket_idx = m_bucket_policy.index(hash_val);
+        Node* node = find_node(val, hash_val);
+        return node ? iterator(node, bucket_idx, this) : end();
+    }
+
+    // 删除val的全部重复，返回删除个数
+    size_type erase(const T& val) {
+        size_t hash_val = m_hash(val);
+        Node** link = find_link(val, hash_val);
+        if (link == nullptr) {
+            return 0;
+        }
+        Node* node = *link;
+        uint64_t removed = node->count;
+        *link = node->next;
+        destroy_node(node);
+        --m_distinct;
+        m_size -= removed;
+        return removed;
+    }
+
+    // 只删除一个val，返回是否删除
+    bool erase_one(const T& val) {
+        size_t hash_val = m_hash(val);
+        Node** link = find_link(val, hash_val);
+        if (link == nullptr) {
+            return false;
+        }
+        Node* node = *link;
+        --m_size;
+        if (--node->count == 0) {
+            *link = node->next;
+            destroy_node(node);
+            --m_distinct;
+        }
+        return true;
+    }
+
+    // 预留能容纳n个不同值的桶
+    void reserve(size_t n) {
+        rehash(static_cast<size_t>(n / m_max_load_factor) + 1);
+    }
+
+    void rehash(size_t new_bucket_count) {
+        if (new_bucket_count <= m_bucket_count) {
+            return;
+        }
+        uint64_t start_ns = HashTableMonitor::now_ns();
+        BucketPolicy new_policy;
+        new_bucket_count = new_policy.reset(new_bucket_count);
+        Node** new_buckets = allocate_buckets(new_bucket_count);
+        for (size_t i = 0; i < m_bucket_count; ++i) {
+            Node* p = m_buckets[i];
+            while (p) {
+                Node* next = p->next;
+                size_t new_idx = new_policy.index(node_hash(p));
+                p->next = new_buckets[new_idx];
+                new_buckets[new_idx] = p;
+                p = next;
+            }
+        }
+        free(m_buckets);
+        m_monitor.record_rehash(m_distinct, m_bucket_count, new_bucket_count, HashTableMonitor::now_ns() - start_ns);
+        m_buckets = new_buckets;
+        m_bucket_count = new_bucket_count;
+        m_bucket_policy = new_policy;
+    }
+
+    void clear() {
+        constexpr bool bulk = NodeAllocator<Node>::kReleaseAll;
+        for (size_t i = 0; i < m_bucket_count; ++i) {
+            if (!bulk || !std::is_trivially_destructible<Node>::value) {
+                Node* p = m_buckets[i];
+                while (p) {
+                    Node* next = p->next;
+                    if (bulk) {
+                        p->~Node();
+                    } else {
+                        destroy_node(p);
+                    }
+                    p = next;
+                }
+            }
+            m_buckets[i] = nullptr;
+        }
+        m_node_alloc.release_all();
+        m_distinct = 0;
+        m_size = 0;
+    }
+
+    iterator begin() const {
+        for (size_t i = 0; i < m_bucket_count; ++i) {
+            if (m_buckets[i]) {
+                return iterator(m_buckets[i], i, this);
+            }
+        }
+        return end();
+    }
+
+    iterator end() const {
+        return iterator(nullptr, 0, this);
+    }
+
+    // 按不同的值遍历：fn(const T&, uint64_t重数)，比逐个重复遍历快得多
+    template <typename Fn>
+    void for_each_distinct(Fn fn) const {
+        for (size_t i = 0; i < m_bucket_count; ++i) {
+            for (const Node* p = m_buckets[i]; p; p = p->next) {
+                fn(static_cast<const T&>(p->data), p->count);
+            }
         }
-        return *a == *b;
     }
-};
\ No newline at end of file
+
+    // 全部元素个数（含重复）
+    size_type size() const {
+        return m_size;
+    }
+    // 不同值的个数（即节点数）
+    size_t distinct_count() const {
+        return m_distinct;
+    }
+    bool empty() const {
+        return m_size == 0;
+    }
+    size_t bucket_count() const {
+        return m_bucket_count;
+    }
+    // 负载因子按不同值的个数计算
+    float load_factor() const {
+        return m_bucket_count == 0 ? 0.0f : static_cast<float>(m_distinct) / m_bucket_count;
+    }
+    float max_load_factor() const {
+        return m_max_load_factor;
+    }
+    void max_load_factor(float lf) {
+        m_max_load_factor = lf;
+    }
+
+    // 健康度快照，见hash_table_stats.h（size字段为不同值的个数）
+    HashTableStats stats() const {
+        HashTableStats out;
+        m_monitor.fill(out, m_distinct, m_bucket_count, [this](size_t i) {
+            size_t len = 0;
+            for (const Node* p = m_buckets[i]; p; p = p->next) {
+                ++len;
+            }
+            return len;
+        });
+        return out;
+    }
+
+private:
+    Node** m_buckets = nullptr;
+    size_t m_bucket_count;
+    size_t m_distinct; // 不同值的个数
+    uint64_t m_size; // 含重复的元素总数
+    Hash m_hash;
+    KeyEqual m_key_eq;
+    float m_max_load_factor;
+    BucketPolicy m_bucket_policy;
+    NodeAllocator<Node> m_node_alloc;
+    mutable HashTableMonitor m_monitor;
+
+    static Node** allocate_buckets(size_t n) {
+        auto buckets = static_cast<Node**>(malloc(n * sizeof(Node*)));
+        for (size_t i = 0; i < n; ++i) {
+            buckets[i] = nullptr;
+        }
+        return buckets;
+    }
+
+    size_t node_hash(const Node* node) const {
+        if constexpr (CacheHash) {
+            return node->hash_code;
+        } else {
+            return m_hash(node->data);
+        }
+    }
+
+    Node* find_node(const T& val, size_t hash_val) const {
+        bool sampled = m_monitor.sample_find();
+        size_t probes = 0;
+        for (Node* p = m_buckets[m_bucket_policy.index(hash_val)]; p; p = p->next) {
+            ++probes;
+            if (p->hash_may_equal(hash_val) && m_key_eq(p->data, val)) {
+                if (sampled) {
+                    m_monitor.record_probe(probes);
+                }
+                return p;
+            }
+        }
+        if (sampled) {
+            m_monitor.record_probe(probes);
+        }
+        return nullptr;
+    }
+
+    // 返回指向匹配节点的链接（桶头或前一节点的next），便于单链表摘除
+    Node** find_link(const T& val, size_t hash_val) {
+        Node** link = &m_buckets[m_bucket_policy.index(hash_val)];
+        while (*link) {
+            Node* p = *link;
+            if (p->hash_may_equal(hash_val) && m_key_eq(p->data, val)) {
+                return link;
+            }
+            link = &p->next;
+        }
+        return nullptr;
+    }
+
+    void destroy_node(Node* node) {
+        node->~Node();
+        m_node_alloc.deallocate(node);
+    }
+
+    template <typename U>
+    iterator insert_counted(U&& val, uint64_t n) {
+        if (n == 0) {
+            return end(); // 不建重数为0的节点
+        }
+        size_t hash_val = m_hash(val);
+        Node* node = find_node(val, hash_val);
+        if (node) {
+            node->count += n;
+            m_size += n;
+            return iterator(node, m_bucket_policy.index(hash_val), this);
+        }
+        if (m_distinct + 1 > m_bucket_count * m_max_load_factor) {
+            rehash(m_bucket_count * 2);
+        }
+        size_t bucket_idx = m_bucket_policy.index(hash_val);
+        node = new (m_node_alloc.allocate()) Node(std::forward<U>(val), n);
+        node->store_hash(hash_val);
+        node->next = m_buckets[bucket_idx];
+        m_buckets[bucket_idx] = node;
+        ++m_distinct;
+        m_size += n;
+        return iterator(node, bucket_idx, this);
+    }
+};
@@ -2,6 +2,8 @@
 #include <cstddef> // size_t
 #include <cstring> // 用于字符串哈希计算
 #include <cmath> // 用于浮点数哈希计算
+#include "hash_function.h" // 默认哈希函数（整数混合、字节串wyhash）
+#include "hash_bucket_policy.h" // 桶索引策略（质数表/2的幂掩码）
 
 // 自定义相等性比较：默认使用==运算符
 template <typename T>
@@ -19,8 +21,8 @@ struct MyHash;
 template <>
 struct MyHash<int> {
     size_t operator()(int val) const {
-        // 简单哈希：直接返回值，对于小整数效果较好
-        return static_cast<size_t>(val);
+        // 直接返回值会让连续/等步长的整数集中在少数桶里，先经fmix64混合
+        return hash_finalize_mix(static_cast<size_t>(static_cast<unsigned int>(val)));
     }
 };
 
@@ -28,7 +30,7 @@ struct MyHash<int> {
 template <>
 struct MyHash<unsigned int> {
     size_t operator()(unsigned int val) const {
-        return static_cast<size_t>(val);
+        return hash_finalize_mix(static_cast<size_t>(val));
     }
 };
 
@@ -36,9 +38,8 @@ struct MyHash<unsigned int> {
 template <>
 struct MyHash<long> {
     size_t operator()(long val) const {
-        // 处理负数：转为无符号值
-        return static_cast<size_t>(val ^ (val >> 32)); // 如何理解这一句：
-        // 这里假设long是64位，size_t也是64位。将long的高32位和低32位进行异或操作，混合高低位的信息，得到一个更均匀分布的哈希值。
+        // 处理负数：转为无符号值后整体混合（只把高低32位异或，低位仍只取决于少数输入位）
+        return hash_finalize_mix(static_cast<size_t>(static_cast<unsigned long>(val)));
     }
 };
 
@@ -46,16 +47,8 @@ struct MyHash<long> {
 template <>
 struct MyHash<double> {
     size_t operator()(double val) const {
-        // 将double的二进制标识转为size_t，作为哈希值
-        union {
-            double d;
-            unsigned long long u;
-        } u{val};
-        return static_cast<size_t>(u.u ^ (u.u >> 32)); // 如何理解这一句：
-        // 这里假设unsigned long long是64位，size_t也是64位。将u.u的高32位和低32位进行异或操作，混合高低位的信息，得到一个更均匀分布的哈希值。
-        // u.u是什么意思？u是一个联合体变量，u.u表示访问联合体中的成员u，它是一个unsigned long long类型，存储了double的二进制表示。
-        // 为什么联合体u有两个成员？因为联合体的所有成员共享同一块内存空间，可以通过不同成员以不同类型访问同一块内存。
-        // 其中的d成员用于存储double值，u成员用于以unsigned long long类型访问该double的二进制表示。
+        // 按double的二进制表示混合；+0.0和-0.0相等，hash_double保证二者哈希值相同
+        return hash_double(val);
     }
 };
 
@@ -63,20 +56,8 @@ struct MyHash<double> {
 template <>
 struct MyHash<const char*> {
     size_t operator()(const char* str) const {
-        if (str == nullptr) {
-            return 0;
-        }
-        // 经典的字符串哈希算法：djb2
-        size_t hash = 5381;
-        int c;
-        while ((c = *str++)) { // *str++如何理解？
-            // 这里的*str++表示先解引用获取当前字符，然后将指针移动到下一个字符位置。
-            // 等价于：
-            // c = *str; c是当前字符，为什么用int类型？因为需要存储EOF等特殊值。
-            // str = str + 1; 将指针移动到下一个字符。指针加1会根据指针类型自动移动相应的字节数。
-            hash = ((hash << 5) + hash) + c; // hash * 33 + c
-        }
-        return hash;
+        // wyhash：每步8字节，取代逐字节的djb2（hash * 33 + c）
+        return hash_cstring(str);
     }
 };
 
@@ -268,10 +249,12 @@ public:
 // ------- 自定义哈希集合类 ------- //
 template <typename T,
           typename Hash = MyHash<T>,
-          typename KeyEqual = MyEqual<T>>
+          typename KeyEqual = MyEqual<T>,
+          typename BucketPolicy = PrimeBucketPolicy>
 class MyUnordered {
 private:
     using Bucket = LinkedList<T>; // 每个桶是自定义链表
+    BucketPolicy bucket_policy_; // 桶索引策略（需先于buckets_初始化，由它决定桶数量）
     DynamicArray<Bucket> buckets_; // 桶的动态数组
     size_t size_; // 元素总数
     Hash hasher_; // 哈希函数对象
@@ -281,7 +264,7 @@ private:
 private:
     // 计算桶索引
     size_t get_bucket_index(const T& key) const {
-        return hasher_(key) % buckets_.capacity();
+        return bucket_policy_.index(hasher_(key));
     }
 
     // 重哈希：扩容并且迁移元素
@@ -289,6 +272,8 @@ private:
         if (new_bucket_count <= buckets_.capacity()) {
             return; // 此时不需要扩容
         }
+        BucketPolicy new_policy;
+        new_bucket_count = new_policy.reset(new_bucket_count); // 向上取整到策略支持的桶数
         DynamicArray<Bucket> new_buckets(new_bucket_count);
         // 上一句代码的解释：调用DynamicArray的DynamicArray(size_t n) 构造函数
 
@@ -296,19 +281,20 @@ private:
         for (size_t i = 0; i < buckets_.capacity(); ++i) {
             const Bucket& old_bucket = buckets_[i];
             old_bucket.for_each([&](const T& elem) {
-                size_t new_idx = hasher_(elem) % new_bucket_count;
+                size_t new_idx = new_policy.index(hasher_(elem));
                 new_buckets[new_idx].push_back(elem);
             });
         }
 
         // 交换新旧桶数组
         buckets_.swap(new_buckets);
+        bucket_policy_ = new_policy;
     }
 
 public:
     // 构造函数
     explicit MyUnordered(size_t bucket_count = 11, float max_load_factor = 1.0f) 
-        : buckets_(bucket_count), size_(0), max_load_factor_(max_load_factor) {}
+        : buckets_(bucket_policy_.reset(bucket_count)), size_(0), max_load_factor_(max_load_factor) {}
 
     // 析构函数：依赖DynamicArray和LinkedList的析构函数自动释放内存
     ~MyUnordered() = default;
@@ -317,14 +303,14 @@ public:
     bool insert(const T& key) {
         // 检查是否需要重哈希
         if (load_factor() > max_load_factor_) {
-            rehash(buckets_.capacity() * 2 + 1); // 新桶数：原大小*2+1（保证质数特性）
+            rehash(buckets_.capacity() * 2 + 1); // 新桶数：原大小*2+1，实际桶数由策略向上取整
         }
 
         size_t idx = get_bucket_index(key);
         Bucket& bucket = buckets_[idx];
 
         // 检查元素是否已经存在
-        if (bucket.contains(key, key_eq)) {
+        if (bucket.contains(key, key_eq_)) {
             return false; // 插入失败，因为元素已经存在
         }
 
@@ -380,4 +366,12 @@ public:
     size_t bucket_count() const {
         return buckets_.capacity();
     }
+
+    // 遍历所有元素（顺序不确定），func(const T&)；遍历期间不能修改集合
+    template <typename Func>
+    void for_each(Func func) const {
+        for (size_t i = 0; i < buckets_.capacity(); ++i) {
+            buckets_[i].for_each(func);
+        }
+    }
 };
\ No newline at end of file
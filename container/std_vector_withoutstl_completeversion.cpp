@@ -144,17 +144,17 @@ public:
     const_reverse_iterator rbegin() const noexcept {
         return const_reverse_iterator(end());
     }
-    const_reserve_iterator crbegin() const noexcept {
-        return const_reserve_iterator(end());A
+    const_reverse_iterator crbegin() const noexcept {
+        return const_reverse_iterator(end());
     }
 
     reverse_iterator rend() noexcept {
         return reverse_iterator(begin());
     }
-    const_reserve_iterator rend() const noexcept {
+    const_reverse_iterator rend() const noexcept {
         return const_reverse_iterator(begin());
     }
-    const_reserve_iterator crend() const noexcept {
+    const_reverse_iterator crend() const noexcept {
         return const_reverse_iterator(begin());
     }
 
@@ -245,7 +245,7 @@ public:
             if (new_size > capacity_) {
                 reserve(new_size);
             }
-            construct_range(data_ + size_, new_size - size_, value); // 拷贝构造新增元素
+            construct_n(data_ + size_, new_size - size_, value); // 拷贝构造新增元素
         } else if (new_size < size_) {
             // 销毁多余元素
             destroy_range(data_ + new_size, data_ + size_);
@@ -321,7 +321,7 @@ private:
     }
 
     // 释放原始内存（不销毁元素）
-    static void deallocate(pointer p, size_type n) {
+    static void deallocate(pointer p) {
         if (p) {
             ::operator delete[](p); // 释放以p为起始地址的内存块，释放多少个呢？
             // C++标准规定，delete[]不需要知道具体释放多少个元素
@@ -330,14 +330,14 @@ private:
     }
 
     // 构造n个值初始化的元素(T())
-    static void contruct_n(pointer p, size_type n) {
+    static void construct_n(pointer p, size_type n) {
         for (size_type i = 0; i < n; ++i) {
             new (p + i) T(); // value-initialize，调用T类型的默认构造函数
         }
     }
 
     // 构造n个用value拷贝初始化的元素
-    static void contruct_n(pointer p, size_type n, const T& value) {
+    static void construct_n(pointer p, size_type n, const T& value) {
         for (size_type i = 0; i < n; ++i) {
             new (p + i) T(value); // copy-construct,调用T类型的拷贝构造函数
         }
@@ -0,0 +1,138 @@
+#ifndef STRING_ARENA_H
+#define STRING_ARENA_H
+
+#include <cstddef> // size_t
+#include <cstring> // memcpy
+#include <new> // ::operator new / ::operator delete
+#include <utility> // std::swap
+
+// ------- 字符串键竞技场（arena） ------- //
+// 以char*为键的哈希容器把所有键字节连续存放在这里，不再为每个键单独malloc/free。
+// 每条记录的布局：[StringHeader{hash, len}][len个字节]['\0']，对外返回的指针指向字节部分，
+// 因此它仍是普通的以'\0'结尾的C字符串，同时可以O(1)取回预先算好的长度和哈希值。
+// 记录只追加不单独回收：erase的键占用的空间在clear()或析构时随整个块一起释放。
+class StringArena {
+public:
+    struct StringHeader {
+        size_t hash;
+        size_t len;
+    };
+
+    static constexpr size_t kChunkSize = 64 * 1024; // 普通块大小，超长键单独占一个块
+
+    StringArena() = default;
+
+    StringArena(const StringArena&) = delete;
+    StringArena& operator=(const StringArena&) = delete;
+
+    ~StringArena() {
+        clear();
+    }
+
+    // 复制len个字节（不要求data以'\0'结尾），返回arena中以'\0'结尾的副本
+    char* intern(const char* data, size_t len, size_t hash) {
+        size_t need = record_size(len);
+        unsigned char* base;
+        if (need > kChunkSize) {
+            base = add_large_chunk(need);
+        } else {
+            if (chunks_ == nullptr || chunk_used_ + need > chunks_->capacity) {
+                add_chunk();
+            }
+            base = chunk_data(chunks_) + chunk_used_;
+            chunk_used_ += need;
+        }
+        bytes_used_ += need;
+
+        StringHeader* header = reinterpret_cast<StringHeader*>(base);
+        header->hash = hash;
+        header->len = len;
+        char* str = reinterpret_cast<char*>(base + sizeof(StringHeader));
+        memcpy(str, data, len);
+        str[len] = '\0';
+        return str;
+    }
+
+    // 取回intern时记录的长度/哈希（s必须是intern返回的指针）
+    static size_t length(const char* s) {
+        return header_of(s)->len;
+    }
+
+    static size_t hash(const char* s) {
+        return header_of(s)->hash;
+    }
+
+    // 释放所有块
+    void clear() {
+        while (chunks_) {
+            Chunk* next = chunks_->next;
+            ::operator delete(chunks_);
+            chunks_ = next;
+        }
+        chunk_used_ = 0;
+        bytes_used_ = 0;
+    }
+
+    // 与other交换全部块（已返回的指针仍然有效，只是改归对方所有）
+    void swap(StringArena& other) noexcept {
+        std::swap(chunks_, other.chunks_);
+        std::swap(chunk_used_, other.chunk_used_);
+        std::swap(bytes_used_, other.bytes_used_);
+    }
+
+    // 已使用的字节数（含记录头）
+    size_t bytes_used() const {
+        return bytes_used_;
+    }
+
+private:
+    struct Chunk {
+        Chunk* next;
+        size_t capacity;
+    };
+
+    static constexpr size_t kAlign = alignof(StringHeader);
+    static constexpr size_t kChunkHeader = (sizeof(Chunk) + kAlign - 1) / kAlign * kAlign;
+
+    Chunk* chunks_ = nullptr; // 块链表（最新的在表头，只在表头块中追加）
+    size_t chunk_used_ = 0; // 表头块已使用的字节数
+    size_t bytes_used_ = 0;
+
+    static size_t record_size(size_t len) {
+        size_t raw = sizeof(StringHeader) + len + 1;
+        return (raw + kAlign - 1) / kAlign * kAlign; // 保证下一条记录的头部对齐
+    }
+
+    static const StringHeader* header_of(const char* s) {
+        return reinterpret_cast<const StringHeader*>(s - sizeof(StringHeader));
+    }
+
+    static unsigned char* chunk_data(Chunk* chunk) {
+        return reinterpret_cast<unsigned char*>(chunk) + kChunkHeader;
+    }
+
+    void add_chunk() {
+        Chunk* chunk = static_cast<Chunk*>(::operator new(kChunkHeader + kChunkSize));
+        chunk->capacity = kChunkSize;
+        chunk->next = chunks_;
+        chunks_ = chunk;
+        chunk_used_ = 0;
+    }
+
+    // 超长键单独占一个块，挂在当前块之后，当前块的剩余空间继续使用
+    unsigned char* add_large_chunk(size_t need) {
+        Chunk* chunk = static_cast<Chunk*>(::operator new(kChunkHeader + need));
+        chunk->capacity = need;
+        if (chunks_ == nullptr) {
+            chunk->next = nullptr;
+            chunks_ = chunk;
+            chunk_used_ = need; // 已满，下一次普通分配会新开一个块
+        } else {
+            chunk->next = chunks_->next;
+            chunks_->next = chunk;
+        }
+        return chunk_data(chunk);
+    }
+};
+
+#endif // STRING_ARENA_H
@@ -0,0 +1,195 @@
+#ifndef STRING_SIMD_H
+#define STRING_SIMD_H
+
+#include <cstddef> // size_t
+#include <cstdint> // uint32_t、uint64_t、uintptr_t
+#include <cstdlib> // malloc
+#include <cstring> // memcpy
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#define STRING_SIMD_WIDTH 32
+#elif defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#define STRING_SIMD_WIDTH 16
+#else
+#define STRING_SIMD_WIDTH 8 // 没有SIMD指令集：按64位字一次处理8字节
+#endif
+
+// 这些函数会读到字符串结尾之后（不跨页），对AddressSanitizer来说是越界读，关闭它对这几个函数的检查
+#if defined(__clang__) || defined(__GNUC__)
+#define STRING_SIMD_NO_ASAN __attribute__((no_sanitize_address))
+#else
+#define STRING_SIMD_NO_ASAN
+#endif
+
+// ------- 以'\0'结尾字符串的SIMD基本操作 ------- //
+// 逐字节循环每次迭代只处理1个字节；这里每次处理一个向量宽度（AVX2 32字节 / SSE2 16字节 / 纯标量8字节的字），
+// 指令集按编译选项在编译期选择（-mavx2打开AVX2，x86-64默认就有SSE2）。
+// 跨页安全：读取不能越过字符串所在的页，否则字符串恰好在页尾、下一页未映射时会段错误。
+// - simd_strlen：从宽度对齐的地址开始整块读取，对齐的块不会跨页；块内起点之前的字节用移位丢掉
+// - simd_strequal / simd_strcmp：两个指针的对齐不同，无法同时对齐；每次整块读取前检查两个指针到各自页尾
+//   是否还有一个宽度，不够时这一步改为逐字节比较，过了页边界再恢复整块读取
+// 整块里同时找“两边不相等的字节”和“结尾的'\0'”，第一个这样的位置就决定了结果。
+
+namespace string_simd_detail {
+
+constexpr size_t kWidth = STRING_SIMD_WIDTH;
+constexpr unsigned kMaskBitsPerByte = STRING_SIMD_WIDTH == 8 ? 8 : 1; // 掩码中每个字节占的位数（标量回退为8）
+constexpr uintptr_t kPageSize = 4096;
+
+// p开始的kWidth个字节是否都在p所在的页内
+inline bool block_in_page(const void* p) {
+    return (reinterpret_cast<uintptr_t>(p) & (kPageSize - 1)) <= kPageSize - kWidth;
+}
+
+inline unsigned count_trailing_zeros(uint64_t mask) {
+#if defined(__GNUC__) || defined(__clang__)
+    return static_cast<unsigned>(__builtin_ctzll(mask));
+#else
+    unsigned n = 0;
+    while ((mask & 1) == 0) {
+        mask >>= 1;
+        ++n;
+    }
+    return n;
+#endif
+}
+
+#if STRING_SIMD_WIDTH == 32
+// 32字节对齐的块中等于0的字节对应的位
+STRING_SIMD_NO_ASAN inline uint64_t zero_mask(const void* p) {
+    __m256i v = _mm256_load_si256(static_cast<const __m256i*>(p));
+    return static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(v, _mm256_setzero_si256())));
+}
+
+// 两个32字节块中 不相等或a为'\0' 的字节对应的位
+STRING_SIMD_NO_ASAN inline uint64_t stop_mask(const void* a, const void* b) {
+    __m256i va = _mm256_loadu_si256(static_cast<const __m256i*>(a));
+    __m256i vb = _mm256_loadu_si256(static_cast<const __m256i*>(b));
+    uint32_t eq = static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(va, vb)));
+    uint32_t zero = static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(va, _mm256_setzero_si256())));
+    return ~eq | zero;
+}
+#elif STRING_SIMD_WIDTH == 16
+STRING_SIMD_NO_ASAN inline uint64_t zero_mask(const void* p) {
+    __m128i v = _mm_load_si128(static_cast<const __m128i*>(p));
+    return static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(v, _mm_setzero_si128())));
+}
+
+STRING_SIMD_NO_ASAN inline uint64_t stop_mask(const void* a, const void* b) {
+    __m128i va = _mm_loadu_si128(static_cast<const __m128i*>(a));
+    __m128i vb = _mm_loadu_si128(static_cast<const __m128i*>(b));
+    uint32_t eq = static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(va, vb)));
+    uint32_t zero = static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(va, _mm_setzero_si128())));
+    return (~eq & 0xffffu) | zero;
+}
+#else
+// 标量回退：在64位字上逐字节判断，掩码中第i个字节的最高位对应第i个字节（因此下标要除以8）
+// 大端机器上先把字节序翻转过来，使第0个字节总在最低位
+STRING_SIMD_NO_ASAN inline uint64_t load_word(const void* p) {
+    uint64_t v;
+    memcpy(&v, p, 8);
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+    v = __builtin_bswap64(v);
+#endif
+    return v;
+}
+
+// 非0字节的最高位置1（每个字节单独计算，不会向相邻字节借位/进位，所以每一位都准确）
+inline uint64_t word_nonzero_bytes(uint64_t v) {
+    return (((v & 0x7f7f7f7f7f7f7f7fULL) + 0x7f7f7f7f7f7f7f7fULL) | v) & 0x8080808080808080ULL;
+}
+
+STRING_SIMD_NO_ASAN inline uint64_t zero_mask(const void* p) {
+    return ~word_nonzero_bytes(load_word(p)) & 0x8080808080808080ULL;
+}
+
+STRING_SIMD_NO_ASAN inline uint64_t stop_mask(const void* a, const void* b) {
+    uint64_t va = load_word(a);
+    return word_nonzero_bytes(va ^ load_word(b)) | (~word_nonzero_bytes(va) & 0x8080808080808080ULL);
+}
+#endif
+
+// 掩码中第一个置位对应的字节下标
+inline unsigned first_byte(uint64_t mask) {
+    return count_trailing_zeros(mask) / kMaskBitsPerByte;
+}
+
+// 找到第一个不相等或结尾的位置，返回该位置的两个字节
+STRING_SIMD_NO_ASAN inline void first_difference(const char* a, const char* b, unsigned char& ca, unsigned char& cb) {
+    for (;;) {
+        if (block_in_page(a) && block_in_page(b)) {
+            uint64_t mask = stop_mask(a, b);
+            if (mask != 0) {
+                unsigned i = first_byte(mask);
+                ca = static_cast<unsigned char>(a[i]);
+                cb = static_cast<unsigned char>(b[i]);
+                return;
+            }
+            a += kWidth;
+            b += kWidth;
+        } else {
+            // 靠近页尾：逐字节前进，直到两个指针都离开页尾的危险区
+            ca = static_cast<unsigned char>(*a);
+            cb = static_cast<unsigned char>(*b);
+            if (ca != cb || ca == '\0') {
+                return;
+            }
+            ++a;
+            ++b;
+        }
+    }
+}
+
+} // namespace string_simd_detail
+
+// 字符串长度（不含'\0'）
+STRING_SIMD_NO_ASAN inline size_t simd_strlen(const char* str) {
+    using namespace string_simd_detail;
+    uintptr_t offset = reinterpret_cast<uintptr_t>(str) & (kWidth - 1);
+    const char* block = str - offset; // 对齐的块永远不会跨页
+    uint64_t mask = zero_mask(block) >> (offset * kMaskBitsPerByte); // 丢掉str之前的字节
+    if (mask != 0) {
+        return first_byte(mask);
+    }
+    for (;;) {
+        block += kWidth;
+        mask = zero_mask(block);
+        if (mask != 0) {
+            return static_cast<size_t>(block - str) + first_byte(mask);
+        }
+    }
+}
+
+// 相等返回true
+inline bool simd_strequal(const char* a, const char* b) {
+    if (a == b) {
+        return true;
+    }
+    unsigned char ca, cb;
+    string_simd_detail::first_difference(a, b, ca, cb);
+    return ca == cb;
+}
+
+// 与strcmp相同的约定：按无符号字节比较，返回值的符号表示大小关系
+inline int simd_strcmp(const char* a, const char* b) {
+    if (a == b) {
+        return 0;
+    }
+    unsigned char ca, cb;
+    string_simd_detail::first_difference(a, b, ca, cb);
+    return static_cast<int>(ca) - static_cast<int>(cb);
+}
+
+// 复制到新malloc的内存（含'\0'）；长度由simd_strlen求出，复制交给memcpy（库实现已使用最宽的向量指令）
+inline char* simd_strdup(const char* str) {
+    size_t len = simd_strlen(str);
+    char* copy = static_cast<char*>(malloc(len + 1));
+    if (copy != nullptr) {
+        memcpy(copy, str, len + 1);
+    }
+    return copy;
+}
+
+#endif // STRING_SIMD_H
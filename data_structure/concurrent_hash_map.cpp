@@ -0,0 +1,135 @@
+// 分段锁并发哈希表：N个独立加锁的分片，每个分片是一个MyUnorderedMap
+#include <cstddef> // size_t
+#include <mutex> // std::mutex、std::lock_guard
+#include "../container/std_unordered_map_withoutstl.cpp"
+
+// ------- 分段锁并发哈希表 ------- //
+// 键的哈希值先经hash_finalize_mix混合，再取高位选择分片；分片内部的MyUnorderedMap用低位（取模）选桶，
+// 两者使用哈希值的不同部分，避免同一分片里的键全部挤在少数几个桶中。
+// 所有对外接口都只锁一个分片，不同分片上的操作完全并行。
+template <typename Key,
+          typename Value,
+          size_t ShardCount = 64, // 分片数量，必须是2的幂
+          typename Hash = MyHash<Key>,
+          typename KeyEqual = KeyEqual<Key>>
+class MyConcurrentHashMap {
+    static_assert(ShardCount > 0 && (ShardCount & (ShardCount - 1)) == 0, "ShardCount必须是2的幂");
+
+private:
+    using Map = MyUnorderedMap<Key, Value, Hash, KeyEqual>;
+
+    // 每个分片独占一条缓存行，避免相邻分片的锁互相伪共享
+    struct alignas(64) Shard {
+        std::mutex mutex;
+        Map map;
+    };
+
+    Shard shards_[ShardCount];
+    Hash hash_func;
+
+private:
+    // log2(ShardCount)
+    static constexpr unsigned shard_bits() {
+        unsigned bits = 0;
+        while ((size_t(1) << bits) < ShardCount) {
+            ++bits;
+        }
+        return bits;
+    }
+
+    // 取混合后哈希的高shard_bits()位作为分片下标
+    Shard& shard_for(const Key& key) {
+        if (ShardCount == 1) {
+            return shards_[0];
+        }
+        size_t mixed = hash_finalize_mix(hash_func(key));
+        return shards_[mixed >> (sizeof(size_t) * 8 - shard_bits())];
+    }
+
+public:
+    MyConcurrentHashMap() = default;
+
+    // 禁止拷贝（分片中含有互斥锁）
+    MyConcurrentHashMap(const MyConcurrentHashMap&) = delete;
+    MyConcurrentHashMap& operator=(const MyConcurrentHashMap&) = delete;
+
+    // 插入或覆盖，返回true表示新插入，false表示覆盖了已有的值
+    bool insert_or_assign(const Key& key, const Value& value) {
+        Shard& shard = shard_for(key);
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        size_t before = shard.map.size();
+        shard.map.insert(key, value);
+        return shard.map.size() != before;
+    }
+
+    // 在分片锁内对找到的值调用fn(value)，避免把内部指针暴露到锁外；返回是否找到
+    template <typename Func>
+    bool find_and_apply(const Key& key, Func fn) {
+        Shard& shard = shard_for(key);
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        Value* val = shard.map.find(key);
+        if (val == nullptr) {
+            return false;
+        }
+        fn(*val);
+        return true;
+    }
+
+    // 删除键，成功返回true
+    bool erase(const Key& key) {
+        Shard& shard = shard_for(key);
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        return shard.map.erase(key);
+    }
+
+    // 原子的读-改-写：在分片锁内调用fn(value, existed)
+    // 键不存在时先插入默认构造的值（existed为false）；fn返回false表示删除该键
+    // 返回值：操作结束后键是否存在
+    template <typename Func>
+    bool compute(const Key& key, Func fn) {
+        Shard& shard = shard_for(key);
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        Value* val = shard.map.find(key);
+        bool existed = val != nullptr;
+        if (!existed) {
+            val = &shard.map[key];
+        }
+        if (!fn(*val, existed)) {
+            shard.map.erase(key);
+            return false;
+        }
+        return true;
+    }
+
+    // 是否包含键
+    bool contains(const Key& key) {
+        return find_and_apply(key, [](Value&) {});
+    }
+
+    // 所有分片元素数量之和（逐个分片加锁读取，并发修改时只是近似快照）
+    size_t size() {
+        size_t total = 0;
+        for (size_t i = 0; i < ShardCount; ++i) {
+            total += shard_size(i);
+        }
+        return total;
+    }
+
+    // 单个分片的元素数量，可用于观察分片是否均衡
+    size_t shard_size(size_t shard_idx) {
+        std::lock_guard<std::mutex> lock(shards_[shard_idx].mutex);
+        return shards_[shard_idx].map.size();
+    }
+
+    static constexpr size_t shard_count() {
+        return ShardCount;
+    }
+
+    // 清空所有分片
+    void clear() {
+        for (size_t i = 0; i < ShardCount; ++i) {
+            std::lock_guard<std::mutex> lock(shards_[i].mutex);
+            shards_[i].map.clear();
+        }
+    }
+};
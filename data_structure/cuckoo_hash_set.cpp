@@ -0,0 +1,377 @@
+// 分桶布谷鸟哈希集合MyCuckooSet（两个哈希函数，每桶4个槽）
+// 每个键只能放在两个候选桶之一：i1 = h & mask，i2 = hash_finalize_mix(h + 种子) & mask。
+// - 查找：最多看两个桶。桶 = 4字节标签 + 4个键，按2的幂对齐（不超过64字节时整个桶落在一条缓存行内），
+//   所以一次查找最多读两条缓存行；标签是哈希的高8位（0表示空槽），标签相等才比较键
+// - 插入：两个候选桶有空槽就直接放；否则随机踢出一个旧键，把它搬到它的另一个候选桶，
+//   最多踢kMaxKicks次；仍放不下时把手里的键放进小暂存区（stash），暂存区满了才扩容（桶数翻倍）
+// - 不设负载上限，直到插入失败才扩容，每桶4槽时实际占用率可达95%左右
+// - 删除：直接清空槽位；若暂存区有键，顺便尝试把它们搬回空出来的桶
+// 与MyUnordered（每个键一个链表节点，默认max_load_factor = 1.0）相比，没有节点指针与逐个分配，
+// 每个键只占约sizeof(T) / 0.95 + 标签字节。
+#include <cstddef> // size_t
+#include <cstdint> // uint8_t、uint64_t
+#include <cstdlib> // aligned_alloc、free
+#include <new> // placement new
+#include <utility> // std::move、std::swap
+#include "../container/std_unordered_set_withoutstl.cpp" // MyHash、MyEqual、hash_finalize_mix
+
+// 不小于n的最小2的幂，最大取64（一条缓存行）
+constexpr size_t cuckoo_bucket_align(size_t n) {
+    size_t a = 1;
+    while (a < n && a < 64) {
+        a <<= 1;
+    }
+    return a;
+}
+
+template <typename T,
+          typename Hash = MyHash<T>,
+          typename KeyEqual = MyEqual<T>>
+class MyCuckooSet {
+public:
+    static constexpr size_t kSlots = 4; // 每桶槽数
+    static constexpr size_t kStashSize = 8; // 暂存区容量
+    static constexpr size_t kMaxKicks = 500; // 单次插入最多踢出次数
+
+    explicit MyCuckooSet(size_t expected = 0) {
+        allocate(bucket_count_for(expected));
+    }
+
+    MyCuckooSet(const MyCuckooSet&) = delete;
+    MyCuckooSet& operator=(const MyCuckooSet&) = delete;
+
+    ~MyCuckooSet() {
+        destroy_all();
+        free(buckets_);
+    }
+
+    // 插入元素（已存在返回false）
+    bool insert(const T& key) {
+        if (contains(key)) {
+            return false;
+        }
+        T tmp(key);
+        add(tmp);
+        return true;
+    }
+
+    bool insert(T&& key) {
+        if (contains(key)) {
+            return false;
+        }
+        add(key);
+        return true;
+    }
+
+    bool contains(const T& key) const {
+        size_t h = hasher_(key);
+        uint8_t t = tag_of(h);
+        size_t i1 = h & mask_;
+        size_t i2 = alt_index(h);
+#if defined(__GNUC__) || defined(__clang__)
+        __builtin_prefetch(&buckets_[i2], 0, 3); // 第二个桶和第一个桶的比较并行取数
+#endif
+        if (find_in_bucket(buckets_[i1], t, key) != kSlots || find_in_bucket(buckets_[i2], t, key) != kSlots) {
+            return true;
+        }
+        return stash_size_ != 0 && find_in_stash(key) != kStashSize;
+    }
+
+    // 与MyUnordered::find同名同义
+    bool find(const T& key) const {
+        return contains(key);
+    }
+
+    // 删除元素（返回是否存在）
+    bool erase(const T& key) {
+        size_t h = hasher_(key);
+        uint8_t t = tag_of(h);
+        size_t candidates[2] = {h & mask_, alt_index(h)};
+        for (size_t b : candidates) {
+            size_t s = find_in_bucket(buckets_[b], t, key);
+            if (s != kSlots) {
+                clear_slot(buckets_[b], s);
+                --size_;
+                refill_from_stash(b);
+                return true;
+            }
+        }
+        size_t s = stash_size_ ? find_in_stash(key) : kStashSize;
+        if (s == kStashSize) {
+            return false;
+        }
+        // 用暂存区最后一个键填补空位
+        T* last = stash_ptr(stash_size_ - 1);
+        if (s != stash_size_ - 1) {
+            *stash_ptr(s) = std::move(*last);
+        }
+        last->~T();
+        --stash_size_;
+        --size_;
+        return true;
+    }
+
+    // 预留至少能放下n个元素的桶（按95%占用率估算）
+    void reserve(size_t n) {
+        size_t need = bucket_count_for(n);
+        if (need > bucket_count_) {
+            rehash(need);
+        }
+    }
+
+    void clear() {
+        destroy_all();
+        size_ = 0;
+    }
+
+    size_t size() const { return size_; }
+    bool empty() const { return size_ == 0; }
+    size_t bucket_count() const { return bucket_count_; }
+    size_t stash_size() const { return stash_size_; }
+
+    // 占用率：元素数 / 槽数
+    float load_factor() const {
+        return static_cast<float>(size_) / (bucket_count_ * kSlots);
+    }
+
+    // 占用的堆内存（桶数组；暂存区在对象内部）
+    size_t memory_bytes() const {
+        return bucket_count_ * sizeof(Bucket);
+    }
+
+    // 遍历所有元素（桶中的和暂存区中的）
+    template <typename Func>
+    void for_each(Func func) const {
+        for (size_t b = 0; b < bucket_count_; ++b) {
+            for (size_t s = 0; s < kSlots; ++s) {
+                if (buckets_[b].tags[s]) {
+                    func(*key_ptr(buckets_[b], s));
+                }
+            }
+        }
+        for (size_t s = 0; s < stash_size_; ++s) {
+            func(*stash_ptr(s));
+        }
+    }
+
+private:
+    struct RawBucket {
+        uint8_t tags[kSlots]; // 0表示空槽
+        alignas(T) unsigned char keys[kSlots * sizeof(T)]; // 键的原始存储，按需placement new
+    };
+    // 桶按2的幂对齐：不超过64字节的桶不会跨缓存行
+    struct alignas(cuckoo_bucket_align(sizeof(RawBucket))) Bucket : RawBucket {};
+
+    static constexpr size_t kMinBuckets = 4;
+    static constexpr size_t kAltSeed = 0x9e3779b97f4a7c15ULL; // 第二个哈希函数的种子
+
+    Bucket* buckets_ = nullptr;
+    size_t bucket_count_ = 0; // 2的幂
+    size_t mask_ = 0;
+    size_t size_ = 0; // 元素总数（含暂存区）
+    size_t stash_size_ = 0;
+    alignas(T) unsigned char stash_[kStashSize * sizeof(T)];
+    uint64_t rng_ = 88172645463325252ULL; // 随机选择被踢出的槽
+    Hash hasher_;
+    KeyEqual key_eq_;
+
+    static uint8_t tag_of(size_t h) {
+        uint8_t t = static_cast<uint8_t>(static_cast<uint64_t>(h) >> 56);
+        return t ? t : 1;
+    }
+
+    size_t alt_index(size_t h) const {
+        return hash_finalize_mix(h + kAltSeed) & mask_;
+    }
+
+    static T* key_ptr(Bucket& b, size_t s) {
+        return reinterpret_cast<T*>(b.keys) + s;
+    }
+
+    static const T* key_ptr(const Bucket& b, size_t s) {
+        return reinterpret_cast<const T*>(b.keys) + s;
+    }
+
+    T* stash_ptr(size_t s) {
+        return reinterpret_cast<T*>(stash_) + s;
+    }
+
+    const T* stash_ptr(size_t s) const {
+        return reinterpret_cast<const T*>(stash_) + s;
+    }
+
+    // 返回槽号，找不到返回kSlots
+    size_t find_in_bucket(const Bucket& b, uint8_t t, const T& key) const {
+        for (size_t s = 0; s < kSlots; ++s) {
+            if (b.tags[s] == t && key_eq_(*key_ptr(b, s), key)) {
+                return s;
+            }
+        }
+        return kSlots;
+    }
+
+    size_t find_in_stash(const T& key) const {
+        for (size_t s = 0; s < stash_size_; ++s) {
+            if (key_eq_(*stash_ptr(s), key)) {
+                return s;
+            }
+        }
+        return kStashSize;
+    }
+
+    // 在桶中找空槽放入键，成功返回true
+    bool put_in_bucket(Bucket& b, uint8_t t, T& key) {
+        for (size_t s = 0; s < kSlots; ++s) {
+            if (b.tags[s] == 0) {
+                new (key_ptr(b, s)) T(std::move(key));
+                b.tags[s] = t;
+                return true;
+            }
+        }
+        return false;
+    }
+
+    void clear_slot(Bucket& b, size_t s) {
+        key_ptr(b, s)->~T();
+        b.tags[s] = 0;
+    }
+
+    uint64_t next_random() {
+        rng_ ^= rng_ << 13;
+        rng_ ^= rng_ >> 7;
+        rng_ ^= rng_ << 17;
+        return rng_;
+    }
+
+    // 把key放进表中（不检查重复，不计数）。踢出kMaxKicks次仍失败时放入暂存区；
+    // 暂存区也满了返回false，此时key持有最后一个被踢出的键，表中其余键不变
+    bool place(T& key) {
+        size_t h = hasher_(key);
+        uint8_t t = tag_of(h);
+        size_t b = h & mask_;
+        if (put_in_bucket(buckets_[b], t, key)) {
+            return true;
+        }
+        b = alt_index(h);
+        if (put_in_bucket(buckets_[b], t, key)) {
+            return true;
+        }
+        // 随机游走：在当前桶里随机换出一个键，再把它放到它的另一个候选桶
+        for (size_t kick = 0; kick < kMaxKicks; ++kick) {
+            size_t s = next_random() % kSlots;
+            std::swap(key, *key_ptr(buckets_[b], s));
+            buckets_[b].tags[s] = t;
+            h = hasher_(key);
+            t = tag_of(h);
+            size_t i1 = h & mask_;
+            b = (b == i1) ? alt_index(h) : i1;
+            if (put_in_bucket(buckets_[b], t, key)) {
+                return true;
+            }
+        }
+        if (stash_size_ < kStashSize) {
+            new (stash_ptr(stash_size_)) T(std::move(key));
+            ++stash_size_;
+            return true;
+        }
+        return false;
+    }
+
+    // 插入一个确定不存在的键，放不下时扩容重试
+    void add(T& key) {
+        while (!place(key)) {
+            rehash(bucket_count_ * 2);
+        }
+        ++size_;
+    }
+
+    // 桶b空出一个槽后，把候选桶是b的暂存键搬回去
+    void refill_from_stash(size_t b) {
+        for (size_t s = 0; s < stash_size_; ++s) {
+            size_t h = hasher_(*stash_ptr(s));
+            if ((h & mask_) != b && alt_index(h) != b) {
+                continue;
+            }
+            T* last = stash_ptr(stash_size_ - 1);
+            put_in_bucket(buckets_[b], tag_of(h), *stash_ptr(s));
+            stash_ptr(s)->~T();
+            if (s != stash_size_ - 1) {
+                new (stash_ptr(s)) T(std::move(*last));
+                last->~T();
+            }
+            --stash_size_;
+            return;
+        }
+    }
+
+    // 按95%占用率估算桶数，向上取2的幂
+    static size_t bucket_count_for(size_t n) {
+        size_t count = kMinBuckets;
+        while (count * kSlots * 19 < n * 20) {
+            count <<= 1;
+        }
+        return count;
+    }
+
+    void allocate(size_t count) {
+        size_t bytes = count * sizeof(Bucket);
+        bytes = (bytes + 63) & ~size_t(63); // aligned_alloc要求大小是对齐的整数倍
+        buckets_ = static_cast<Bucket*>(aligned_alloc(64, bytes));
+        for (size_t b = 0; b < count; ++b) {
+            for (size_t s = 0; s < kSlots; ++s) {
+                buckets_[b].tags[s] = 0;
+            }
+        }
+        bucket_count_ = count;
+        mask_ = count - 1;
+    }
+
+    void destroy_all() {
+        for (size_t b = 0; b < bucket_count_; ++b) {
+            for (size_t s = 0; s < kSlots; ++s) {
+                if (buckets_[b].tags[s]) {
+                    clear_slot(buckets_[b], s);
+                }
+            }
+        }
+        for (size_t s = 0; s < stash_size_; ++s) {
+            stash_ptr(s)->~T();
+        }
+        stash_size_ = 0;
+    }
+
+    // 换成new_count个桶，把所有键（含暂存区）重新放置；新表仍放不下时继续翻倍
+    void rehash(size_t new_count) {
+        Bucket* old = buckets_;
+        size_t old_count = bucket_count_;
+        size_t old_stash = stash_size_;
+        // 暂存区的键先移出，腾空暂存区给新表使用
+        alignas(T) unsigned char saved[kStashSize * sizeof(T)];
+        T* saved_keys = reinterpret_cast<T*>(saved);
+        for (size_t s = 0; s < old_stash; ++s) {
+            new (saved_keys + s) T(std::move(*stash_ptr(s)));
+            stash_ptr(s)->~T();
+        }
+        stash_size_ = 0;
+
+        allocate(new_count);
+        for (size_t b = 0; b < old_count; ++b) {
+            for (size_t s = 0; s < kSlots; ++s) {
+                if (old[b].tags[s]) {
+                    T* p = key_ptr(old[b], s);
+                    while (!place(*p)) {
+                        rehash(bucket_count_ * 2);
+                    }
+                    p->~T();
+                }
+            }
+        }
+        for (size_t s = 0; s < old_stash; ++s) {
+            while (!place(saved_keys[s])) {
+                rehash(bucket_count_ * 2);
+            }
+            saved_keys[s].~T();
+        }
+        free(old);
+    }
+};
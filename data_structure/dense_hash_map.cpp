@@ -0,0 +1,245 @@
+// 按插入顺序连续存放的哈希表MyDenseMap
+// 键值对按插入顺序存在一个MyVector<std::pair<Key, Value>>里，遍历就是顺序扫一段连续内存；
+// 另有一张32位槽位的索引表（开放寻址、线性探测，容量为2的幂）把哈希值映射到键值对的下标。
+// - 查找：在索引表中从hash & mask开始探测，先比较该下标处记录的32位哈希，相等才比较键
+// - 删除：索引表用后移删除（backward shift），不留墓碑；键值对数组把最后一个元素移到空位（swap-with-last），
+//   因此删除后遍历顺序不再严格等于插入顺序（被删位置换成了原来的最后一个元素）
+// - 扩容：只重建索引表，用记录的哈希值重新放置，不调用哈希函数，也不移动键值对
+// 下标用32位存储，元素个数上限约42亿。
+#include <cstddef> // size_t
+#include <cstdint> // uint32_t
+#include <cstdlib> // malloc、free
+#include <cstring> // memset
+#include <tuple> // std::forward_as_tuple
+#include <utility> // std::pair、std::move、std::forward、std::piecewise_construct
+#include "../container/std_vector_withoutstl_completeversion.cpp" // MyVector
+#include "../container/std_unordered_map_withoutstl.cpp" // MyHash、KeyEqual、hash_finalize_mix
+
+template <typename Key,
+          typename Value,
+          typename Hash = MyHash<Key>,
+          typename KeyEqual = KeyEqual<Key>>
+class MyDenseMap {
+public:
+    using value_type = std::pair<Key, Value>; // 键不可修改（修改会破坏索引），这里不用const Key是为了swap-with-last能移动赋值
+    using iterator = value_type*;
+    using const_iterator = const value_type*;
+
+    explicit MyDenseMap(size_t expected = 0) {
+        if (expected) {
+            reserve(expected);
+        }
+    }
+
+    MyDenseMap(const MyDenseMap&) = delete;
+    MyDenseMap& operator=(const MyDenseMap&) = delete;
+
+    ~MyDenseMap() {
+        free(slots_);
+    }
+
+    // 键不存在时用args构造值并插入；返回值的地址和是否新插入
+    template <typename K, typename... Args>
+    std::pair<Value*, bool> try_emplace(K&& key, Args&&... args) {
+        uint32_t h = hash32(key);
+        size_t slot = find_slot(key, h);
+        if (slot != kNotFound) {
+            return {&entries_[slots_[slot]].second, false};
+        }
+        grow_if_needed();
+        uint32_t idx = static_cast<uint32_t>(entries_.size());
+        entries_.emplace_back(std::piecewise_construct, std::forward_as_tuple(std::forward<K>(key)),
+                              std::forward_as_tuple(std::forward<Args>(args)...));
+        hashes_.push_back(h);
+        place(idx, h);
+        return {&entries_[idx].second, true};
+    }
+
+    // 插入或覆盖
+    template <typename K, typename V>
+    std::pair<Value*, bool> insert_or_assign(K&& key, V&& value) {
+        auto result = try_emplace(std::forward<K>(key), std::forward<V>(value));
+        if (!result.second) {
+            *result.first = std::forward<V>(value);
+        }
+        return result;
+    }
+
+    bool insert(const Key& key, const Value& value) {
+        return insert_or_assign(key, value).second;
+    }
+
+    Value& operator[](const Key& key) {
+        return *try_emplace(key).first;
+    }
+
+    Value* find(const Key& key) {
+        size_t slot = find_slot(key, hash32(key));
+        return slot == kNotFound ? nullptr : &entries_[slots_[slot]].second;
+    }
+
+    const Value* find(const Key& key) const {
+        size_t slot = find_slot(key, hash32(key));
+        return slot == kNotFound ? nullptr : &entries_[slots_[slot]].second;
+    }
+
+    bool contains(const Key& key) const {
+        return find_slot(key, hash32(key)) != kNotFound;
+    }
+
+    // 删除键，返回是否存在
+    bool erase(const Key& key) {
+        size_t slot = find_slot(key, hash32(key));
+        if (slot == kNotFound) {
+            return false;
+        }
+        uint32_t idx = slots_[slot];
+        remove_slot(slot);
+
+        // 把最后一个元素移到空出的位置，并把指向它的槽改成新下标
+        uint32_t last = static_cast<uint32_t>(entries_.size() - 1);
+        if (idx != last) {
+            size_t last_slot = slot_of_index(last);
+            slots_[last_slot] = idx;
+            entries_[idx] = std::move(entries_[last]);
+            hashes_[idx] = hashes_[last];
+        }
+        entries_.pop_back();
+        hashes_.pop_back();
+        return true;
+    }
+
+    // 预留n个元素：键值对数组和索引表一次分配到位
+    void reserve(size_t n) {
+        entries_.reserve(n);
+        hashes_.reserve(n);
+        size_t need = slot_capacity_for(n);
+        if (need > capacity_) {
+            rebuild_index(need);
+        }
+    }
+
+    void clear() {
+        entries_.clear();
+        hashes_.clear();
+        if (slots_) {
+            memset(slots_, 0xFF, capacity_ * sizeof(uint32_t));
+        }
+    }
+
+    // 按插入顺序（删除会把最后一个元素换到空位）连续遍历
+    iterator begin() { return entries_.data(); }
+    iterator end() { return entries_.data() + entries_.size(); }
+    const_iterator begin() const { return entries_.data(); }
+    const_iterator end() const { return entries_.data() + entries_.size(); }
+
+    size_t size() const { return entries_.size(); }
+    bool empty() const { return entries_.empty(); }
+    size_t slot_count() const { return capacity_; }
+
+    // 占用的堆内存：键值对数组 + 哈希数组 + 索引表（按容量计）
+    size_t memory_bytes() const {
+        return entries_.capacity() * sizeof(value_type) + hashes_.capacity() * sizeof(uint32_t) +
+               capacity_ * sizeof(uint32_t);
+    }
+
+private:
+    static constexpr uint32_t kEmpty = 0xFFFFFFFFu; // 空槽
+    static constexpr size_t kNotFound = static_cast<size_t>(-1);
+    static constexpr size_t kMinSlots = 16;
+
+    MyVector<value_type> entries_; // 键值对，连续存放
+    MyVector<uint32_t> hashes_; // 与entries_一一对应的32位哈希：探测时先比它，扩容/删除时据此重新定位
+    uint32_t* slots_ = nullptr; // 索引表：键值对下标，kEmpty表示空槽
+    size_t capacity_ = 0; // 索引表槽数（2的幂）
+    Hash hash_func_;
+    KeyEqual key_equal_;
+
+    template <typename K>
+    uint32_t hash32(const K& key) const {
+        size_t h = hash_func_(key);
+        return static_cast<uint32_t>(h ^ (static_cast<uint64_t>(h) >> 32));
+    }
+
+    size_t mask() const {
+        return capacity_ - 1;
+    }
+
+    // 负载不超过3/4
+    static size_t slot_capacity_for(size_t n) {
+        size_t cap = kMinSlots;
+        while (cap * 3 < n * 4) {
+            cap <<= 1;
+        }
+        return cap;
+    }
+
+    template <typename K>
+    size_t find_slot(const K& key, uint32_t h) const {
+        if (capacity_ == 0) {
+            return kNotFound;
+        }
+        for (size_t i = h & mask();; i = (i + 1) & mask()) {
+            uint32_t idx = slots_[i];
+            if (idx == kEmpty) {
+                return kNotFound;
+            }
+            if (hashes_[idx] == h && key_equal_(entries_[idx].first, key)) {
+                return i;
+            }
+        }
+    }
+
+    // 找到存放下标idx的槽（idx一定在表中）
+    size_t slot_of_index(uint32_t idx) const {
+        size_t i = hashes_[idx] & mask();
+        while (slots_[i] != idx) {
+            i = (i + 1) & mask();
+        }
+        return i;
+    }
+
+    // 把下标放进从h & mask开始的第一个空槽
+    void place(uint32_t idx, uint32_t h) {
+        size_t i = h & mask();
+        while (slots_[i] != kEmpty) {
+            i = (i + 1) & mask();
+        }
+        slots_[i] = idx;
+    }
+
+    // 后移删除：把后面探测链上能前移的槽依次前移，保证线性探测不断链
+    void remove_slot(size_t hole) {
+        size_t i = hole;
+        for (;;) {
+            i = (i + 1) & mask();
+            uint32_t idx = slots_[i];
+            if (idx == kEmpty) {
+                break;
+            }
+            size_t home = hashes_[idx] & mask();
+            // home不在(hole, i]之间（环形）时，该槽可以前移到hole
+            if (((i - home) & mask()) >= ((i - hole) & mask())) {
+                slots_[hole] = idx;
+                hole = i;
+            }
+        }
+        slots_[hole] = kEmpty;
+    }
+
+    void grow_if_needed() {
+        if ((entries_.size() + 1) * 4 > capacity_ * 3) {
+            rebuild_index(capacity_ ? capacity_ * 2 : kMinSlots);
+        }
+    }
+
+    void rebuild_index(size_t new_capacity) {
+        free(slots_);
+        capacity_ = new_capacity;
+        slots_ = static_cast<uint32_t*>(malloc(capacity_ * sizeof(uint32_t)));
+        memset(slots_, 0xFF, capacity_ * sizeof(uint32_t));
+        for (size_t idx = 0; idx < entries_.size(); ++idx) {
+            place(static_cast<uint32_t>(idx), hashes_[idx]);
+        }
+    }
+};
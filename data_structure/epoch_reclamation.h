@@ -0,0 +1,244 @@
+#ifndef EPOCH_RECLAMATION_H
+#define EPOCH_RECLAMATION_H
+
+#include <atomic> // std::atomic、std::atomic_thread_fence
+#include <cstddef> // size_t
+#include <cstdlib> // malloc、free
+#include <mutex> // std::mutex（仅用于线程退出时移交未回收节点）
+
+// 独占记录槽的个数，可在包含本头文件前定义覆盖（每个槽位约一条缓存行）
+#ifndef EPOCH_RECLAMATION_MAX_THREADS
+#define EPOCH_RECLAMATION_MAX_THREADS 256
+#endif
+
+// ------- 基于纪元的内存回收（Epoch-Based Reclamation） ------- //
+// 无锁结构中，被摘除的节点可能仍被其他线程的读者持有，不能立即delete。
+// 做法：全局纪元global_epoch_单调递增，读者进入临界区时记录当前纪元；
+// 节点摘除后调用retire()，标记为"在纪元e退休"；当全局纪元推进到e+2时，
+// 所有可能看到该节点的读者都已离开临界区，可以安全释放。
+// 只有当所有活跃线程都已观察到当前纪元时，全局纪元才能推进一步。
+//
+// 用法：
+//   { EpochGuard guard; ... 读取共享节点 ... }   // 读写者都要在guard作用域内访问节点
+//   EpochReclaimer::instance().retire(node);    // 摘除节点后退休，稍后自动释放
+// 每个线程第一次使用时占用一个记录槽，线程退出时归还。槽位全被占用时不等待：这个线程改用共享的溢出计数器
+// （按纪元对3取模的三个计数，进入/离开临界区各一次原子加减），语义不变，只是多个溢出线程争用同一条缓存行；
+// 之后每kClaimRetryInterval次在临界区外调用时再试着占一个空出来的槽位。
+class EpochReclaimer {
+public:
+    static constexpr size_t kMaxThreads = EPOCH_RECLAMATION_MAX_THREADS; // 独占记录槽的个数
+    static constexpr size_t kCollectInterval = 64; // 每退休这么多个节点尝试一次回收
+    static constexpr unsigned kClaimRetryInterval = 1024; // 溢出线程每这么多次调用重试一次占槽
+
+    static EpochReclaimer& instance() {
+        static EpochReclaimer reclaimer;
+        return reclaimer;
+    }
+
+    // 进入临界区（可嵌套）
+    void enter() {
+        ThreadState& st = thread_state();
+        if (st.nesting++ == 0) {
+            if (st.record) {
+                st.record->epoch.store(global_epoch_.load(std::memory_order_relaxed), std::memory_order_relaxed);
+                st.record->active.store(true, std::memory_order_relaxed);
+            } else {
+                st.overflow_epoch = enter_overflow();
+            }
+            // 必须保证"我处于活跃状态"先于之后对共享节点的读取被其他线程看到
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+        }
+    }
+
+    // 离开临界区
+    void leave() {
+        ThreadState& st = thread_state();
+        if (--st.nesting == 0) {
+            if (st.record) {
+                st.record->active.store(false, std::memory_order_release);
+            } else {
+                overflow_active_[st.overflow_epoch % 3].fetch_sub(1, std::memory_order_release);
+            }
+        }
+    }
+
+    // 退休一个已从共享结构中摘除的对象，由deleter在安全时释放
+    void retire(void* ptr, void (*deleter)(void*)) {
+        ThreadState& st = thread_state();
+        Retired* r = static_cast<Retired*>(malloc(sizeof(Retired)));
+        r->ptr = ptr;
+        r->deleter = deleter;
+        r->epoch = global_epoch_.load(std::memory_order_acquire);
+        r->next = st.retired;
+        st.retired = r;
+        if (++st.retired_count % kCollectInterval == 0) {
+            collect();
+        }
+    }
+
+    template <typename T>
+    void retire(T* ptr) {
+        retire(ptr, [](void* p) { delete static_cast<T*>(p); });
+    }
+
+    // 尝试推进全局纪元，并释放本线程（以及已退出线程遗留的）足够旧的退休对象
+    void collect() {
+        try_advance();
+        unsigned long long safe = global_epoch_.load(std::memory_order_acquire);
+        ThreadState& st = thread_state();
+        st.retired = free_expired(st.retired, safe);
+
+        std::lock_guard<std::mutex> lock(orphan_mutex_);
+        orphans_ = free_expired(orphans_, safe);
+    }
+
+    unsigned long long epoch() const {
+        return global_epoch_.load(std::memory_order_acquire);
+    }
+
+private:
+    // 每个线程一条记录，独占缓存行
+    struct alignas(64) ThreadRecord {
+        std::atomic<unsigned long long> epoch{0}; // 进入临界区时观察到的纪元
+        std::atomic<bool> active{false}; // 是否处于临界区
+        std::atomic<bool> claimed{false}; // 记录槽是否被某个线程占用
+    };
+
+    // 退休链表节点
+    struct Retired {
+        void* ptr;
+        void (*deleter)(void*);
+        unsigned long long epoch;
+        Retired* next;
+    };
+
+    // 线程私有状态：线程退出时归还记录槽，并把尚未释放的对象移交到全局孤儿链表
+    struct ThreadState {
+        ThreadRecord* record = nullptr; // nullptr表示没有占到槽，使用溢出计数器
+        unsigned nesting = 0;
+        unsigned claim_backoff = 0; // 溢出线程距下次重试占槽还剩几次调用
+        unsigned long long overflow_epoch = 0; // 溢出线程进入临界区时登记的纪元
+        Retired* retired = nullptr;
+        size_t retired_count = 0;
+
+        ~ThreadState() {
+            EpochReclaimer& self = EpochReclaimer::instance();
+            if (retired) {
+                Retired* tail = retired;
+                while (tail->next) {
+                    tail = tail->next;
+                }
+                std::lock_guard<std::mutex> lock(self.orphan_mutex_);
+                tail->next = self.orphans_;
+                self.orphans_ = retired;
+            }
+            if (record) {
+                record->active.store(false, std::memory_order_release);
+                record->claimed.store(false, std::memory_order_release);
+            }
+        }
+    };
+
+    std::atomic<unsigned long long> global_epoch_{2};
+    ThreadRecord records_[kMaxThreads];
+    // 溢出线程的计数：overflow_active_[e % 3]是在纪元e进入、尚未离开的溢出线程数。
+    // 纪元为g时仍在临界区的线程只可能在g-2、g-1、g进入（否则g推进不过来），对3取模互不重叠
+    alignas(64) std::atomic<size_t> overflow_active_[3] = {};
+    std::mutex orphan_mutex_;
+    Retired* orphans_ = nullptr;
+
+    EpochReclaimer() = default;
+
+    // 进程退出时释放所有剩余对象（此时不再有读者）
+    ~EpochReclaimer() {
+        orphans_ = free_expired(orphans_, ~0ULL);
+    }
+
+    // 没有槽的线程只在临界区外（nesting为0）换成独占槽，保证进入和离开走同一条路径
+    ThreadState& thread_state() {
+        static thread_local ThreadState st;
+        if (st.record == nullptr && st.nesting == 0 && st.claim_backoff-- == 0) {
+            st.record = claim_record();
+            st.claim_backoff = st.record ? 0 : kClaimRetryInterval;
+        }
+        return st;
+    }
+
+    // 扫描一遍记录槽，全部被占用时返回nullptr（调用方改用溢出计数器，不等待）
+    ThreadRecord* claim_record() {
+        for (size_t i = 0; i < kMaxThreads; ++i) {
+            bool expected = false;
+            if (!records_[i].claimed.load(std::memory_order_relaxed) &&
+                records_[i].claimed.compare_exchange_strong(expected, true, std::memory_order_acq_rel)) {
+                return &records_[i];
+            }
+        }
+        return nullptr;
+    }
+
+    // 溢出线程进入临界区：在当前纪元的计数上加一，再确认纪元没有变。
+    // 加一之前纪元若已推进了三次，e % 3会被当成“当前纪元”而不阻止推进，所以变了就撤销重来；
+    // 都用seq_cst：确认时读到e，说明加一排在把纪元推进出e之前，之后检查该计数的try_advance一定能看到它
+    unsigned long long enter_overflow() {
+        for (;;) {
+            unsigned long long e = global_epoch_.load(std::memory_order_seq_cst);
+            overflow_active_[e % 3].fetch_add(1, std::memory_order_seq_cst);
+            if (global_epoch_.load(std::memory_order_seq_cst) == e) {
+                return e;
+            }
+            overflow_active_[e % 3].fetch_sub(1, std::memory_order_seq_cst);
+        }
+    }
+
+    // 所有活跃线程都已观察到当前纪元时，把全局纪元加一
+    void try_advance() {
+        unsigned long long curr = global_epoch_.load(std::memory_order_seq_cst);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        for (size_t i = 0; i < kMaxThreads; ++i) {
+            const ThreadRecord& r = records_[i];
+            if (r.claimed.load(std::memory_order_acquire) &&
+                r.active.load(std::memory_order_acquire) &&
+                r.epoch.load(std::memory_order_acquire) != curr) {
+                return;
+            }
+        }
+        // 溢出线程：在curr - 1或curr - 2（即curr + 2、curr + 1对3取模）进入、仍未离开的都会阻止推进
+        if (overflow_active_[(curr + 1) % 3].load(std::memory_order_seq_cst) != 0 ||
+            overflow_active_[(curr + 2) % 3].load(std::memory_order_seq_cst) != 0) {
+            return;
+        }
+        global_epoch_.compare_exchange_strong(curr, curr + 1, std::memory_order_seq_cst);
+    }
+
+    // 释放链表中 epoch + 2 <= safe 的对象，返回剩余链表
+    static Retired* free_expired(Retired* list, unsigned long long safe) {
+        Retired* keep = nullptr;
+        while (list) {
+            Retired* next = list->next;
+            if (list->epoch + 2 <= safe) {
+                list->deleter(list->ptr);
+                free(list);
+            } else {
+                list->next = keep;
+                keep = list;
+            }
+            list = next;
+        }
+        return keep;
+    }
+};
+
+// RAII临界区守卫
+class EpochGuard {
+public:
+    EpochGuard() {
+        EpochReclaimer::instance().enter();
+    }
+    ~EpochGuard() {
+        EpochReclaimer::instance().leave();
+    }
+    EpochGuard(const EpochGuard&) = delete;
+    EpochGuard& operator=(const EpochGuard&) = delete;
+};
+
+#endif // EPOCH_RECLAMATION_H
@@ -1,60 +1,184 @@
 ﻿// 哈希表的完整实现
 #include <iostream>
 #include <algorithm>
+#include <cstddef> // size_t
+#include <cstdint> // uint32_t
+#include "hashmap_key_traits.h" // 默认哈希（按键类型特征选择，与MyHashMap相同）
+#include <new> // placement new、::operator new
+#include <utility> // std::move、std::forward
 #include <vector>
 
-template<typename T, typename V>
+// ------- 桶：带内联存储的小向量 ------- //
+// 负载因子0.75时绝大多数桶只有0~2个元素：前N个元素直接放在桶对象里，超出时整体搬到堆上按2倍扩容。
+// 与每个元素一个std::list节点相比，插入不再逐个分配节点，同一个桶的元素在内存中相邻，查找只扫连续的数组。
+// 桶内顺序没有意义，删除时用最后一个元素填补空位。
+template <typename Entry, size_t N>
+class InlineBucket {
+public:
+    InlineBucket() : data_(inline_data()), size_(0), capacity_(N) {}
+
+    // 移动：堆上的数组直接接管；内联的元素逐个移动过来
+    InlineBucket(InlineBucket&& other) noexcept : data_(inline_data()), size_(0), capacity_(N) {
+        if (other.is_inline()) {
+            for (uint32_t i = 0; i < other.size_; ++i) {
+                new (data_ + i) Entry(std::move(other.data_[i]));
+                other.data_[i].~Entry();
+            }
+            size_ = other.size_;
+        } else {
+            data_ = other.data_;
+            size_ = other.size_;
+            capacity_ = other.capacity_;
+            other.data_ = other.inline_data();
+            other.capacity_ = N;
+        }
+        other.size_ = 0;
+    }
+
+    InlineBucket(const InlineBucket&) = delete;
+    InlineBucket& operator=(const InlineBucket&) = delete;
+    InlineBucket& operator=(InlineBucket&&) = delete;
+
+    ~InlineBucket() {
+        for (uint32_t i = 0; i < size_; ++i) {
+            data_[i].~Entry();
+        }
+        if (!is_inline()) {
+            ::operator delete(data_);
+        }
+    }
+
+    Entry* begin() { return data_; }
+    Entry* end() { return data_ + size_; }
+    const Entry* begin() const { return data_; }
+    const Entry* end() const { return data_ + size_; }
+    size_t size() const { return size_; }
+
+    template <typename... Args>
+    Entry& emplace_back(Args&&... args) {
+        if (size_ == capacity_) {
+            grow();
+        }
+        Entry* entry = new (data_ + size_) Entry(std::forward<Args>(args)...);
+        ++size_;
+        return *entry;
+    }
+
+    // 用最后一个元素覆盖pos，再析构最后一个
+    void erase(Entry* pos) {
+        Entry* last = data_ + size_ - 1;
+        if (pos != last) {
+            *pos = std::move(*last);
+        }
+        last->~Entry();
+        --size_;
+    }
+
+private:
+    alignas(Entry) unsigned char storage_[N * sizeof(Entry)]; // 内联存储
+    Entry* data_; // 指向storage_或堆上的数组
+    uint32_t size_;
+    uint32_t capacity_;
+
+    Entry* inline_data() {
+        return reinterpret_cast<Entry*>(storage_);
+    }
+
+    bool is_inline() const {
+        return data_ == reinterpret_cast<const Entry*>(storage_);
+    }
+
+    void grow() {
+        uint32_t new_cap = capacity_ * 2;
+        Entry* heap = static_cast<Entry*>(::operator new(new_cap * sizeof(Entry)));
+        for (uint32_t i = 0; i < size_; ++i) {
+            new (heap + i) Entry(std::move(data_[i]));
+            data_[i].~Entry();
+        }
+        if (!is_inline()) {
+            ::operator delete(data_);
+        }
+        data_ = heap;
+        capacity_ = new_cap;
+    }
+};
+
+// Hash默认按键类型选择（整数先混合）：桶数按2倍增长、用%取桶，std::hash对整数是恒等映射，
+// 等步长的键（如都是1024的倍数）会全部落进少数几个桶；需要std::hash或自定义哈希时显式传入
+template<typename K, typename V, typename Hash = MyHashMapHash<K>>
 class MyChainingHashMap {
     struct KVNode {
         K key;
         V value;
-        KVNode(K key, V value) : key(key), value(value) {}
+
+        template <typename KK, typename VV>
+        KVNode(KK&& key, VV&& value) : key(std::forward<KK>(key)), value(std::forward<VV>(value)) {}
     };
 
+    // 元素不超过16字节时每个桶内联2个，否则内联1个（更大的元素放两份会让空桶也很占内存）
+    static constexpr size_t INLINE_ENTRIES = sizeof(KVNode) <= 16 ? 2 : 1;
+    using Bucket = InlineBucket<KVNode, INLINE_ENTRIES>;
+
 private:
-    // 哈希表底层数组
-    std::vector<std::list<KVNode>> table;
+    // 哈希表底层数组：每个桶是一段连续存放的键值对
+    std::vector<Bucket> table;
     int size_;
+    Hash hasher_;
     static constexpr int INIT_CAP = 4;
     static constexpr double LOAD_FACTOR = 0.75;
 
 private:
-    int hash(K key) const {
-        return (std::hash<K>{}(key) & 0x7fffffff) % table.size();
+    size_t hash(const K& key, size_t cap) const {
+        return hasher_(key) % cap;
+    }
+
+    size_t hash(const K& key) const {
+        return hash(key, table.size());
+    }
+
+    KVNode* find_node(const K& key) const {
+        const Bucket& bucket = table[hash(key)];
+        for (const KVNode& node : bucket) {
+            if (node.key == key) {
+                return const_cast<KVNode*>(&node);
+            }
+        }
+        return nullptr;
     }
 
+    // 扩容/缩容：新建桶数组，把每个键值对移动（而不是复制）到新桶，不再比较键；旧桶随旧数组一起释放
     void resize(int new_cap) {
-        newCap = std::max(new_cap, 1);
-        MyChainingHashMap<K, V> newMap(newCap);
-        for (auto& list : table) {
-            for (auto& node : list) {
-                newMap.put(node.key, node.value);
+        new_cap = std::max(new_cap, 1);
+        std::vector<Bucket> new_table(new_cap);
+        for (Bucket& bucket : table) {
+            for (KVNode& node : bucket) {
+                new_table[hash(node.key, new_cap)].emplace_back(std::move(node));
             }
         }
-        this->table = newMap.table;
-        this->size_ = newMap.size_;
+        table.swap(new_table);
     }
 
 public:
     MyChainingHashMap() : MyChainingHashMap(INIT_CAP) {}
 
     explicit MyChainingHashMap(int initCapacity) {
-        size_t = 0;
+        size_ = 0;
         initCapacity = std::max(initCapacity, 1);
-        table.resize(initCapacity);
+        table = std::vector<Bucket>(initCapacity);
     }
 
     // 增和改
-    void put(K key, V val) {
-        auto& list = table[hash(key)];
-        for (auto& node : list) {
+    template <typename KK, typename VV>
+    void put(KK&& key, VV&& val) {
+        Bucket& bucket = table[hash(key)];
+        for (KVNode& node : bucket) {
             if (node.key == key) {
-                node.value = val;
+                node.value = std::forward<VV>(val);
                 return;
             }
         }
         // key 不存在
-        list.emplace_back(key, val);
+        bucket.emplace_back(std::forward<KK>(key), std::forward<VV>(val));
         size_++;
         if (size_ >= LOAD_FACTOR * table.size()) {
             resize(2 * table.size());
@@ -62,13 +186,13 @@ public:
     }
 
     // 删除
-    void remove(K key) {
-        auto& list = table[hash(key)];
-        for (auto it = list.begin(); it != list.end(); ++it) {
-            if (it->key == key) {
-                list.erase(it);
+    void remove(const K& key) {
+        Bucket& bucket = table[hash(key)];
+        for (KVNode& node : bucket) {
+            if (node.key == key) {
+                bucket.erase(&node);
                 size_--;
-                
+
                 // 缩容
                 if (size_ <= LOAD_FACTOR * table.size() / 4 && table.size() / 2 >= INIT_CAP) {
                     resize(table.size() / 2);
@@ -78,33 +202,38 @@ public:
         }
     }
 
-    // 查
-    V get(K key) const {
-        const auto& list = table[hash(key)];
-        for (const auto& node : list) {
-            if (node.key == key) {
-                return node.value;
-            }
-        }
-        // key 不存在
-        return nullptr;
+    // 查：返回值的指针，key 不存在时返回nullptr
+    V* get(const K& key) {
+        KVNode* node = find_node(key);
+        return node ? &node->value : nullptr;
+    }
+
+    const V* get(const K& key) const {
+        KVNode* node = find_node(key);
+        return node ? &node->value : nullptr;
     }
 
     int size() const {
         return size_;
     }
 
+    size_t bucket_count() const {
+        return table.size();
+    }
+
     // 返回所有key
-    std::list<K> keys() const {
-        std::list<K> res;
-        for (const auto& list : table) {
-            for (const auto& node : list) {
+    std::vector<K> keys() const {
+        std::vector<K> res;
+        res.reserve(size_);
+        for (const Bucket& bucket : table) {
+            for (const KVNode& node : bucket) {
                 res.push_back(node.key);
             }
         }
+        return res;
     }
 
-    bool contains(K key) const {
+    bool contains(const K& key) const {
         return get(key) != nullptr;
     }
-};
\ No newline at end of file
+};
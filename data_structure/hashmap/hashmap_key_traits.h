@@ -0,0 +1,118 @@
+#ifndef HASHMAP_KEY_TRAITS_H
+#define HASHMAP_KEY_TRAITS_H
+
+#include <cstddef> // size_t
+#include <cstring> // strcmp、memcmp
+#include <string> // std::string（按内容哈希/比较）
+#include <string_view> // std::string_view
+#include <type_traits> // 按键类型特征选择默认哈希/相等比较
+#include "../../container/hash_function.h" // hash_finalize_mix、hash_bytes、hash_cstring、hash_double
+
+// ------- 默认哈希/相等比较：按键类型的特征选择特化 ------- //
+// MyHashMap与MyChainingHashMap共用；std::hash对整数是恒等映射，桶数是2的幂时等步长的键会挤进少数几个桶，这里都先混合
+// - 整数、枚举、指针（不超过一个字）：fmix64混合一次
+// - 浮点：按位模式混合，+0.0与-0.0相等、哈希也相同
+// - std::string、std::string_view、char*、const char*：按内容哈希和比较，而不是按对象字节或指针值
+// - 其余可平凡复制且没有填充字节（std::has_unique_object_representations）的类型：
+//   对象字节交给hash_bytes，每步读8字节；长度是编译期常量，编译器可以把分支和循环全部展开
+// - 带填充字节的结构体：填充字节的值不确定，按字节哈希会让相等的键落进不同的桶，不提供默认哈希，
+//   需要作为Hash模板参数传入；相等比较默认用operator==，没有operator==时按字节比较（同样要求没有填充）
+namespace hashmap_detail {
+
+template <typename K>
+struct DependentFalse : std::false_type {};
+
+template <typename K>
+struct IsCString
+    : std::integral_constant<bool, std::is_same<K, char*>::value || std::is_same<K, const char*>::value> {};
+
+template <typename K>
+struct IsStringKey
+    : std::integral_constant<bool, IsCString<K>::value || std::is_same<K, std::string>::value ||
+                                       std::is_same<K, std::string_view>::value> {};
+
+template <typename K>
+struct IsWordKey
+    : std::integral_constant<bool, (std::is_integral<K>::value || std::is_enum<K>::value ||
+                                    (std::is_pointer<K>::value && !IsCString<K>::value)) &&
+                                       sizeof(K) <= sizeof(size_t)> {};
+
+template <typename K>
+struct IsByteKey
+    : std::integral_constant<bool, std::is_trivially_copyable<K>::value &&
+                                       std::has_unique_object_representations<K>::value &&
+                                       !IsWordKey<K>::value && !IsStringKey<K>::value> {};
+
+template <typename K, typename = void>
+struct HasEqualOperator : std::false_type {};
+
+template <typename K>
+struct HasEqualOperator<K, std::void_t<decltype(std::declval<const K&>() == std::declval<const K&>())>>
+    : std::true_type {};
+
+} // namespace hashmap_detail
+
+// 没有匹配的特化：提示调用方自己提供哈希函数
+template <typename K, typename Enable = void>
+struct MyHashMapHash {
+    static_assert(hashmap_detail::DependentFalse<K>::value,
+                  "键类型带填充字节或不可平凡复制，没有默认哈希，请把哈希函数作为容器的Hash模板参数传入");
+};
+
+// 整数、枚举、指针：整个键就是一个字
+template <typename K>
+struct MyHashMapHash<K, typename std::enable_if<hashmap_detail::IsWordKey<K>::value>::type> {
+    size_t operator()(const K& key) const {
+        if constexpr (std::is_pointer<K>::value) {
+            return hash_finalize_mix(reinterpret_cast<size_t>(key));
+        } else {
+            return hash_finalize_mix(static_cast<size_t>(key));
+        }
+    }
+};
+
+// 浮点
+template <typename K>
+struct MyHashMapHash<K, typename std::enable_if<std::is_floating_point<K>::value>::type> {
+    size_t operator()(const K& key) const {
+        return hash_double(static_cast<double>(key));
+    }
+};
+
+// 字符串：按内容
+template <typename K>
+struct MyHashMapHash<K, typename std::enable_if<hashmap_detail::IsStringKey<K>::value>::type> {
+    size_t operator()(const K& key) const {
+        if constexpr (hashmap_detail::IsCString<K>::value) {
+            return hash_cstring(key);
+        } else {
+            return hash_bytes(key.data(), key.size());
+        }
+    }
+};
+
+// 没有填充字节的POD：对象表示与值一一对应，直接哈希对象字节
+template <typename K>
+struct MyHashMapHash<K, typename std::enable_if<hashmap_detail::IsByteKey<K>::value>::type> {
+    size_t operator()(const K& key) const {
+        return hash_bytes(&key, sizeof(K));
+    }
+};
+
+// 相等比较：C字符串比较内容；有operator==的类型用它；否则对没有填充字节的类型按字节比较
+template <typename K>
+struct MyHashMapEqual {
+    bool operator()(const K& a, const K& b) const {
+        if constexpr (hashmap_detail::IsCString<K>::value) {
+            return strcmp(a, b) == 0;
+        } else if constexpr (hashmap_detail::HasEqualOperator<K>::value) {
+            return a == b;
+        } else {
+            static_assert(std::is_trivially_copyable<K>::value && std::has_unique_object_representations<K>::value,
+                          "键类型没有operator==且带填充字节，请把相等比较作为容器的KeyEqual模板参数传入");
+            return memcmp(&a, &b, sizeof(K)) == 0;
+        }
+    }
+};
+
+#endif // HASHMAP_KEY_TRAITS_H
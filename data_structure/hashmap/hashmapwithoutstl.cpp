@@ -6,6 +6,8 @@
 #include <iostream>
 #include <cstring>
 #include <cstdlib>
+#include "hashmap_key_traits.h" // 默认哈希/相等比较（按键类型特征选择）
+#include "../../container/hash_table_stats.h" // 健康度统计（链长分布、采样探测长度、rehash时间线）
 
 template<typename K, typename V>
 struct HashNode {
@@ -13,11 +15,11 @@ struct HashNode {
     V value;
     HashNode* next;
 
-    HashNode(const K& k, cosnt V& v) : key(k), value(v), next(nullptr) {}
+    HashNode(const K& k, const V& v) : key(k), value(v), next(nullptr) {}
 
 };
 
-template<typename K, typename V>
+template<typename K, typename V, typename Hash = MyHashMapHash<K>, typename KeyEqual = MyHashMapEqual<K>>
 class MyHashMap {
 private:
     HashNode<K, V>** table; // 哈希表底层数组，存储链表头节点指针
@@ -25,15 +27,28 @@ private:
     int size; // 哈希表元素数量
     const float loadFactor; // 负载因子阈值
     const int initCapacity; // 初始容量
+    Hash hasher; // 哈希函数对象
+    KeyEqual keyEqual; // 键比较函数对象
+    mutable HashTableMonitor monitor; // 健康度统计
+
+    // 哈希函数：返回完整哈希值，由indexFor映射到桶下标
+    size_t hashCode(const K& key) const {
+        return hasher(key);
+    }
+
+    static int indexFor(size_t hashValue, int cap) {
+        return static_cast<int>(hashValue % static_cast<size_t>(cap));
+    }
 
-    // 哈希函数
     int hash(const K& key) const {
-        size_t hashValue = 0;
-        const char* data = reinterpret_cast<const char*>(&key);
-        for (size_t i = 0; i < sizeof(K); ++i) {
-            hashValue = hashValue * 31 + data[i];
+        return indexFor(hashCode(key), capacity);
+    }
+
+    // 采样的查找在命中或走完链后记录比较过的节点数
+    void recordProbe(bool sampled, size_t probes) const {
+        if (sampled) {
+            monitor.record_probe(probes);
         }
-        return static_cast<int>(hashValue % capacity);
     }
 
     // 扩容/缩容
@@ -41,6 +56,7 @@ private:
         if (newCapacity < initCapacity) {
             return;
         }
+        uint64_t startNs = HashTableMonitor::now_ns();
         // 创建新的哈希表
         HashNode<K, V>** newTable = new HashNode<K, V>*[newCapacity]();
         int oldCapacity = capacity;
@@ -52,8 +68,8 @@ private:
                 // 先把下一个节点保存起来
                 HashNode<K, V>* next = node->next;
                 
-                // 计算在新表中的位置
-                int newIndex = hash(node->key) % newCapacity;
+                // 计算在新表中的位置（必须按新容量取模，hash()用的是旧容量）
+                int newIndex = indexFor(hashCode(node->key), newCapacity);
                 // 插入到新表的对应位置
                 node->next = newTable[newIndex];
                 newTable[newIndex] = node;
@@ -67,13 +83,25 @@ private:
         delete[] table;
         table = newTable;
         capacity = newCapacity;
+        monitor.record_rehash(size, oldCapacity, newCapacity, HashTableMonitor::now_ns() - startNs);
     }
 
     // 比较两个键是否相等
     bool equals(const K& a, const K& b) const {
-        return memcmp(&a, &b, sizeof(K)) == 0;
+        return keyEqual(a, b);
     }
 
+public:
+    explicit MyHashMap(int initialCapacity = 16, float maxLoadFactor = 0.75f, const Hash& hash = Hash(),
+                       const KeyEqual& equal = KeyEqual())
+        : capacity(initialCapacity > 0 ? initialCapacity : 16), size(0), loadFactor(maxLoadFactor),
+          initCapacity(initialCapacity > 0 ? initialCapacity : 16), hasher(hash), keyEqual(equal) {
+        table = new HashNode<K, V>*[capacity]();
+    }
+
+    MyHashMap(const MyHashMap&) = delete;
+    MyHashMap& operator=(const MyHashMap&) = delete;
+
     ~MyHashMap() {
         clear();
         delete[] table;
@@ -112,12 +140,17 @@ private:
     bool containsKey(const K& key) const {
         int index = hash(key);
         HashNode<K, V>* node = table[index];
+        bool sampled = monitor.sample_find();
+        size_t probes = 0;
         while (node) {
+            ++probes;
             if (equals(node->key, key)) {
+                recordProbe(sampled, probes);
                 return true;
             }
             node = node->next;
         }
+        recordProbe(sampled, probes);
         return false;
     }
 
@@ -150,16 +183,39 @@ private:
     bool get(const K& key, V& value) const {
         int index = hash(key);
         HashNode<K, V>* node = table[index];
+        bool sampled = monitor.sample_find();
+        size_t probes = 0;
         while (node) {
+            ++probes;
             if (equals(node->key, key)) {
+                recordProbe(sampled, probes);
                 value = node->value;
                 return true;
             }
             node = node->next;
         }
+        recordProbe(sampled, probes);
         return false;
     }
 
+    // 健康度快照：桶分布现场统计（O(容量)），探测长度与扩缩容记录来自运行期采样
+    HashTableStats stats() const {
+        HashTableStats out;
+        monitor.fill(out, size, capacity, [this](size_t i) {
+            size_t len = 0;
+            for (const HashNode<K, V>* node = table[i]; node; node = node->next) {
+                ++len;
+            }
+            return len;
+        });
+        return out;
+    }
+
+    // 清零探测长度统计，开始新的观察窗口
+    void resetProbeStats() {
+        monitor.reset_probes();
+    }
+
     // 删除键值对
     bool remove(const K& key) {
         int index = hash(key);
@@ -2,9 +2,13 @@
 #include <type_traits> // 用于类型特性检测
 #include <cmath> // 用于abs函数
 #include <cstring> // 字符串处理（不属于STL容器）
+#include "../container/hash_function.h" // hash_finalize_mix、hash_bytes
 
 using namespace std;
 
+// 依赖模板参数的false，static_assert只在实例化到不支持的键类型时才触发
+template <class> struct always_false : std::false_type {};
+
 template <typename K, typename V>
 class HashTable {
 private:
@@ -25,13 +29,11 @@ private:
 private:
     int hashFunc(const K& key) const {
         if constexpr (is_integral<K>::value) {
-            return abs(static_cast<long long>(key)) % capacity; // 避免溢出
+            // 先混合再取模：直接取模时等步长的键（如都是capacity的倍数）会落进同一个桶
+            return static_cast<int>(hash_finalize_mix(static_cast<size_t>(key)) % capacity);
         } else if constexpr (is_same<K, string>::value) {
-            int hash = 0;
-            for (size_t i = 0; i < key.size(); ++i) {
-                hash = (hash * 31 + key[i]) % capacity; // 简单的字符串哈希函数,31是常用的质数,可以减少冲突
-            }
-            return hash;
+            // wyhash每步处理8字节，比逐字节hash * 31 + c且每步取模快得多，分布也更均匀
+            return static_cast<int>(hash_bytes(key.data(), key.size()) % capacity);
         } else {
             static_assert(always_false<K>::value, "Unsupported key type, only integral and string are supported.");
             // 不需要返回值，因为static_assert会在编译时触发
@@ -73,7 +75,7 @@ private:
 
 public:
     HashTable(int initialCapacity = 10, double threshold = 0.7)
-        : capacity(initialCapacity), loadFactoryThreshold(threshold), size(0) {
+        : size(0), capacity(initialCapacity), loadFactorThreshold(threshold) {
         if (capacity <= 0) {
             capacity = 10;
         }
@@ -137,6 +139,7 @@ public:
                 value = current->value; // 找到键，返回对应值
                 return true;
             }
+            current = current->next;
         }
         return false; // 未找到键
     }
@@ -0,0 +1,242 @@
+// 读多写少的无锁哈希表：find完全无锁（仅acquire读取），写者用CAS修改链表，摘除的节点交给纪元回收
+#include <atomic> // std::atomic
+#include <cstddef> // size_t
+#include <cstdint> // uintptr_t
+#include "../container/std_unordered_map_withoutstl.cpp" // MyHash、KeyEqual、桶索引策略
+#include "epoch_reclamation.h"
+
+// ------- 无锁哈希表节点 ------- //
+// 与MyUnorderedMap的HashNode布局相同（键、值、next），区别在于：
+// 1. next是原子的，最低位用作"逻辑删除"标记（Harris-Michael链表）
+// 2. 值通过原子指针读取，更新时整体替换并退休旧值，读者永远不会读到写了一半的值；
+//    初始值就地存放在节点内（与键同一缓存行），只有被覆盖过的值才单独分配
+template <typename Key, typename Value>
+struct LockFreeHashNode {
+    size_t hash; // 完整哈希值，桶内链表按它升序排列
+    Key key;
+    std::atomic<Value*> value; // 指向inline_value或覆盖后单独分配的值
+    std::atomic<uintptr_t> next; // 后继指针 | 删除标记位
+    Value inline_value;
+
+    LockFreeHashNode(size_t h, const Key& k, const Value& v)
+        : hash(h), key(k), value(&inline_value), next(0), inline_value(v) {}
+
+    ~LockFreeHashNode() {
+        release_value(value.load(std::memory_order_relaxed));
+    }
+
+    // 释放被替换下来的值（就地存放的初始值随节点一起释放）
+    void release_value(Value* v) {
+        if (v != &inline_value) {
+            delete v;
+        }
+    }
+};
+
+// ------- 读多写少的无锁哈希表 ------- //
+// 桶数量在构造时确定（路由表这类场景规模基本已知），之后不再扩容，避免扩容打断无锁读者。
+// 每个桶是按(hash)升序的Harris-Michael无锁链表：
+//   - find：沿链表acquire读取，跳过已标记删除的节点，不写任何共享内存
+//   - insert_or_assign：找到插入位置后CAS前驱的next；键已存在时原子替换值指针
+//   - erase：先CAS给节点的next打删除标记（逻辑删除），再CAS前驱摘除（物理删除）
+// 成功物理摘除节点的线程负责把它交给EpochReclaimer退休。
+// 线程数：前EPOCH_RECLAMATION_MAX_THREADS（默认256）个线程各占EpochReclaimer的一个记录槽；更多的线程不会阻塞，
+// 改用共享的溢出计数器登记临界区（多一次原子加减、彼此争用同一条缓存行），线程多时可调大这个宏。
+template <typename Key,
+          typename Value,
+          typename Hash = MyHash<Key>,
+          typename KeyEqual = KeyEqual<Key>,
+          typename BucketPolicy = PrimeBucketPolicy>
+class MyLockFreeHashMap {
+private:
+    using Node = LockFreeHashNode<Key, Value>;
+
+    std::atomic<uintptr_t>* buckets_; // 桶数组（链表头，头指针本身永远不带标记）
+    BucketPolicy bucket_policy_; // 桶索引策略（构造后不再变化）
+    std::atomic<size_t> size_;
+    Hash hash_func;
+    KeyEqual key_eq;
+
+private:
+    static bool is_marked(uintptr_t w) {
+        return (w & 1) != 0;
+    }
+    static uintptr_t marked(uintptr_t w) {
+        return w | 1;
+    }
+    static Node* to_node(uintptr_t w) {
+        return reinterpret_cast<Node*>(w & ~uintptr_t(1));
+    }
+    static uintptr_t to_word(Node* n) {
+        return reinterpret_cast<uintptr_t>(n);
+    }
+
+    static void delete_node(void* p) {
+        delete static_cast<Node*>(p);
+    }
+    static void delete_value(void* p) {
+        delete static_cast<Value*>(p);
+    }
+
+    // 写者使用的查找：定位(prev, curr)，使得prev指向curr且curr是第一个hash更大或键相等的节点
+    // 途中遇到被标记删除的节点时顺手把它摘掉（帮助其他写者完成物理删除）
+    // 返回true表示curr就是要找的键
+    bool search(size_t hash_val, const Key& key, std::atomic<uintptr_t>*& prev_out, uintptr_t& curr_out) {
+    retry:
+        std::atomic<uintptr_t>* prev = &buckets_[bucket_policy_.index(hash_val)];
+        uintptr_t curr_w = prev->load(std::memory_order_acquire);
+        while (true) {
+            Node* curr = to_node(curr_w);
+            if (curr == nullptr) {
+                prev_out = prev;
+                curr_out = curr_w;
+                return false;
+            }
+            uintptr_t next_w = curr->next.load(std::memory_order_acquire);
+            if (is_marked(next_w)) {
+                // curr已被逻辑删除：尝试物理摘除，前驱已变化则从头再来
+                uintptr_t expected = curr_w;
+                if (!prev->compare_exchange_strong(expected, next_w & ~uintptr_t(1),
+                                                   std::memory_order_acq_rel, std::memory_order_acquire)) {
+                    goto retry;
+                }
+                EpochReclaimer::instance().retire(curr, &delete_node);
+                curr_w = next_w & ~uintptr_t(1);
+                continue;
+            }
+            if (curr->hash > hash_val || (curr->hash == hash_val && key_eq(curr->key, key))) {
+                prev_out = prev;
+                curr_out = curr_w;
+                return curr->hash == hash_val;
+            }
+            prev = &curr->next;
+            curr_w = next_w;
+        }
+    }
+
+public:
+    // expected_elements：预计元素个数，桶数由策略取不小于它的值
+    explicit MyLockFreeHashMap(size_t expected_elements = 1024) : size_(0) {
+        size_t n = bucket_policy_.reset(expected_elements);
+        buckets_ = new std::atomic<uintptr_t>[n];
+        for (size_t i = 0; i < n; ++i) {
+            buckets_[i].store(0, std::memory_order_relaxed);
+        }
+    }
+
+    // 析构时要求已没有其他线程访问（已退休但未释放的节点由EpochReclaimer负责）
+    ~MyLockFreeHashMap() {
+        for (size_t i = 0; i < bucket_policy_.bucket_count(); ++i) {
+            Node* curr = to_node(buckets_[i].load(std::memory_order_relaxed));
+            while (curr) {
+                Node* next = to_node(curr->next.load(std::memory_order_relaxed));
+                delete curr;
+                curr = next;
+            }
+        }
+        delete[] buckets_;
+    }
+
+    MyLockFreeHashMap(const MyLockFreeHashMap&) = delete;
+    MyLockFreeHashMap& operator=(const MyLockFreeHashMap&) = delete;
+
+    // 无锁查找：找到时把值复制到out并返回true
+    bool find(const Key& key, Value& out) const {
+        EpochGuard guard;
+        return find(key, out, guard);
+    }
+
+    // 在调用方已持有的纪元临界区内查找：批量读取时整批只进入一次临界区，
+    // 省去每次查找的内存屏障（屏障会阻止相邻查找的缓存未命中相互重叠）
+    bool find(const Key& key, Value& out, const EpochGuard&) const {
+        size_t hash_val = hash_func(key);
+        uintptr_t curr_w = buckets_[bucket_policy_.index(hash_val)].load(std::memory_order_acquire);
+        while (Node* curr = to_node(curr_w)) {
+            uintptr_t next_w = curr->next.load(std::memory_order_acquire);
+            if (curr->hash > hash_val) {
+                return false;
+            }
+            if (!is_marked(next_w) && curr->hash == hash_val && key_eq(curr->key, key)) {
+                out = *curr->value.load(std::memory_order_acquire);
+                return true;
+            }
+            curr_w = next_w;
+        }
+        return false;
+    }
+
+    bool contains(const Key& key) const {
+        Value ignored;
+        return find(key, ignored);
+    }
+
+    // 插入或覆盖，返回true表示新插入
+    bool insert_or_assign(const Key& key, const Value& value) {
+        EpochGuard guard;
+        size_t hash_val = hash_func(key);
+        Node* new_node = nullptr;
+        while (true) {
+            std::atomic<uintptr_t>* prev;
+            uintptr_t curr_w;
+            if (search(hash_val, key, prev, curr_w)) {
+                // 键已存在：整体替换值指针，旧值退休（就地存放的初始值随节点释放，无需退休）
+                Node* curr = to_node(curr_w);
+                Value* old_val = curr->value.exchange(new Value(value), std::memory_order_acq_rel);
+                if (old_val != &curr->inline_value) {
+                    EpochReclaimer::instance().retire(old_val, &delete_value);
+                }
+                delete new_node;
+                return false;
+            }
+            if (new_node == nullptr) {
+                new_node = new Node(hash_val, key, value);
+            }
+            new_node->next.store(curr_w, std::memory_order_relaxed);
+            if (prev->compare_exchange_strong(curr_w, to_word(new_node),
+                                              std::memory_order_release, std::memory_order_relaxed)) {
+                size_.fetch_add(1, std::memory_order_relaxed);
+                return true;
+            }
+            // 前驱被其他写者修改，重新定位
+        }
+    }
+
+    // 删除键，成功返回true
+    bool erase(const Key& key) {
+        EpochGuard guard;
+        size_t hash_val = hash_func(key);
+        while (true) {
+            std::atomic<uintptr_t>* prev;
+            uintptr_t curr_w;
+            if (!search(hash_val, key, prev, curr_w)) {
+                return false;
+            }
+            Node* curr = to_node(curr_w);
+            uintptr_t next_w = curr->next.load(std::memory_order_acquire);
+            if (is_marked(next_w)) {
+                continue; // 其他线程正在删除它，重新查找
+            }
+            // 逻辑删除：给next打标记，此后任何以curr为前驱的CAS都会失败
+            if (!curr->next.compare_exchange_strong(next_w, marked(next_w),
+                                                    std::memory_order_acq_rel, std::memory_order_acquire)) {
+                continue;
+            }
+            size_.fetch_sub(1, std::memory_order_relaxed);
+            // 物理删除：失败则交给search顺手摘除
+            if (prev->compare_exchange_strong(curr_w, next_w, std::memory_order_acq_rel, std::memory_order_relaxed)) {
+                EpochReclaimer::instance().retire(curr, &delete_node);
+            } else {
+                search(hash_val, key, prev, curr_w);
+            }
+            return true;
+        }
+    }
+
+    size_t size() const {
+        return size_.load(std::memory_order_relaxed);
+    }
+
+    size_t bucket_count() const {
+        return bucket_policy_.bucket_count();
+    }
+};
@@ -0,0 +1,373 @@
+// 只读的最小完美哈希表：由填充好的MyUnorderedMap离线构建成文件，运行时mmap后直接查找
+// 构建算法为CHD（hash-and-displace）：键先按哈希分到约n/3个小桶，桶从大到小依次寻找一个位移值d，
+// 使桶内所有键的槽位 (f1 + d * f2) mod n 互不冲突且都是空槽。n个键恰好占满n个槽（最小完美哈希），
+// 查找时只需：算一次哈希 -> 读桶的d -> 算出唯一槽位 -> 比较该槽的键，一次探测即可确定是否存在。
+// 仅支持POSIX（open/mmap）。
+#include <cstddef> // size_t
+#include <cstdint> // uint32_t、uint64_t
+#include <cstdio> // FILE、fopen、fwrite
+#include <cstring> // memcmp、memcpy
+#include <string_view> // std::string_view
+#include <type_traits> // std::is_trivially_copyable、std::has_unique_object_representations
+#include <vector> // 构建期的临时数组
+#include <fcntl.h> // open
+#include <sys/mman.h> // mmap、munmap
+#include <sys/stat.h> // fstat
+#include <unistd.h> // close
+#include "../container/std_unordered_map_withoutstl.cpp" // MyUnorderedMap、hash_bytes
+
+// ------- 文件格式（所有偏移都相对文件开头，各段按8字节对齐） ------- //
+// [PerfectHashHeader][uint32_t displacement[bucket_count]][Slot slots[count]][字符串字节池（仅char*键）]
+// 槽位里键和值相邻存放，一次查找只触碰一个槽（通常一条缓存行）
+struct PerfectHashHeader {
+    char magic[8]; // "MPHMAP1"
+    uint32_t version;
+    uint32_t string_keys; // 1表示char*键（槽中存字节池偏移/长度）
+    uint64_t key_size; // sizeof(Key)，char*键为0
+    uint64_t value_size; // sizeof(Value)
+    uint64_t slot_size; // sizeof(Slot)
+    uint64_t count; // 键个数 = 槽个数
+    uint64_t bucket_count; // CHD的桶个数
+    uint64_t seed; // 构建成功时使用的哈希种子
+    uint64_t displacement_offset;
+    uint64_t slot_offset;
+    uint64_t string_offset;
+    uint64_t file_size;
+};
+
+constexpr char kPerfectHashMagic[8] = {'M', 'P', 'H', 'M', 'A', 'P', '1', '\0'};
+constexpr uint32_t kPerfectHashVersion = 1;
+
+// 槽位：定长键直接存键；char*键存字节池中的偏移和长度
+template <typename Key, typename Value>
+struct PerfectHashSlot {
+    Key key;
+    Value value;
+};
+
+template <typename Value>
+struct PerfectHashSlot<char*, Value> {
+    uint64_t offset;
+    uint64_t length;
+    Value value;
+};
+
+namespace perfect_hash_detail {
+
+constexpr uint64_t kSlotSalt = 0x9E3779B97F4A7C15ULL;
+
+// 把64位值均匀映射到[0, n)：取 x * n 的高64位，比取模少一次除法
+inline uint64_t reduce(uint64_t x, uint64_t n) {
+    uint64_t lo = x, hi = n;
+    hash_detail::mul128(lo, hi);
+    return hi;
+}
+
+// 一个键的三个派生值：桶号，以及求槽位用的f1、f2（f2为奇数）
+struct KeyHash {
+    uint64_t bucket;
+    uint64_t f1;
+    uint64_t f2;
+};
+
+inline KeyHash derive(const void* data, size_t len, uint64_t seed, uint64_t bucket_count) {
+    uint64_t h = hash_bytes(data, len, seed);
+    uint64_t g = hash_finalize_mix(h ^ kSlotSalt);
+    return {reduce(h, bucket_count), g, (g >> 32 | g << 32) | 1};
+}
+
+inline uint64_t slot_of(const KeyHash& kh, uint32_t d, uint64_t n) {
+    return reduce(kh.f1 + d * kh.f2, n);
+}
+
+inline uint64_t align8(uint64_t x) {
+    return (x + 7) & ~uint64_t(7);
+}
+
+} // namespace perfect_hash_detail
+
+// ------- 构建器 ------- //
+// 把map中的全部键值对写成最小完美哈希文件，成功返回true
+// 键：char*，或者字节表示唯一的可平凡复制类型（整数、枚举、无填充的结构体）；值：可平凡复制类型
+template <typename Key, typename Value, typename Hash, typename KeyEqual, typename BucketPolicy,
+          template <typename> class NodeAllocator, bool CacheHash>
+bool build_perfect_hash_file(const MyUnorderedMap<Key, Value, Hash, KeyEqual, BucketPolicy, NodeAllocator, CacheHash>& map,
+                             const char* path) {
+    using namespace perfect_hash_detail;
+    using Slot = PerfectHashSlot<Key, Value>;
+    constexpr bool kStringKey = std::is_same<Key, char*>::value;
+    static_assert(kStringKey || (std::is_trivially_copyable<Key>::value &&
+                                 std::has_unique_object_representations<Key>::value),
+                  "key must be char* or a trivially copyable type without padding");
+    static_assert(std::is_trivially_copyable<Value>::value, "value must be trivially copyable");
+    static_assert(alignof(Slot) <= 8, "slot alignment above 8 bytes is not supported");
+
+    // 1. 收集键值对（char*键把字节复制进字节池）
+    std::vector<Slot> entries;
+    std::vector<char> pool;
+    entries.reserve(map.size());
+    map.for_each([&](const Key& key, const Value& value) {
+        Slot slot;
+        memset(&slot, 0, sizeof(slot)); // 填充字节也写入文件，清零保证同样的输入得到同样的文件
+        if constexpr (kStringKey) {
+            size_t len = StringArena::length(key); // MyUnorderedMap的char*键都存放在StringArena中
+            slot.offset = pool.size();
+            slot.length = len;
+            pool.insert(pool.end(), key, key + len);
+        } else {
+            slot.key = key;
+        }
+        slot.value = value;
+        entries.push_back(slot);
+    });
+    uint64_t n = entries.size();
+    // 平均每桶3个键：位移表约占每键10.7位；每桶5个键时表更小，但位移搜索的尝试次数会多出约9倍
+    uint64_t bucket_count = n / 3 + 1;
+    auto key_bytes = [&](const Slot& slot, size_t& len) -> const void* {
+        if constexpr (kStringKey) {
+            len = slot.length;
+            return pool.data() + slot.offset;
+        } else {
+            len = sizeof(Key);
+            return &slot.key;
+        }
+    };
+
+    // 2. CHD：失败（同一桶内两个键派生值完全相同，或位移搜索超限）时换种子重来
+    const uint32_t kMaxDisplacement = 1u << 26;
+    std::vector<uint32_t> displacement(bucket_count);
+    std::vector<uint64_t> slot_entry(n); // 槽位 -> entries下标
+    uint64_t seed = 0;
+    bool built = n == 0;
+    for (uint64_t attempt = 0; attempt < 16 && !built; ++attempt) {
+        seed = kSlotSalt * (attempt + 1);
+        std::vector<KeyHash> hashes(n);
+        std::vector<uint64_t> bucket_start(bucket_count + 1, 0);
+        for (uint64_t i = 0; i < n; ++i) {
+            size_t len;
+            const void* data = key_bytes(entries[i], len);
+            hashes[i] = derive(data, len, seed, bucket_count);
+            ++bucket_start[hashes[i].bucket + 1];
+        }
+        // 按桶做计数排序，得到每个桶的键列表
+        for (uint64_t b = 0; b < bucket_count; ++b) {
+            bucket_start[b + 1] += bucket_start[b];
+        }
+        std::vector<uint64_t> members(n);
+        std::vector<uint64_t> fill(bucket_start.begin(), bucket_start.end() - 1);
+        for (uint64_t i = 0; i < n; ++i) {
+            members[fill[hashes[i].bucket]++] = i;
+        }
+        // 桶按大小降序处理：大桶在槽位还空的时候最容易放下
+        uint64_t max_size = 0;
+        for (uint64_t b = 0; b < bucket_count; ++b) {
+            uint64_t size = bucket_start[b + 1] - bucket_start[b];
+            max_size = size > max_size ? size : max_size;
+        }
+        std::vector<uint64_t> order;
+        order.reserve(bucket_count);
+        for (uint64_t size = max_size; size > 0; --size) {
+            for (uint64_t b = 0; b < bucket_count; ++b) {
+                if (bucket_start[b + 1] - bucket_start[b] == size) {
+                    order.push_back(b);
+                }
+            }
+        }
+
+        std::vector<bool> occupied(n, false);
+        std::vector<uint64_t> trial(max_size);
+        built = true;
+        for (uint64_t b : order) {
+            const uint64_t* keys = &members[bucket_start[b]];
+            uint64_t size = bucket_start[b + 1] - bucket_start[b];
+            bool placed = false;
+            for (uint32_t d = 0; d < kMaxDisplacement && !placed; ++d) {
+                uint64_t k = 0;
+                for (; k < size; ++k) {
+                    uint64_t slot = slot_of(hashes[keys[k]], d, n);
+                    if (occupied[slot]) {
+                        break;
+                    }
+                    occupied[slot] = true; // 暂时占用，用来发现同桶键之间的冲突
+                    trial[k] = slot;
+                }
+                if (k == size) {
+                    placed = true;
+                    displacement[b] = d;
+                    for (uint64_t j = 0; j < size; ++j) {
+                        slot_entry[trial[j]] = keys[j];
+                    }
+                } else {
+                    for (uint64_t j = 0; j < k; ++j) {
+                        occupied[trial[j]] = false;
+                    }
+                }
+            }
+            if (!placed) {
+                built = false;
+                break;
+            }
+        }
+    }
+    if (!built) {
+        return false;
+    }
+
+    // 3. 写文件
+    PerfectHashHeader header;
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, kPerfectHashMagic, sizeof(header.magic));
+    header.version = kPerfectHashVersion;
+    header.string_keys = kStringKey ? 1 : 0;
+    header.key_size = kStringKey ? 0 : sizeof(Key);
+    header.value_size = sizeof(Value);
+    header.slot_size = sizeof(Slot);
+    header.count = n;
+    header.bucket_count = bucket_count;
+    header.seed = seed;
+    header.displacement_offset = align8(sizeof(PerfectHashHeader));
+    header.slot_offset = align8(header.displacement_offset + bucket_count * sizeof(uint32_t));
+    header.string_offset = align8(header.slot_offset + n * sizeof(Slot));
+    header.file_size = header.string_offset + pool.size();
+
+    FILE* file = fopen(path, "wb");
+    if (file == nullptr) {
+        return false;
+    }
+    static const char kZeros[8] = {0};
+    auto pad_to = [&](uint64_t offset) {
+        long pos = ftell(file);
+        return fwrite(kZeros, 1, offset - static_cast<uint64_t>(pos), file) == offset - static_cast<uint64_t>(pos);
+    };
+    bool ok = fwrite(&header, sizeof(header), 1, file) == 1;
+    ok = ok && pad_to(header.displacement_offset);
+    ok = ok && fwrite(displacement.data(), sizeof(uint32_t), bucket_count, file) == bucket_count;
+    ok = ok && pad_to(header.slot_offset);
+    for (uint64_t slot = 0; ok && slot < n; ++slot) {
+        ok = fwrite(&entries[slot_entry[slot]], sizeof(Slot), 1, file) == 1;
+    }
+    ok = ok && pad_to(header.string_offset);
+    ok = ok && (pool.empty() || fwrite(pool.data(), 1, pool.size(), file) == pool.size());
+    ok = (fclose(file) == 0) && ok;
+    return ok;
+}
+
+// ------- 读取器：mmap整个文件，校验文件头后直接在映射内存上查找，不做任何解析或复制 ------- //
+template <typename Key, typename Value>
+class MyPerfectHashMap {
+private:
+    using Slot = PerfectHashSlot<Key, Value>;
+    static constexpr bool kStringKey = std::is_same<Key, char*>::value;
+
+    void* mapping_ = nullptr;
+    size_t mapping_size_ = 0;
+    const PerfectHashHeader* header_ = nullptr;
+    const uint32_t* displacement_ = nullptr;
+    const Slot* slots_ = nullptr;
+    const char* strings_ = nullptr;
+
+    const Slot* probe(const void* data, size_t len) const {
+        if (header_ == nullptr || header_->count == 0) {
+            return nullptr;
+        }
+        using namespace perfect_hash_detail;
+        KeyHash kh = derive(data, len, header_->seed, header_->bucket_count);
+        return &slots_[slot_of(kh, displacement_[kh.bucket], header_->count)];
+    }
+
+public:
+    MyPerfectHashMap() = default;
+
+    ~MyPerfectHashMap() {
+        close();
+    }
+
+    MyPerfectHashMap(const MyPerfectHashMap&) = delete;
+    MyPerfectHashMap& operator=(const MyPerfectHashMap&) = delete;
+
+    // 映射文件，成功返回true；文件头与当前Key/Value类型不匹配或文件被截断时返回false
+    bool open(const char* path) {
+        close();
+        int fd = ::open(path, O_RDONLY);
+        if (fd < 0) {
+            return false;
+        }
+        struct stat st;
+        if (fstat(fd, &st) != 0 || static_cast<size_t>(st.st_size) < sizeof(PerfectHashHeader)) {
+            ::close(fd);
+            return false;
+        }
+        void* mapping = mmap(nullptr, st.st_size, PROT_READ, MAP_SHARED, fd, 0);
+        ::close(fd); // 映射建立后即可关闭文件描述符
+        if (mapping == MAP_FAILED) {
+            return false;
+        }
+        mapping_ = mapping;
+        mapping_size_ = st.st_size;
+
+        const char* base = static_cast<const char*>(mapping);
+        const PerfectHashHeader* header = reinterpret_cast<const PerfectHashHeader*>(base);
+        bool valid = memcmp(header->magic, kPerfectHashMagic, sizeof(header->magic)) == 0 &&
+                     header->version == kPerfectHashVersion && header->string_keys == (kStringKey ? 1u : 0u) &&
+                     header->key_size == (kStringKey ? 0 : sizeof(Key)) && header->value_size == sizeof(Value) &&
+                     header->slot_size == sizeof(Slot) && header->file_size == mapping_size_ &&
+                     header->bucket_count > 0 &&
+                     header->displacement_offset + header->bucket_count * sizeof(uint32_t) <= header->slot_offset &&
+                     header->slot_offset + header->count * sizeof(Slot) <= header->string_offset &&
+                     header->string_offset <= header->file_size;
+        if (!valid) {
+            close();
+            return false;
+        }
+        header_ = header;
+        displacement_ = reinterpret_cast<const uint32_t*>(base + header->displacement_offset);
+        slots_ = reinterpret_cast<const Slot*>(base + header->slot_offset);
+        strings_ = base + header->string_offset;
+        return true;
+    }
+
+    void close() {
+        if (mapping_) {
+            munmap(mapping_, mapping_size_);
+        }
+        mapping_ = nullptr;
+        mapping_size_ = 0;
+        header_ = nullptr;
+        displacement_ = nullptr;
+        slots_ = nullptr;
+        strings_ = nullptr;
+    }
+
+    bool is_open() const {
+        return header_ != nullptr;
+    }
+
+    // 查找定长键：返回映射内存中值的指针，不存在返回nullptr
+    template <typename K = Key, typename = typename std::enable_if<!std::is_same<K, char*>::value>::type>
+    const Value* find(const Key& key) const {
+        const Slot* slot = probe(&key, sizeof(Key));
+        return slot && memcmp(&slot->key, &key, sizeof(Key)) == 0 ? &slot->value : nullptr;
+    }
+
+    // 查找字符串键（data不需要以'\0'结尾）
+    template <typename K = Key, typename = typename std::enable_if<std::is_same<K, char*>::value>::type>
+    const Value* find(const char* data, size_t len) const {
+        const Slot* slot = probe(data, len);
+        return slot && slot->length == len && memcmp(strings_ + slot->offset, data, len) == 0 ? &slot->value
+                                                                                               : nullptr;
+    }
+
+    template <typename K = Key, typename = typename std::enable_if<std::is_same<K, char*>::value>::type>
+    const Value* find(std::string_view key) const {
+        return find(key.data(), key.size());
+    }
+
+    size_t size() const {
+        return header_ ? header_->count : 0;
+    }
+
+    // 映射的文件大小（即全部内存占用）
+    size_t file_size() const {
+        return mapping_size_;
+    }
+};
@@ -0,0 +1,513 @@
+// 概率草图：用固定内存回答“有多少个不同的键”“某个键出现了几次”“出现最多的是哪些键”
+// - MyHyperLogLog：基数估计，2^p个6位寄存器（这里每个占1字节），标准误差约1.04 / sqrt(2^p)
+// - MyCountMinSketch：频次估计，depth行 × width列计数器，只会高估，误差不超过 总数 × e / width 的概率为1 - e^(-depth)
+// - MySpaceSaving：top-k，最多保存capacity个计数器，任何出现次数超过 总数 / capacity 的键一定在其中
+// 三者的哈希函数与MyUnorderedMap相同（MyHash<Key>，整数为fmix64，字符串为wyhash），也可传入其他同族的哈希函子。
+// 都支持merge（合并另一个同参数的草图）与serialize/deserialize（字节缓冲区），
+// 每个线程各自维护一份草图，最后序列化传回、合并成一份，结果与单线程处理全部数据相同（Space-Saving为同等误差界）。
+#include <algorithm> // std::sort
+#include <cmath> // std::log、std::ceil
+#include <cstddef> // size_t
+#include <cstdint> // uint8_t、uint32_t、uint64_t
+#include <cstring> // memcpy、memcmp
+#include <type_traits> // std::is_trivially_copyable、std::is_pointer
+#include "../container/std_vector_withoutstl_completeversion.cpp" // MyVector
+#include "../container/std_unordered_map_withoutstl.cpp" // MyUnorderedMap、MyHash
+
+// ------- 序列化格式 ------- //
+// [SketchHeader][负载]，整数按本机字节序写入（合并只在同一类机器之间进行）
+struct SketchHeader {
+    char magic[8]; // "MYSKTCH"
+    uint32_t version;
+    uint32_t kind; // SketchKind
+    uint64_t param0; // HLL：精度p；CMS：width；Space-Saving：capacity
+    uint64_t param1; // CMS：depth；Space-Saving：sizeof(Key)
+    uint64_t total; // 已加入的总次数（HLL不使用）
+    uint64_t payload_size; // 负载字节数
+};
+
+constexpr char kSketchMagic[8] = {'M', 'Y', 'S', 'K', 'T', 'C', 'H', '\0'};
+constexpr uint32_t kSketchVersion = 1;
+
+enum SketchKind : uint32_t {
+    kSketchHyperLogLog = 1,
+    kSketchCountMin = 2,
+    kSketchSpaceSaving = 3,
+};
+
+namespace sketch_detail {
+
+inline void write_header(MyVector<unsigned char>& out, uint32_t kind, uint64_t param0, uint64_t param1,
+                         uint64_t total, uint64_t payload_size) {
+    SketchHeader header;
+    memcpy(header.magic, kSketchMagic, sizeof(header.magic));
+    header.version = kSketchVersion;
+    header.kind = kind;
+    header.param0 = param0;
+    header.param1 = param1;
+    header.total = total;
+    header.payload_size = payload_size;
+    out.resize(sizeof(header) + payload_size);
+    memcpy(out.data(), &header, sizeof(header));
+}
+
+// 校验文件头与长度，成功时返回负载起始地址，否则返回nullptr
+inline const unsigned char* read_header(const unsigned char* data, size_t len, uint32_t kind, SketchHeader& header) {
+    if (len < sizeof(header)) {
+        return nullptr;
+    }
+    memcpy(&header, data, sizeof(header));
+    if (memcmp(header.magic, kSketchMagic, sizeof(header.magic)) != 0 || header.version != kSketchVersion ||
+        header.kind != kind || header.payload_size != len - sizeof(header)) {
+        return nullptr;
+    }
+    return data + sizeof(header);
+}
+
+inline unsigned clz64(uint64_t x) {
+#if defined(__GNUC__) || defined(__clang__)
+    return x ? static_cast<unsigned>(__builtin_clzll(x)) : 64;
+#else
+    unsigned n = 0;
+    for (uint64_t bit = uint64_t(1) << 63; bit && !(x & bit); bit >>= 1) {
+        ++n;
+    }
+    return n;
+#endif
+}
+
+// 饱和加法：计数器到上限后停在上限，不回绕成小数
+inline uint32_t saturating_add(uint32_t a, uint64_t b) {
+    uint64_t sum = a + b;
+    return sum > 0xFFFFFFFFu ? 0xFFFFFFFFu : static_cast<uint32_t>(sum);
+}
+
+} // namespace sketch_detail
+
+// ------- HyperLogLog基数估计 ------- //
+// 哈希值的高p位选寄存器，其余位中第一个1的位置（前导零个数 + 1）与寄存器取最大值。
+// 合并 = 逐个寄存器取最大值，与把两条流串起来加入同一个草图完全等价。
+template <typename Key, typename Hash = MyHash<Key>>
+class MyHyperLogLog {
+public:
+    static constexpr unsigned kMinPrecision = 4;
+    static constexpr unsigned kMaxPrecision = 18;
+
+    explicit MyHyperLogLog(unsigned precision = 14) {
+        precision_ = precision < kMinPrecision ? kMinPrecision : (precision > kMaxPrecision ? kMaxPrecision : precision);
+        registers_.resize(size_t(1) << precision_, 0);
+    }
+
+    void add(const Key& key) {
+        add_hash(hasher_(key));
+    }
+
+    // 直接加入已算好的64位哈希值（须是混合充分的哈希）
+    void add_hash(uint64_t hash) {
+        size_t idx = hash >> (64 - precision_);
+        uint64_t rest = hash << precision_;
+        unsigned max_rank = 64 - precision_ + 1;
+        unsigned rank = sketch_detail::clz64(rest) + 1;
+        uint8_t r = static_cast<uint8_t>(rank > max_rank ? max_rank : rank);
+        if (r > registers_[idx]) {
+            registers_[idx] = r;
+        }
+    }
+
+    // 不同键个数的估计值
+    double estimate() const {
+        double m = static_cast<double>(registers_.size());
+        double sum = 0;
+        size_t zeros = 0;
+        for (size_t i = 0; i < registers_.size(); ++i) {
+            sum += 1.0 / static_cast<double>(uint64_t(1) << registers_[i]);
+            zeros += registers_[i] == 0;
+        }
+        double alpha = m >= 128 ? 0.7213 / (1.0 + 1.079 / m) : (m >= 64 ? 0.709 : (m >= 32 ? 0.697 : 0.673));
+        double raw = alpha * m * m / sum;
+        // 小基数：空寄存器还多时改用线性计数；64位哈希不需要大基数修正
+        if (raw <= 2.5 * m && zeros != 0) {
+            return m * std::log(m / static_cast<double>(zeros));
+        }
+        return raw;
+    }
+
+    // 合并精度相同的草图，精度不同返回false
+    bool merge(const MyHyperLogLog& other) {
+        if (other.precision_ != precision_) {
+            return false;
+        }
+        for (size_t i = 0; i < registers_.size(); ++i) {
+            if (other.registers_[i] > registers_[i]) {
+                registers_[i] = other.registers_[i];
+            }
+        }
+        return true;
+    }
+
+    void clear() {
+        for (size_t i = 0; i < registers_.size(); ++i) {
+            registers_[i] = 0;
+        }
+    }
+
+    unsigned precision() const { return precision_; }
+    size_t memory_bytes() const { return registers_.size(); }
+
+    void serialize(MyVector<unsigned char>& out) const {
+        sketch_detail::write_header(out, kSketchHyperLogLog, precision_, 0, 0, registers_.size());
+        memcpy(out.data() + sizeof(SketchHeader), registers_.data(), registers_.size());
+    }
+
+    // 从serialize的输出恢复（精度以数据为准），格式不符返回false且自身不变
+    bool deserialize(const unsigned char* data, size_t len) {
+        SketchHeader header;
+        const unsigned char* payload = sketch_detail::read_header(data, len, kSketchHyperLogLog, header);
+        if (payload == nullptr || header.param0 < kMinPrecision || header.param0 > kMaxPrecision ||
+            header.payload_size != (uint64_t(1) << header.param0)) {
+            return false;
+        }
+        precision_ = static_cast<unsigned>(header.param0);
+        registers_.resize(header.payload_size);
+        memcpy(registers_.data(), payload, header.payload_size);
+        return true;
+    }
+
+private:
+    unsigned precision_;
+    MyVector<uint8_t> registers_;
+    Hash hasher_;
+};
+
+// ------- Count-Min频次估计 ------- //
+// 每行用一个位置计数，估计值取各行最小。d行的下标由一次64位哈希的两半推出：
+// idx_i = (h1 + i * h2) & (width - 1)（Kirsch-Mitzenmacher双重哈希），每次add/estimate只算一次哈希。
+// 合并 = 计数器逐个相加，结果与单个草图处理两条流完全相同。
+template <typename Key, typename Hash = MyHash<Key>>
+class MyCountMinSketch {
+public:
+    // 误差不超过 epsilon × 总数 所需的列数（向上取2的幂）
+    static size_t width_for(double epsilon) {
+        size_t need = static_cast<size_t>(std::ceil(2.718281828459045 / epsilon));
+        size_t width = 1;
+        while (width < need) {
+            width <<= 1;
+        }
+        return width;
+    }
+
+    // 以 1 - delta 的概率满足误差界所需的行数
+    static size_t depth_for(double delta) {
+        size_t depth = static_cast<size_t>(std::ceil(std::log(1.0 / delta)));
+        return depth < 1 ? 1 : depth;
+    }
+
+    // width向上取2的幂
+    explicit MyCountMinSketch(size_t width = 2048, size_t depth = 4) {
+        width_ = 1;
+        while (width_ < width) {
+            width_ <<= 1;
+        }
+        depth_ = depth < 1 ? 1 : depth;
+        counters_.resize(width_ * depth_, 0);
+    }
+
+    void add(const Key& key, uint64_t count = 1) {
+        uint64_t h = hasher_(key);
+        uint32_t h1 = static_cast<uint32_t>(h);
+        uint32_t h2 = static_cast<uint32_t>(h >> 32) | 1; // 奇数步长，各行下标互不相同
+        for (size_t row = 0; row < depth_; ++row) {
+            uint32_t& c = counters_[row * width_ + ((h1 + row * h2) & (width_ - 1))];
+            c = sketch_detail::saturating_add(c, count);
+        }
+        total_ += count;
+    }
+
+    // 出现次数的估计值（不会低于真实值）
+    uint64_t estimate(const Key& key) const {
+        uint64_t h = hasher_(key);
+        uint32_t h1 = static_cast<uint32_t>(h);
+        uint32_t h2 = static_cast<uint32_t>(h >> 32) | 1;
+        uint32_t best = 0xFFFFFFFFu;
+        for (size_t row = 0; row < depth_; ++row) {
+            uint32_t c = counters_[row * width_ + ((h1 + row * h2) & (width_ - 1))];
+            best = c < best ? c : best;
+        }
+        return best;
+    }
+
+    // 合并宽度与行数都相同的草图，否则返回false
+    bool merge(const MyCountMinSketch& other) {
+        if (other.width_ != width_ || other.depth_ != depth_) {
+            return false;
+        }
+        for (size_t i = 0; i < counters_.size(); ++i) {
+            counters_[i] = sketch_detail::saturating_add(counters_[i], other.counters_[i]);
+        }
+        total_ += other.total_;
+        return true;
+    }
+
+    void clear() {
+        for (size_t i = 0; i < counters_.size(); ++i) {
+            counters_[i] = 0;
+        }
+        total_ = 0;
+    }
+
+    size_t width() const { return width_; }
+    size_t depth() const { return depth_; }
+    uint64_t total() const { return total_; }
+    size_t memory_bytes() const { return counters_.size() * sizeof(uint32_t); }
+
+    void serialize(MyVector<unsigned char>& out) const {
+        size_t bytes = counters_.size() * sizeof(uint32_t);
+        sketch_detail::write_header(out, kSketchCountMin, width_, depth_, total_, bytes);
+        memcpy(out.data() + sizeof(SketchHeader), counters_.data(), bytes);
+    }
+
+    bool deserialize(const unsigned char* data, size_t len) {
+        SketchHeader header;
+        const unsigned char* payload = sketch_detail::read_header(data, len, kSketchCountMin, header);
+        if (payload == nullptr || header.param0 == 0 || (header.param0 & (header.param0 - 1)) != 0 ||
+            header.param1 == 0 || header.payload_size != header.param0 * header.param1 * sizeof(uint32_t)) {
+            return false;
+        }
+        width_ = header.param0;
+        depth_ = header.param1;
+        total_ = header.total;
+        counters_.resize(width_ * depth_);
+        memcpy(counters_.data(), payload, header.payload_size);
+        return true;
+    }
+
+private:
+    size_t width_;
+    size_t depth_;
+    uint64_t total_ = 0;
+    MyVector<uint32_t> counters_; // 第row行第col列在row * width_ + col
+    Hash hasher_;
+};
+
+// ------- Space-Saving top-k ------- //
+// 最多capacity个计数器。计数器一旦分配就固定在counters_的某个槽里，MyUnorderedMap记录键所在的槽；
+// 另有一个按计数排列的槽号最小堆（heap_）及其反查数组（heap_pos_），堆调整只搬动槽号，不再查位置表。
+// - 已有键：查一次位置表，计数加上本次次数后在堆中下沉
+// - 新键且未满：占用新槽
+// - 新键且已满：复用堆顶（计数最小）的槽，新键继承它的计数作为误差，计数 = 旧计数 + 本次次数
+// 每个键的真实次数在[count - error, count]之间。
+// 合并（Agarwal等人的可合并摘要）：一方没有的键按该方最小计数（未满时为0）补上计数与误差，再保留计数最大的capacity个，
+// 误差界仍为 (总数A + 总数B) / capacity。
+// 序列化要求键可平凡拷贝；指针键只会保存指针本身，因此不支持。
+template <typename Key>
+struct SpaceSavingCounter {
+    Key key;
+    uint64_t count; // 估计次数（上界）
+    uint64_t error; // 可能多算的次数
+};
+
+template <typename Key, typename Hash = MyHash<Key>>
+class MySpaceSaving {
+    static_assert(!std::is_pointer<Key>::value, "MySpaceSaving只保存键本身，指针键请先转换为定长ID");
+
+public:
+    using Counter = SpaceSavingCounter<Key>;
+
+    explicit MySpaceSaving(size_t capacity = 1024) : capacity_(capacity < 1 ? 1 : capacity) {
+        counters_.reserve(capacity_);
+        heap_.reserve(capacity_);
+        heap_pos_.reserve(capacity_);
+    }
+
+    void add(const Key& key, uint64_t count = 1) {
+        total_ += count;
+        if (uint32_t* slot = position_.find(key)) {
+            counters_[*slot].count += count;
+            sift_down(heap_pos_[*slot]);
+            return;
+        }
+        if (counters_.size() < capacity_) {
+            push_counter(Counter{key, count, 0});
+            return;
+        }
+        uint32_t slot = heap_[0];
+        Counter& victim = counters_[slot];
+        position_.erase(victim.key);
+        victim.key = key;
+        victim.error = victim.count;
+        victim.count += count;
+        position_.insert(key, slot);
+        sift_down(0);
+    }
+
+    // 键的计数器（不在表中返回nullptr；此时真实次数不超过min_count()）
+    const Counter* find(const Key& key) const {
+        const uint32_t* slot = position_.find(key);
+        return slot ? &counters_[*slot] : nullptr;
+    }
+
+    // 表满时的最小计数（不在表中的键出现次数的上界），未满时为0
+    uint64_t min_count() const {
+        return counters_.size() < capacity_ ? 0 : counters_[heap_[0]].count;
+    }
+
+    // 计数最大的前k个（k大于现有计数器数时全部返回），按计数降序
+    MyVector<Counter> top(size_t k) const {
+        MyVector<Counter> out(counters_.begin(), counters_.end());
+        std::sort(out.begin(), out.end(), [](const Counter& a, const Counter& b) { return a.count > b.count; });
+        while (out.size() > k) {
+            out.pop_back();
+        }
+        return out;
+    }
+
+    // 合并容量相同的摘要，否则返回false
+    bool merge(const MySpaceSaving& other) {
+        if (other.capacity_ != capacity_) {
+            return false;
+        }
+        uint64_t my_min = min_count();
+        uint64_t other_min = other.min_count();
+        MyVector<Counter> merged;
+        merged.reserve(counters_.size() + other.counters_.size());
+        for (size_t i = 0; i < counters_.size(); ++i) {
+            Counter c = counters_[i];
+            if (const Counter* o = other.find(c.key)) {
+                c.count += o->count;
+                c.error += o->error;
+            } else {
+                c.count += other_min;
+                c.error += other_min;
+            }
+            merged.push_back(c);
+        }
+        for (size_t i = 0; i < other.counters_.size(); ++i) {
+            const Counter& o = other.counters_[i];
+            if (!find(o.key)) {
+                merged.push_back(Counter{o.key, o.count + my_min, o.error + my_min});
+            }
+        }
+        std::sort(merged.begin(), merged.end(), [](const Counter& a, const Counter& b) { return a.count > b.count; });
+        while (merged.size() > capacity_) {
+            merged.pop_back();
+        }
+        uint64_t merged_total = total_ + other.total_;
+        rebuild(merged); // rebuild会清零total_
+        total_ = merged_total;
+        return true;
+    }
+
+    void clear() {
+        counters_.clear();
+        heap_.clear();
+        heap_pos_.clear();
+        position_.clear();
+        total_ = 0;
+    }
+
+    size_t size() const { return counters_.size(); }
+    size_t capacity() const { return capacity_; }
+    uint64_t total() const { return total_; }
+
+    // 计数器槽 + 堆 + 位置表（节点与桶数组，估算）
+    size_t memory_bytes() const {
+        return counters_.capacity() * sizeof(Counter) + (heap_.capacity() + heap_pos_.capacity()) * sizeof(uint32_t) +
+               position_.size() * sizeof(HashNode<Key, uint32_t>) + position_.bucket_count() * sizeof(void*);
+    }
+
+    void serialize(MyVector<unsigned char>& out) const {
+        static_assert(std::is_trivially_copyable<Key>::value, "序列化要求键可平凡拷贝");
+        size_t bytes = counters_.size() * sizeof(Counter);
+        sketch_detail::write_header(out, kSketchSpaceSaving, capacity_, sizeof(Key), total_, bytes);
+        if (bytes) {
+            memcpy(out.data() + sizeof(SketchHeader), counters_.data(), bytes);
+        }
+    }
+
+    bool deserialize(const unsigned char* data, size_t len) {
+        static_assert(std::is_trivially_copyable<Key>::value, "序列化要求键可平凡拷贝");
+        SketchHeader header;
+        const unsigned char* payload = sketch_detail::read_header(data, len, kSketchSpaceSaving, header);
+        if (payload == nullptr || header.param0 == 0 || header.param1 != sizeof(Key) ||
+            header.payload_size % sizeof(Counter) != 0 || header.payload_size / sizeof(Counter) > header.param0) {
+            return false;
+        }
+        capacity_ = header.param0;
+        MyVector<Counter> counters;
+        counters.resize(header.payload_size / sizeof(Counter));
+        if (header.payload_size) {
+            memcpy(counters.data(), payload, header.payload_size);
+        }
+        rebuild(counters);
+        total_ = header.total;
+        return true;
+    }
+
+private:
+    size_t capacity_;
+    MyVector<Counter> counters_; // 计数器槽，分配后位置不变
+    MyVector<uint32_t> heap_; // 槽号，按槽中count的最小堆
+    MyVector<uint32_t> heap_pos_; // heap_pos_[槽号] = 该槽在heap_中的下标
+    mutable MyUnorderedMap<Key, uint32_t, Hash> position_; // 键 -> 槽号（MyUnorderedMap::find不是const）
+    uint64_t total_ = 0;
+
+    uint64_t count_at(size_t i) const {
+        return counters_[heap_[i]].count;
+    }
+
+    void swap_nodes(size_t a, size_t b) {
+        uint32_t tmp = heap_[a];
+        heap_[a] = heap_[b];
+        heap_[b] = tmp;
+        heap_pos_[heap_[a]] = static_cast<uint32_t>(a);
+        heap_pos_[heap_[b]] = static_cast<uint32_t>(b);
+    }
+
+    void sift_up(size_t i) {
+        while (i > 0) {
+            size_t parent = (i - 1) / 2;
+            if (count_at(parent) <= count_at(i)) {
+                break;
+            }
+            swap_nodes(i, parent);
+            i = parent;
+        }
+    }
+
+    void sift_down(size_t i) {
+        size_t n = heap_.size();
+        for (;;) {
+            size_t smallest = i;
+            size_t left = 2 * i + 1;
+            size_t right = left + 1;
+            if (left < n && count_at(left) < count_at(smallest)) {
+                smallest = left;
+            }
+            if (right < n && count_at(right) < count_at(smallest)) {
+                smallest = right;
+            }
+            if (smallest == i) {
+                return;
+            }
+            swap_nodes(i, smallest);
+            i = smallest;
+        }
+    }
+
+    void push_counter(const Counter& c) {
+        uint32_t slot = static_cast<uint32_t>(counters_.size());
+        counters_.push_back(c);
+        heap_.push_back(slot);
+        heap_pos_.push_back(slot);
+        position_.insert(c.key, slot);
+        sift_up(slot);
+    }
+
+    // 用给定计数器重建槽、堆和位置表
+    void rebuild(const MyVector<Counter>& counters) {
+        clear();
+        for (size_t i = 0; i < counters.size(); ++i) {
+            push_counter(counters[i]);
+        }
+    }
+};